@@ -49,6 +49,18 @@ class abstract_channel : public ref_counted {
                          message content,
                          execution_unit* host) = 0;
 
+    /**
+     * @brief Enqueues a new message to the channel and returns whether
+     *        the sender may go on, i.e., returns @p false if the receiver
+     *        has a full bounded mailbox using
+     *        {@link mailbox_overflow::backpressure}.
+     * @note The default implementation calls {@link enqueue}
+     *       and returns @p true.
+     */
+    virtual bool try_enqueue(msg_hdr_cref header,
+                             message content,
+                             execution_unit* host);
+
  protected:
 
     virtual ~abstract_channel();
@@ -26,6 +26,8 @@
 #include "boost/actor/node_id.hpp"
 #include "boost/actor/actor_proxy.hpp"
 
+#include "boost/actor/detail/shared_spinlock.hpp"
+
 namespace boost {
 namespace actor {
 
@@ -37,6 +39,8 @@ namespace io { class middleman; }
 /**
  * @brief Groups a (distributed) set of actors and allows actors
  *        in the same namespace to exchange messages.
+ * @note All member functions except for @p set_proxy_factory and
+ *       @p set_new_element_callback are thread-safe.
  */
 class actor_namespace {
 
@@ -57,7 +61,7 @@ class actor_namespace {
     actor_addr read(deserializer* source);
 
     /**
-     * @brief A map that stores weak actor proxy pointers by actor ids.
+     * @brief A map that stores actor proxy pointers by actor ids.
      */
     typedef std::map<actor_id, actor_proxy_ptr> proxy_map;
 
@@ -86,9 +90,9 @@ class actor_namespace {
              const actor_proxy_ptr& proxy);
 
     /**
-     * @brief Returns the map of known actors for @p node.
+     * @brief Returns a copy of the map of known actors for @p node.
      */
-    proxy_map& proxies(node_id& node);
+    proxy_map proxies(const node_id& node);
 
     /**
      * @brief Deletes given proxy instance from this namespace.
@@ -113,6 +117,10 @@ class actor_namespace {
 
     node_id_ptr m_node;
 
+    // guards m_proxies, because each event loop of the
+    // middleman accesses the namespace concurrently
+    detail::shared_spinlock m_proxies_mtx;
+
     std::map<node_id, proxy_map> m_proxies;
 
 };
@@ -59,6 +59,7 @@
 #include "boost/actor/local_actor.hpp"
 #include "boost/actor/ref_counted.hpp"
 #include "boost/actor/typed_actor.hpp"
+#include "boost/actor/wire_format.hpp"
 #include "boost/actor/deserializer.hpp"
 #include "boost/actor/max_msg_size.hpp"
 #include "boost/actor/remote_actor.hpp"
@@ -76,6 +77,7 @@
 #include "boost/actor/actor_namespace.hpp"
 #include "boost/actor/behavior_policy.hpp"
 #include "boost/actor/continue_helper.hpp"
+#include "boost/actor/mailbox_config.hpp"
 #include "boost/actor/mailbox_element.hpp"
 #include "boost/actor/message_builder.hpp"
 #include "boost/actor/message_handler.hpp"
@@ -129,13 +131,20 @@
 #include "boost/actor/io/acceptor.hpp"
 #include "boost/actor/io/platform.hpp"
 #include "boost/actor/io/middleman.hpp"
+#include "boost/actor/io/udp_socket.hpp"
+#include "boost/actor/io/compression.hpp"
 #include "boost/actor/io/continuable.hpp"
+#include "boost/actor/io/ip_endpoint.hpp"
 #include "boost/actor/io/input_stream.hpp"
 #include "boost/actor/io/tcp_acceptor.hpp"
 #include "boost/actor/io/tcp_io_stream.hpp"
 #include "boost/actor/io/accept_handle.hpp"
+#include "boost/actor/io/output_queue.hpp"
 #include "boost/actor/io/output_stream.hpp"
+#include "boost/actor/io/shm_io_stream.hpp"
 #include "boost/actor/io/peer_acceptor.hpp"
+#include "boost/actor/io/receive_buffer.hpp"
+#include "boost/actor/io/datagram_handle.hpp"
 #include "boost/actor/io/buffered_writing.hpp"
 #include "boost/actor/io/connection_handle.hpp"
 #include "boost/actor/io/remote_actor_proxy.hpp"
@@ -19,6 +19,7 @@
 #ifndef BOOST_ACTOR_BINARY_DESERIALIZER_HPP
 #define BOOST_ACTOR_BINARY_DESERIALIZER_HPP
 
+#include "boost/actor/wire_format.hpp"
 #include "boost/actor/deserializer.hpp"
 
 namespace boost {
@@ -36,11 +37,15 @@ class binary_deserializer : public deserializer {
 
     binary_deserializer(const void* buf, size_t buf_size,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        wire_format format = wire_format::v1,
+                        node_id_table* node_ids = nullptr);
 
     binary_deserializer(const void* begin, const void* m_end,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        wire_format format = wire_format::v1,
+                        node_id_table* node_ids = nullptr);
 
     const uniform_type_info* begin_object() override;
     void end_object() override;
@@ -49,10 +54,14 @@ class binary_deserializer : public deserializer {
     void read_value(primitive_variant& storage) override;
     void read_raw(size_t num_bytes, void* storage) override;
 
+    node_id_ptr read_node_id() override;
+
  private:
 
     const void* m_pos;
     const void* m_end;
+    wire_format m_format;
+    node_id_table* m_node_ids;
 
 };
 
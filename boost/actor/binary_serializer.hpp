@@ -22,6 +22,7 @@
 #include <utility>
 
 #include "boost/actor/serializer.hpp"
+#include "boost/actor/wire_format.hpp"
 
 namespace boost {
 namespace actor {
@@ -41,11 +42,17 @@ class binary_serializer : public serializer {
 
     /**
      * @brief Creates a binary serializer writing to @p write_buffer.
+     * @param format The encoding for all written values.
+     * @param node_ids Replaces repeated node IDs with an index when using
+     *                 {@link wire_format::v2}; the peer must read the data
+     *                 using a table with the same content.
      * @warning @p write_buffer must be guaranteed to outlive @p this
      */
     binary_serializer(io::buffer* write_buffer,
                       actor_namespace* ns = nullptr,
-                      type_lookup_table* lookup_table = nullptr);
+                      type_lookup_table* lookup_table = nullptr,
+                      wire_format format = wire_format::v1,
+                      node_id_table* node_ids = nullptr);
 
     void begin_object(const uniform_type_info*) override;
 
@@ -61,9 +68,13 @@ class binary_serializer : public serializer {
 
     void write_raw(size_t num_bytes, const void* data) override;
 
+    void write_node_id(const node_id* nid) override;
+
  private:
 
     io::buffer* m_sink;
+    wire_format m_format;
+    node_id_table* m_node_ids;
 
 };
 
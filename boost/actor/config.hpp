@@ -58,6 +58,14 @@
 #  define BOOST_ACTOR_ANNOTATE_FALLTHROUGH static_cast<void>(0)
 #endif
 
+// sets BOOST_ACTOR_PREFETCH, which hints the CPU to load
+// the cache line of the given address for a subsequent read
+#if defined(BOOST_CLANG) || defined(__GNUC__)
+#  define BOOST_ACTOR_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#  define BOOST_ACTOR_PREFETCH(addr) static_cast<void>(0)
+#endif
+
 // detect OS
 #if defined(__APPLE__)
 #  define BOOST_ACTOR_MACOS
@@ -22,6 +22,7 @@
 #include <string>
 #include <cstddef>
 
+#include "boost/actor/node_id.hpp"
 #include "boost/actor/primitive_variant.hpp"
 
 namespace boost {
@@ -92,6 +93,12 @@ class deserializer {
      */
     virtual void read_raw(size_t num_bytes, void* storage) = 0;
 
+    /**
+     * @brief Reads a node ID written by {@link serializer::write_node_id()}.
+     * @returns The node ID or @p nullptr if an invalid node ID was read.
+     */
+    virtual node_id_ptr read_node_id();
+
     inline actor_namespace* get_namespace() {
         return m_namespace;
     }
@@ -19,18 +19,19 @@
 #ifndef BOOST_ACTOR_ACTOR_REGISTRY_HPP
 #define BOOST_ACTOR_ACTOR_REGISTRY_HPP
 
-#include <map>
 #include <mutex>
 #include <thread>
 #include <atomic>
 #include <cstdint>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "boost/actor/attachable.hpp"
 #include "boost/actor/abstract_actor.hpp"
-#include "boost/actor/detail/shared_spinlock.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
 
 #include "boost/actor/detail/singleton_mixin.hpp"
+#include "boost/actor/detail/producer_consumer_list.hpp" // cache line size
 
 namespace boost {
 namespace actor {
@@ -38,12 +39,34 @@ namespace detail {
 
 class singleton_manager;
 
+/**
+ * @brief Stores all local actors that were published or serialized, i.e.,
+ *        all actors a remote node might refer to by ID.
+ *
+ * Entries are distributed among {@link num_shards} shards by actor ID,
+ * each guarded by its own lock. Once an actor exits, its entry is removed
+ * and only its exit reason is kept as tombstone. Tombstones are reclaimed
+ * in epochs: each shard keeps two generations of tombstones and drops
+ * the older one as a whole once the current generation is full.
+ */
 class actor_registry : public singleton_mixin<actor_registry> {
 
     friend class singleton_mixin<actor_registry>;
 
  public:
 
+    /**
+     * @brief The number of independently locked shards.
+     */
+    static constexpr size_t num_shards = 64;
+
+    /**
+     * @brief The number of tombstones per shard and generation, i.e.,
+     *        the registry remembers the exit reason of at least
+     *        <tt>num_shards * max_tombstones</tt> recently exited actors.
+     */
+    static constexpr size_t max_tombstones = 512;
+
     ~actor_registry();
 
     /**
@@ -54,7 +77,9 @@ class actor_registry : public singleton_mixin<actor_registry> {
     typedef std::pair<abstract_actor_ptr, std::uint32_t> value_type;
 
     /**
-     * @brief Returns the {nullptr, invalid_exit_reason}.
+     * @brief Returns the entry for @p key. Returns
+     *        <tt>{nullptr, exit_reason::not_exited}</tt> if @p key is unknown
+     *        or if the actor exited too long ago to remember its exit reason.
      */
     value_type get_entry(actor_id key) const;
 
@@ -83,7 +108,31 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
  private:
 
-    typedef std::map<actor_id, value_type> entries;
+    typedef std::unordered_map<actor_id, abstract_actor_ptr> live_entries;
+
+    typedef std::unordered_map<actor_id, std::uint32_t> tombstones;
+
+    // avoid false sharing between the locks of neighboring shards
+    struct alignas(BOOST_ACTOR_CACHE_LINE_SIZE) shard {
+        mutable detail::scalable_rw_lock mtx;
+        live_entries live;
+        // exit reasons of recently exited actors, m_exited[current]
+        // is the generation new tombstones are added to
+        tombstones exited[2];
+        size_t current;
+        shard() : current(0) { }
+    };
+
+    inline shard& shard_of(actor_id key) {
+        return m_shards[key % num_shards];
+    }
+
+    inline const shard& shard_of(actor_id key) const {
+        return m_shards[key % num_shards];
+    }
+
+    // returns the exit reason stored in a tombstone or not_exited
+    static std::uint32_t find_tombstone(const shard& s, actor_id key);
 
     std::atomic<size_t> m_running;
     std::atomic<actor_id> m_ids;
@@ -91,8 +140,7 @@ class actor_registry : public singleton_mixin<actor_registry> {
     std::mutex m_running_mtx;
     std::condition_variable m_running_cv;
 
-    mutable detail::shared_spinlock m_instances_mtx;
-    entries m_entries;
+    shard m_shards[num_shards];
 
     actor_registry();
 
@@ -0,0 +1,76 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_DETAIL_ATOM_GUARD_HPP
+#define BOOST_ACTOR_DETAIL_ATOM_GUARD_HPP
+
+#include <cstdint>
+
+#include "boost/none.hpp"
+#include "boost/optional.hpp"
+
+#include "boost/actor/atom.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief Guard generated by <tt>on(atom("..."), ...)</tt>. Unlike a generic
+ *        guard, it exposes its value to allow {@link match_expr} to select
+ *        cases by the leading atom of a message without invoking them.
+ */
+class atom_guard {
+
+ public:
+
+    constexpr atom_guard(atom_value value) : m_value(value) { }
+
+    inline optional<atom_value> operator()(const atom_value& other) const {
+        if (other == m_value) return m_value;
+        return none;
+    }
+
+    inline atom_value value() const {
+        return m_value;
+    }
+
+ private:
+
+    atom_value m_value;
+
+};
+
+/**
+ * @brief Returns the dispatch key of a guard, i.e., the value of
+ *        @p guard as integer or 0 if @p guard is not an atom guard.
+ */
+inline std::uint64_t atom_key(const atom_guard& guard) {
+    return static_cast<std::uint64_t>(guard.value());
+}
+
+template<typename T>
+inline std::uint64_t atom_key(const T&) {
+    return 0;
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_DETAIL_ATOM_GUARD_HPP
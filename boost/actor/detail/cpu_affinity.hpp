@@ -0,0 +1,45 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_DETAIL_CPU_AFFINITY_HPP
+#define BOOST_ACTOR_DETAIL_CPU_AFFINITY_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief Restricts the calling thread to the CPUs in @p cpus.
+ * @returns @p true on success, @p false if @p cpus is empty or if
+ *          the platform does not support CPU affinity.
+ */
+bool set_thread_affinity(const std::vector<size_t>& cpus);
+
+/**
+ * @brief Returns the NUMA node of @p cpu or @p 0 if unknown.
+ */
+size_t numa_node_of(size_t cpu);
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_DETAIL_CPU_AFFINITY_HPP
@@ -0,0 +1,190 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_DETAIL_DISPATCH_TABLE_HPP
+#define BOOST_ACTOR_DETAIL_DISPATCH_TABLE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <typeinfo>
+
+#include "boost/actor/fwd.hpp"
+#include "boost/actor/config.hpp"
+
+#include "boost/actor/detail/message_data.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief Maps message signatures, i.e., the element types of a message,
+ *        to the bitmask of cases in a {@link match_expr} that can
+ *        possibly match such a message.
+ *
+ * The table uses open addressing with linear probing. Statically typed
+ * messages are keyed by their type token, whereas dynamically typed
+ * messages are keyed by the sequence of their uniform type information.
+ *
+ * A match expression is shared by all actors using the same behavior,
+ * hence the table is safe to use from multiple threads. Readers never
+ * lock. Writers serialize on a mutex and fill a free slot in place before
+ * publishing it by setting its @p used flag. Slots are copied to a new
+ * array only when the table grows. Replaced arrays remain valid until the
+ * table is destroyed, because readers might still probe them. Since the
+ * capacity doubles, these arrays take less memory than the current one.
+ */
+class dispatch_table {
+
+    dispatch_table(const dispatch_table&) = delete;
+    dispatch_table& operator=(const dispatch_table&) = delete;
+
+ public:
+
+    typedef std::uint64_t bitmask;
+
+    dispatch_table();
+
+    ~dispatch_table();
+
+    /**
+     * @brief Returns the bitmask stored for the signature
+     *        of @p msg or @c nullptr if no such entry exists.
+     * @note The result remains valid until this table is destroyed.
+     */
+    inline const bitmask* find(const message_data& msg) const {
+        auto tbl = m_table.load(std::memory_order_acquire);
+        return tbl ? find(*tbl, msg) : nullptr;
+    }
+
+    /**
+     * @brief Stores @p mask for the signature of @p msg unless
+     *        another thread did so in the meantime.
+     */
+    void emplace(const message_data& msg, bitmask mask);
+
+    /**
+     * @brief Returns the number of stored signatures.
+     */
+    inline size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the first element of @p msg as integer if it is an
+     *        atom, otherwise 0. Note that no atom has the value 0.
+     */
+    static std::uint64_t leading_atom(const message_data& msg);
+
+    /**
+     * @brief Returns the position of the least significant bit
+     *        set in @p mask, which must not be 0.
+     */
+    static inline size_t lowest_bit(bitmask mask) {
+#       if defined(BOOST_CLANG) || defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(mask));
+#       else
+        size_t result = 0;
+        while ((mask & 0x01) == 0) {
+            mask >>= 1;
+            ++result;
+        }
+        return result;
+#       endif
+    }
+
+ private:
+
+    struct entry {
+        // set with release semantics after all other members are written
+        std::atomic<bool> used;
+        size_t hash;
+        const std::type_info* token;
+        bitmask mask;
+        // element types of dynamically typed messages (token == nullptr)
+        std::vector<const uniform_type_info*> types;
+        entry() : used(false), hash(0), token(nullptr), mask(0) { }
+    };
+
+    struct table {
+        // the table this one replaced
+        table* prev;
+        // always a power of two
+        size_t capacity;
+        std::unique_ptr<entry[]> entries;
+        table(table* predecessor, size_t cap)
+                : prev(predecessor), capacity(cap), entries(new entry[cap]) {
+            // nop
+        }
+    };
+
+    static inline size_t mix(std::uint64_t x) {
+        x ^= x >> 31;
+        x *= 0x9e3779b97f4a7c15ULL;
+        x ^= x >> 29;
+        return static_cast<size_t>(x);
+    }
+
+    static inline size_t hash_of(const std::type_info* token,
+                                 const message_data& msg) {
+        if (token == nullptr) return mix(dynamic_hash(msg));
+        return mix(reinterpret_cast<std::uintptr_t>(token));
+    }
+
+    static std::uint64_t dynamic_hash(const message_data& msg);
+
+    static bool same_types(const entry& e, const message_data& msg);
+
+    static inline const bitmask* find(const table& tbl,
+                                      const message_data& msg) {
+        auto token = msg.dynamically_typed() ? nullptr : msg.type_token();
+        auto h = hash_of(token, msg);
+        auto mod = tbl.capacity - 1;
+        for (auto i = h & mod; ; i = (i + 1) & mod) {
+            auto& e = tbl.entries[i];
+            if (!e.used.load(std::memory_order_acquire)) return nullptr;
+            if (   e.hash == h && e.token == token
+                && (token != nullptr || same_types(e, msg))) {
+                return &e.mask;
+            }
+        }
+    }
+
+    // returns a free slot for hash in tbl, requires m_mtx
+    static entry& free_slot(table& tbl, size_t hash);
+
+    // grows the table if necessary, requires m_mtx
+    table* reserve(size_t new_size);
+
+    std::atomic<table*> m_table;
+
+    std::atomic<size_t> m_size;
+
+    // serializes writers
+    std::mutex m_mtx;
+
+};
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_DETAIL_DISPATCH_TABLE_HPP
@@ -24,7 +24,7 @@
 #include <thread>
 
 #include "boost/actor/abstract_group.hpp"
-#include "boost/actor/detail/shared_spinlock.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
 
 #include "boost/actor/detail/singleton_mixin.hpp"
 
@@ -0,0 +1,114 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_INTRUSIVE_LIST_HPP
+#define BOOST_ACTOR_INTRUSIVE_LIST_HPP
+
+#include <memory>
+
+#include "boost/actor/config.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief A singly linked, intrusive FIFO list. All remaining
+ *        elements are deleted using @p Delete on destruction.
+ * @note Elements are linked via their <tt>next</tt> member, i.e.,
+ *       inserting elements into this list does not allocate memory.
+ */
+template<typename T, class Delete = std::default_delete<T> >
+class intrusive_list {
+
+ public:
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+
+    intrusive_list() : m_head(nullptr), m_tail(nullptr) { }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    ~intrusive_list() {
+        clear();
+    }
+
+    inline bool empty() const {
+        return m_head == nullptr;
+    }
+
+    inline pointer front() const {
+        return m_head;
+    }
+
+    void push_back(pointer ptr) {
+        ptr->next = nullptr;
+        if (m_tail) m_tail->next = ptr;
+        else m_head = ptr;
+        m_tail = ptr;
+    }
+
+    /**
+     * @brief Appends the chain from @p first to @p last in constant time.
+     */
+    void append(pointer first, pointer last) {
+        BOOST_ACTOR_REQUIRE(first != nullptr && last != nullptr);
+        last->next = nullptr;
+        if (m_tail) m_tail->next = first;
+        else m_head = first;
+        m_tail = last;
+    }
+
+    /**
+     * @brief Removes the first element and returns it
+     *        or returns @p nullptr if the list is empty.
+     */
+    pointer pop_front() {
+        auto result = m_head;
+        if (result) {
+            m_head = result->next;
+            if (!m_head) m_tail = nullptr;
+            result->next = nullptr;
+        }
+        return result;
+    }
+
+    void clear() {
+        while (m_head) {
+            auto next = m_head->next;
+            m_delete(m_head);
+            m_head = next;
+        }
+        m_tail = nullptr;
+    }
+
+ private:
+
+    pointer m_head;
+    pointer m_tail;
+    Delete  m_delete;
+
+};
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_INTRUSIVE_LIST_HPP
@@ -126,7 +126,7 @@ class lifted_fun_invoker<bool, F> {
     template<typename T, typename... Ts>
     typename std::enable_if<(sizeof...(Ts) + 1 > args), bool>::type
     operator()(T&& arg, Ts&&... args) const {
-        if (has_none(arg)) return none;
+        if (has_none(arg)) return false;
         return (*this)(args...);
     }
 
@@ -194,6 +194,14 @@ class lifted_fun {
                                     std::forward_as_tuple(args...)));
     }
 
+    /** @cond PRIVATE */
+
+    inline const projections& projection_funs() const {
+        return m_ps;
+    }
+
+    /** @endcond */
+
  private:
 
     F m_fun;
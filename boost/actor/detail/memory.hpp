@@ -20,6 +20,8 @@
 #define BOOST_ACTOR_MEMORY_HPP
 
 #include <new>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -29,8 +31,6 @@
 #include "boost/actor/config.hpp"
 #include "boost/actor/ref_counted.hpp"
 
-namespace boost { namespace actor { class mailbox_element; } }
-
 namespace boost {
 namespace actor {
 namespace detail {
@@ -63,19 +63,18 @@ class instance_wrapper {
 
 };
 
-class memory_cache {
+class memory_cache : public ref_counted {
 
  public:
 
     virtual ~memory_cache();
 
-    // calls dtor and either releases memory or re-uses it later
-    virtual void release_instance(void*) = 0;
-
     virtual std::pair<instance_wrapper*, void*> new_instance() = 0;
 
-    // casts @p ptr to the derived type and returns it
-    virtual void* downcast(memory_managed* ptr) = 0;
+    // releases all cached elements and redirects elements released by
+    // other threads back to their storage; called by the owning thread
+    // before it exits
+    virtual void close() = 0;
 
 };
 
@@ -101,130 +100,240 @@ class memory {
         return new T (std::forward<Ts>(args)...);
     }
 
-    static inline memory_cache* get_cache_map_entry(const std::type_info*) {
-        return nullptr;
+    /*
+     * @brief Initializes a new object in storage provided by another
+     *        object, e.g., a mailbox element embedded into its message.
+     */
+    template<typename T, typename... Ts>
+    static T* create_embedded(std::pair<instance_wrapper*, void*> storage,
+                              Ts&&... args) {
+        auto result = new (storage.second) T (std::forward<Ts>(args)...);
+        result->outer_memory = storage.first;
+        return result;
     }
 
 };
 
 #else // BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
 
+class memory {
+
+    memory() = delete;
+
+    template<typename>
+    friend class basic_memory_cache;
+
+ public:
+
+    /*
+     * @brief Allocates storage, initializes a new object, and returns
+     *        the new instance.
+     */
+    template<typename T, typename... Ts>
+    static T* create(Ts&&... args) {
+        auto mc = get_or_set_cache<T>();
+        auto p = mc->new_instance();
+        auto result = new (p.second) T (std::forward<Ts>(args)...);
+        result->outer_memory = p.first;
+        return result;
+    }
+
+    /*
+     * @brief Initializes a new object in storage provided by another
+     *        object, e.g., a mailbox element embedded into its message.
+     */
+    template<typename T, typename... Ts>
+    static T* create_embedded(std::pair<instance_wrapper*, void*> storage,
+                              Ts&&... args) {
+        auto result = new (storage.second) T (std::forward<Ts>(args)...);
+        result->outer_memory = storage.first;
+        return result;
+    }
+
+    /*
+     * @brief Returns the cache of the calling thread for the type
+     *        identified by @p idx or @p nullptr if no such cache exists.
+     */
+    static memory_cache* get_cache(size_t idx);
+
+    /*
+     * @brief Returns a process-wide unique index for @p T, which
+     *        replaces type_info lookups on each allocation.
+     * @note The index is assigned on first use rather than at compile
+     *       time, because types are not known across translation units.
+     */
+    template<typename T>
+    static size_t cache_index() {
+        static size_t result = next_cache_index();
+        return result;
+    }
+
+ private:
+
+    static size_t next_cache_index();
+
+    static void set_cache(size_t idx, memory_cache* instance);
+
+    template<typename T>
+    static inline memory_cache* get_or_set_cache() {
+        auto idx = cache_index<T>();
+        auto mc = get_cache(idx);
+        if (!mc) {
+            mc = new basic_memory_cache<T>;
+            set_cache(idx, mc);
+        }
+        return mc;
+    }
+
+};
+
+/*
+ * Each thread has one cache per type. Elements released by the owning
+ * thread go back to its list of cached elements, while other threads
+ * push released elements to a lock-free stack that the owner collects
+ * in a single batch once it runs out of cached elements. The owner caches
+ * at most about s_cache_size bytes per type, all other elements are
+ * returned to their storage, which is freed once all of its elements are.
+ * Storage sizes start at s_min_elements and double up to s_alloc_size
+ * bytes, i.e., rarely used types do not occupy a full chunk per thread.
+ */
 template<typename T>
 class basic_memory_cache : public memory_cache {
 
     static constexpr size_t ne = s_alloc_size / sizeof(T);
     static constexpr size_t dsize = ne > s_min_elements ? ne : s_min_elements;
 
+    static constexpr size_t nc = s_cache_size / sizeof(T);
+    static constexpr size_t max_cached = nc > dsize ? nc : dsize;
+
+    class storage;
+
     struct wrapper : instance_wrapper {
-        ref_counted* parent;
+        storage* parent;
+        wrapper* next; // intrusive pointer for elements released remotely
         union { T instance; };
-        wrapper() : parent(nullptr) { }
+        wrapper() : parent(nullptr), next(nullptr) { }
         ~wrapper() { }
         void destroy() { instance.~T(); }
-        void deallocate() { parent->deref(); }
+        void deallocate() { parent->owner()->release(this); }
     };
 
     class storage : public ref_counted {
 
      public:
 
-        storage() {
-            for (auto& elem : data) {
+        storage(basic_memory_cache* owner, size_t size)
+        : m_owner(owner), m_size(size), m_data(new wrapper[size]) {
+            // each storage keeps its cache alive, because
+            // other threads might still release elements to it
+            m_owner->ref();
+            for (auto i = begin(); i != end(); ++i) {
                 // each instance has a reference to its parent
-                elem.parent = this;
-                ref(); // deref() is called in wrapper::deallocate
+                i->parent = this;
+                ref(); // deref() is called when the cache drops elem
             }
         }
 
-        typedef wrapper* iterator;
+        ~storage() {
+            m_owner->deref();
+        }
 
-        iterator begin() { return data; }
+        inline basic_memory_cache* owner() const {
+            return m_owner;
+        }
 
-        iterator end() { return begin() + dsize; }
+        typedef wrapper* iterator;
 
-     private:
+        iterator begin() { return m_data.get(); }
 
-        wrapper data[dsize];
+        iterator end() { return begin() + m_size; }
 
-    };
+     private:
 
- public:
+        basic_memory_cache* m_owner;
 
-    std::vector<wrapper*> cached_elements;
+        size_t m_size;
 
-    basic_memory_cache() {
-        cached_elements.reserve(dsize);
-    }
+        std::unique_ptr<wrapper[]> m_data;
 
-    ~basic_memory_cache() {
-        for (auto e : cached_elements) e->deallocate();
-    }
+    };
 
-    void* downcast(memory_managed* ptr) {
-        return static_cast<T*>(ptr);
-    }
+ public:
 
+    basic_memory_cache() : m_next_size(s_min_elements), m_remote(nullptr) { }
 
-    void release_instance(void* vptr) override {
-        BOOST_ACTOR_REQUIRE(vptr != nullptr);
-        auto ptr = reinterpret_cast<T*>(vptr);
-        BOOST_ACTOR_REQUIRE(ptr->outer_memory != nullptr);
-        auto wptr = static_cast<wrapper*>(ptr->outer_memory);
-        wptr->destroy();
-        wptr->deallocate();
+    void close() override {
+        for (auto e : m_cached) e->parent->deref();
+        m_cached.clear();
+        drop(m_remote.exchange(closed_tag()));
     }
 
     std::pair<instance_wrapper*, void*> new_instance() override {
-        if (cached_elements.empty()) {
-            auto elements = new storage;
-            for (auto i = elements->begin(); i != elements->end(); ++i) {
-                cached_elements.push_back(i);
+        if (m_cached.empty()) {
+            // collect all elements released by other threads at once
+            collect(m_remote.exchange(nullptr));
+            if (m_cached.empty()) {
+                auto elements = new storage(this, m_next_size);
+                m_next_size = std::min(m_next_size * 2, dsize);
+                for (auto i = elements->begin(); i != elements->end(); ++i) {
+                    m_cached.push_back(i);
+                }
             }
         }
-        wrapper* wptr = cached_elements.back();
-        cached_elements.pop_back();
+        wrapper* wptr = m_cached.back();
+        m_cached.pop_back();
         return std::make_pair(wptr, &(wptr->instance));
     }
 
-};
-
-class memory {
-
-    memory() = delete;
-
-    template<typename>
-    friend class basic_memory_cache;
+ private:
 
- public:
+    void release(wrapper* wptr) {
+        if (memory::get_cache(memory::cache_index<T>()) == this) {
+            // fast path: released by the owning thread
+            if (m_cached.size() < max_cached) m_cached.push_back(wptr);
+            else wptr->parent->deref();
+            return;
+        }
+        auto e = m_remote.load();
+        for (;;) {
+            if (e == closed_tag()) {
+                // owner is gone, return element to its storage
+                wptr->parent->deref();
+                return;
+            }
+            wptr->next = e;
+            if (m_remote.compare_exchange_weak(e, wptr)) return;
+        }
+    }
 
-    /*
-     * @brief Allocates storage, initializes a new object, and returns
-     *        the new instance.
-     */
-    template<typename T, typename... Ts>
-    static T* create(Ts&&... args) {
-        auto mc = get_or_set_cache_map_entry<T>();
-        auto p = mc->new_instance();
-        auto result = new (p.second) T (std::forward<Ts>(args)...);
-        result->outer_memory = p.first;
-        return result;
+    void collect(wrapper* e) {
+        while (e) {
+            auto next = e->next;
+            if (m_cached.size() < max_cached) m_cached.push_back(e);
+            else e->parent->deref();
+            e = next;
+        }
     }
 
-    static memory_cache* get_cache_map_entry(const std::type_info* tinf);
+    void drop(wrapper* e) {
+        while (e) {
+            auto next = e->next;
+            e->parent->deref();
+            e = next;
+        }
+    }
 
- private:
+    inline wrapper* closed_tag() {
+        // we are *never* going to dereference the returned pointer
+        return reinterpret_cast<wrapper*>(this);
+    }
 
-    static void add_cache_map_entry(const std::type_info* tinf, memory_cache* instance);
+    // accessed only by the owning thread
+    std::vector<wrapper*> m_cached;
+    size_t m_next_size;
 
-    template<typename T>
-    static inline memory_cache* get_or_set_cache_map_entry() {
-        auto mc = get_cache_map_entry(&typeid(T));
-        if (!mc) {
-            mc = new basic_memory_cache<T>;
-            add_cache_map_entry(&typeid(T), mc);
-        }
-        return mc;
-    }
+    // elements released by other threads
+    std::atomic<wrapper*> m_remote;
 
 };
 
@@ -20,6 +20,7 @@
 #define BOOST_ACTOR_ABSTRACT_TUPLE_HPP
 
 #include <string>
+#include <utility>
 #include <iterator>
 #include <typeinfo>
 
@@ -37,6 +38,8 @@ namespace boost {
 namespace actor {
 namespace detail {
 
+class instance_wrapper;
+
 class message_data : public ref_counted {
 
  public:
@@ -70,6 +73,15 @@ class message_data : public ref_counted {
     // (default returns &typeid(void))
     virtual const std::type_info* type_token() const;
 
+    // returns true if no other message refers to this instance; differs
+    // from unique() if a mailbox element is embedded into this instance
+    virtual bool unshared() const;
+
+    // returns storage for a mailbox element along with the wrapper
+    // releasing it or {nullptr, nullptr} (default) if this instance
+    // does not provide such storage or if unshared() returns false
+    virtual std::pair<instance_wrapper*, void*> embedded_element();
+
     bool equals(const message_data& other) const;
 
     typedef message_iterator<message_data> const_iterator;
@@ -41,10 +41,26 @@ class proper_actor_base : public Policies::resume_policy::template mixin<Base, D
     typedef typename Policies::scheduling_policy::timeout_type timeout_type;
 
     void enqueue(msg_hdr_cref hdr, message msg, execution_unit* eu) override {
+        enqueue_impl(hdr, msg, eu);
+    }
+
+    bool try_enqueue(msg_hdr_cref hdr, message msg,
+                     execution_unit* eu) override {
+        return enqueue_impl(hdr, msg, eu);
+    }
+
+    // returns false if the sender has to slow down
+    bool enqueue_impl(msg_hdr_cref hdr, message& msg, execution_unit* eu) {
         BOOST_ACTOR_PUSH_AID(dptr()->id());
         BOOST_ACTOR_LOG_DEBUG(BOOST_ACTOR_TARG(hdr, to_string)
                        << ", " << BOOST_ACTOR_TARG(msg, to_string));
+        auto res = this->admit_message(hdr, msg);
+        if (res == local_actor::admission::dropped) {
+            BOOST_ACTOR_LOG_DEBUG("mailbox full, drop message");
+            return true;
+        }
         scheduling_policy().enqueue(dptr(), hdr, msg, eu);
+        return res != local_actor::admission::overloaded;
     }
 
     inline void launch(bool is_hidden, execution_unit* host) {
@@ -71,7 +87,13 @@ class proper_actor_base : public Policies::resume_policy::template mixin<Base, D
     // member functions from priority policy
 
     inline unique_mailbox_element_pointer next_message() {
-        return priority_policy().next_message(dptr());
+        auto result = priority_policy().next_message(dptr());
+        while (result && this->discard_dequeued(*result)) {
+            BOOST_ACTOR_LOG_DEBUG("mailbox exceeds its capacity, "
+                                  "drop oldest message");
+            result = priority_policy().next_message(dptr());
+        }
+        return result;
     }
 
     inline bool has_next_message() {
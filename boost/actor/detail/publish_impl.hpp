@@ -19,6 +19,8 @@
 #ifndef BOOST_ACTOR_DETAIL_PUBLISH_IMPL_HPP
 #define BOOST_ACTOR_DETAIL_PUBLISH_IMPL_HPP
 
+#include <cstdint>
+
 #include "boost/actor/abstract_actor.hpp"
 
 #include "boost/actor/io/acceptor.hpp"
@@ -31,6 +33,9 @@ namespace detail {
 
 void publish_impl(abstract_actor_ptr whom, io::acceptor_uptr aptr);
 
+void publish_impl(abstract_actor_ptr whom, std::uint16_t port,
+                  const char* addr);
+
 } // namespace detail
 } // namespace actor
 } // namespace boost
@@ -20,8 +20,11 @@
 #define BOOST_ACTOR_DETAIL_REMOTE_ACTOR_IMPL_HPP
 
 #include <set>
+#include <chrono>
 #include <string>
+#include <cstdint>
 
+#include "boost/actor/actor.hpp"
 #include "boost/actor/abstract_actor.hpp"
 
 #include "boost/actor/io/acceptor.hpp"
@@ -35,6 +38,9 @@ namespace detail {
 abstract_actor_ptr remote_actor_impl(io::stream_ptr_pair io,
                                      std::set<std::string> expected);
 
+void remote_actor_impl(actor listener, std::string host, std::uint16_t port,
+                       std::chrono::milliseconds timeout);
+
 } // namespace detail
 } // namespace actor
 } // namespace boost
@@ -0,0 +1,119 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_DETAIL_SCALABLE_RW_LOCK_HPP
+#define BOOST_ACTOR_DETAIL_SCALABLE_RW_LOCK_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+#include "boost/actor/detail/producer_consumer_list.hpp" // cache line size
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief A reader-writer lock for read-mostly data on many cores.
+ *
+ * Readers announce themselves in one of {@link num_slots()} counters, each
+ * on its own cache line, selected by the ID of the calling thread. Hence,
+ * concurrent readers on different cores do not write to the same cache
+ * line. A writer first sets the writer flag, which stops new readers from
+ * entering, and then waits until all reader slots are empty. Threads
+ * that cannot acquire the lock back off exponentially and eventually
+ * park on a futex (Linux) or yield (other platforms).
+ *
+ * An upgrade lock coexists with readers but excludes writers and other
+ * upgraders, i.e., upgrading it to an exclusive lock is atomic.
+ *
+ * Models the Boost.Thread @p UpgradeLockable concept.
+ */
+class scalable_rw_lock {
+
+ public:
+
+    /**
+     * @brief Returns the number of reader slots per lock, i.e., the
+     *        number of hardware threads rounded up to a power of two.
+     */
+    static size_t num_slots();
+
+    scalable_rw_lock();
+
+    scalable_rw_lock(const scalable_rw_lock&) = delete;
+
+    scalable_rw_lock& operator=(const scalable_rw_lock&) = delete;
+
+    void lock();
+    void unlock();
+    bool try_lock();
+
+    void lock_shared();
+    void unlock_shared();
+    bool try_lock_shared();
+
+    void lock_upgrade();
+    void unlock_upgrade();
+    void unlock_upgrade_and_lock();
+    void unlock_and_lock_upgrade();
+    void unlock_upgrade_and_lock_shared();
+
+ private:
+
+    static constexpr int writer_flag = 0x01;
+    static constexpr int upgrader_flag = 0x02;
+    static constexpr int waiters_flag = 0x04;
+
+    struct slot {
+        std::atomic<long> readers;
+        char pad[BOOST_ACTOR_CACHE_LINE_SIZE - sizeof(std::atomic<long>)];
+        slot() : readers(0) { }
+    };
+
+    // returns the reader slot of the calling thread
+    slot& my_slot();
+
+    // sets @p flag once neither a writer nor an upgrader holds the lock
+    void acquire(int flag);
+
+    // clears @p flag and wakes up all parked threads
+    void release(int flag);
+
+    // blocks until all reader slots are empty
+    void await_readers();
+
+    // blocks until @p m_state has none of the bits in @p mask set
+    void await_state(int mask);
+
+    // futex word holding writer_flag, upgrader_flag and waiters_flag
+    std::atomic<int> m_state;
+    // num_slots() - 1
+    size_t m_slot_mask;
+    // points to the first cache line boundary in m_storage
+    slot* m_slots;
+    std::unique_ptr<char[]> m_storage;
+
+};
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_DETAIL_SCALABLE_RW_LOCK_HPP
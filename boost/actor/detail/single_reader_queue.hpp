@@ -27,6 +27,8 @@
 
 #include "boost/actor/config.hpp"
 
+#include "boost/actor/detail/intrusive_list.hpp"
+
 namespace boost {
 namespace actor {
 namespace detail {
@@ -76,6 +78,29 @@ class single_reader_queue {
         return take_head();
     }
 
+    /**
+     * @brief Moves all elements of this queue to the end of @p storage
+     *        at once, preserving their FIFO order.
+     * @returns The number of moved elements.
+     * @warning call only from the reader (owner)
+     */
+    size_t take_all(intrusive_list<T, Delete>& storage) {
+        size_t result = 0;
+        // elements left over from previous calls to try_pop()
+        while (m_head) {
+            auto next = m_head->next;
+            storage.push_back(m_head);
+            m_head = next;
+            ++result;
+        }
+        pointer tail;
+        if (fetch_new_data(stack_empty_dummy(), &tail, &result)) {
+            storage.append(m_head, tail);
+            m_head = nullptr;
+        }
+        return result;
+    }
+
     template<class UnaryPredicate>
     void remove_if(UnaryPredicate f) {
         pointer head = m_head;
@@ -288,8 +313,12 @@ class single_reader_queue {
     pointer m_head;
     Delete  m_delete;
 
-    // atomically sets m_stack back and enqueues all elements to the cache
-    bool fetch_new_data(pointer end_ptr) {
+    // atomically sets m_stack back and enqueues all elements to the cache;
+    // optionally stores the last element of the cache in tail and
+    // increments count by the number of fetched elements
+    bool fetch_new_data(pointer end_ptr,
+                        pointer* tail = nullptr,
+                        size_t* count = nullptr) {
         BOOST_ACTOR_REQUIRE(m_head == nullptr);
         BOOST_ACTOR_REQUIRE(!end_ptr || end_ptr == stack_empty_dummy());
         pointer e = m_stack.load();
@@ -305,13 +334,21 @@ class single_reader_queue {
                     BOOST_ACTOR_REQUIRE(end_ptr == nullptr);
                     return false;
                 }
+                // the most recently enqueued element becomes the tail
+                if (tail) *tail = e;
+                size_t n = 0;
                 while (e) {
                     BOOST_ACTOR_REQUIRE(!is_dummy(e));
                     auto next = e->next;
+                    // hide the latency of loading the next element,
+                    // which is most likely not in the cache of the reader
+                    BOOST_ACTOR_PREFETCH(next);
                     e->next = m_head;
                     m_head = e;
                     e = next;
+                    ++n;
                 }
+                if (count) *count += n;
                 return true;
             }
             // next iteration
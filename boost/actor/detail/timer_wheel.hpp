@@ -0,0 +1,223 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_TIMER_WHEEL_HPP
+#define BOOST_ACTOR_TIMER_WHEEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "boost/intrusive_ptr.hpp"
+
+#include "boost/actor/message.hpp"
+#include "boost/actor/ref_counted.hpp"
+#include "boost/actor/message_header.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+class timer_wheel;
+
+/**
+ * @brief A message that is delivered once its due time is reached,
+ *        unless it has been cancelled before.
+ */
+class timer_entry : public ref_counted {
+
+    friend class timer_wheel;
+
+ public:
+
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    typedef clock_type::time_point time_point;
+
+    timer_entry(time_point due_time, message_header header, message content);
+
+    // intrusive pointer used by the request queue of the timer
+    // and by the slots of the timer wheel
+    timer_entry* next;
+
+    // intrusive pointer used by the list of cancelled entries
+    timer_entry* next_cancelled;
+
+    time_point due;
+
+    message_header hdr;
+
+    message msg;
+
+    /**
+     * @brief Drops header and content and releases the reference
+     *        held by the timer.
+     */
+    void release();
+
+    /**
+     * @brief Disarms this entry, i.e., makes sure it is neither delivered
+     *        nor cancelled afterwards, and returns @p true if it has
+     *        not been disarmed before.
+     */
+    inline bool disarm() {
+        return !m_disarmed.exchange(true);
+    }
+
+    inline bool armed() const {
+        return !m_disarmed.load();
+    }
+
+ private:
+
+    std::atomic<bool> m_disarmed;
+
+    // the following members are accessed only by timer_wheel
+
+    timer_entry* m_prev;
+
+    // points to the slot this entry is stored in or nullptr
+    std::pair<timer_entry*, timer_entry*>* m_slot;
+
+};
+
+/**
+ * @brief A handle to a pending timer entry.
+ */
+typedef intrusive_ptr<timer_entry> timer_handle;
+
+/**
+ * @brief A hierarchical timing wheel with a resolution of one millisecond.
+ *
+ * Each of the four levels consists of 256 slots, the first level stores
+ * entries due within the next 256 ticks, the second level entries due
+ * within the next 256^2 ticks, and so on. Entries of higher levels are
+ * moved to lower levels (cascaded) once the first level did a full turn.
+ * Inserting and erasing entries is O(1).
+ * @note Not thread-safe, all member functions must be called by the
+ *       thread running the timer.
+ */
+class timer_wheel {
+
+ public:
+
+    typedef timer_entry::time_point time_point;
+
+    typedef std::chrono::milliseconds tick_duration;
+
+    static constexpr size_t num_levels = 4;
+
+    static constexpr size_t slot_bits = 8;
+
+    static constexpr size_t num_slots = size_t{1} << slot_bits;
+
+    timer_wheel(time_point origin);
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    ~timer_wheel();
+
+    /**
+     * @brief Adds @p ptr to the wheel, taking over a reference of the caller.
+     */
+    void insert(timer_entry* ptr);
+
+    /**
+     * @brief Removes @p ptr from the wheel and releases its reference.
+     * @returns @p false if @p ptr was not stored in the wheel.
+     */
+    bool erase(timer_entry* ptr);
+
+    /**
+     * @brief Processes all ticks up to @p now, calls @p f for each due
+     *        entry that is still armed, and releases due entries afterwards.
+     */
+    template<class F>
+    void advance(time_point now, F f) {
+        auto last = elapsed_ticks(now);
+        if (m_size == 0) {
+            // nothing to cascade, skip all ticks up to now
+            if (m_next <= last) m_next = last + 1;
+            return;
+        }
+        while (m_next <= last) {
+            auto index = m_next & (num_slots - 1);
+            if (index == 0) cascade();
+            auto& slot = m_slots[0][index];
+            auto e = slot.first;
+            slot.first = slot.second = nullptr;
+            while (e) {
+                auto next = e->next;
+                e->m_slot = nullptr;
+                --m_size;
+                if (e->disarm()) f(*e);
+                e->release();
+                e = next;
+            }
+            ++m_next;
+        }
+    }
+
+    /**
+     * @brief Returns the point in time at which @p advance
+     *        must be called next.
+     * @pre <tt>!empty()</tt>
+     */
+    time_point next_timeout() const;
+
+    inline bool empty() const {
+        return m_size == 0;
+    }
+
+    inline size_t size() const {
+        return m_size;
+    }
+
+ private:
+
+    typedef std::pair<timer_entry*, timer_entry*> slot_type;
+
+    // number of ticks passed between m_origin and tp
+    std::uint64_t elapsed_ticks(time_point tp) const;
+
+    // rounds up to ensure that entries are never delivered too early
+    std::uint64_t due_tick(time_point tp) const;
+
+    void add(timer_entry* ptr);
+
+    void cascade();
+
+    time_point m_origin;
+
+    // the next tick that is going to be processed
+    std::uint64_t m_next;
+
+    size_t m_size;
+
+    // stores head and tail of each slot
+    slot_type m_slots[num_levels][num_slots];
+
+};
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_TIMER_WHEEL_HPP
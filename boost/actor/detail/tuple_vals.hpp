@@ -20,8 +20,15 @@
 #define BOOST_ACTOR_TUPLE_VALS_HPP
 
 #include <tuple>
+#include <atomic>
 #include <stdexcept>
+#include <type_traits>
 
+#include "boost/actor/extend.hpp"
+
+#include "boost/actor/mixin/memory_cached.hpp"
+
+#include "boost/actor/detail/memory.hpp"
 #include "boost/actor/detail/type_list.hpp"
 
 #include "boost/actor/detail/types_array.hpp"
@@ -55,12 +62,15 @@ struct tup_ptr_access<Pos, Max, false> {
 };
 
 template<typename... Ts>
-class tuple_vals : public message_data {
+class tuple_vals : public extend<message_data, tuple_vals<Ts...>>::
+                          template with<mixin::memory_cached> {
 
     static_assert(sizeof...(Ts) > 0,
                   "tuple_vals is not allowed to be empty");
 
-    typedef message_data super;
+    typedef typename extend<message_data, tuple_vals<Ts...>>::
+            template with<mixin::memory_cached>
+            super;
 
  public:
 
@@ -94,7 +104,7 @@ class tuple_vals : public message_data {
     }
 
     tuple_vals* copy() const {
-        return new tuple_vals(*this);
+        return memory::create<tuple_vals>(*this);
     }
 
     const void* at(size_t pos) const {
@@ -142,6 +152,88 @@ class tuple_vals : public message_data {
 template<typename... Ts>
 types_array<Ts...> tuple_vals<Ts...>::m_types;
 
+/*
+ * Releases a mailbox element that has been
+ * constructed into the storage of its message.
+ */
+class embedded_element_wrapper : public instance_wrapper {
+
+ public:
+
+    // storage reserved for a mailbox_element
+    static constexpr size_t storage_size = 64;
+
+    // make_message embeds mailbox elements only into small messages
+    static constexpr size_t max_payload = 32;
+
+    embedded_element_wrapper(message_data* parent);
+
+    // marks the storage as used and keeps the parent alive until
+    // deallocate() is called; returns false if already claimed
+    bool claim();
+
+    inline bool claimed() const {
+        return m_claimed.load(std::memory_order_acquire);
+    }
+
+    // calls the destructor of the mailbox element
+    void destroy() override;
+
+    // releases the reference acquired by claim()
+    void deallocate() override;
+
+    inline void* storage() { return &m_storage; }
+
+ private:
+
+    message_data* m_parent;
+
+    // written by the thread destroying the mailbox element,
+    // read by senders that still hold the message
+    std::atomic<bool> m_claimed;
+
+    std::aligned_storage<storage_size>::type m_storage;
+
+};
+
+/*
+ * A tuple_vals that provides storage for the mailbox element it is
+ * delivered with. Sender and receiver thus share a single allocation
+ * as long as only one message refers to this instance, shared instances
+ * fall back to allocating mailbox elements separately.
+ */
+template<typename... Ts>
+class tuple_vals_with_element : public tuple_vals<Ts...> {
+
+    typedef tuple_vals<Ts...> super;
+
+ public:
+
+    tuple_vals_with_element(const tuple_vals_with_element&) = delete;
+
+    template<typename... Us>
+    tuple_vals_with_element(Us&&... args)
+    : super(std::forward<Us>(args)...), m_element(this) { }
+
+    bool unshared() const override {
+        // the reference acquired by claim() does not belong to a message
+        auto rc = this->get_reference_count();
+        return rc == (m_element.claimed() ? 2 : 1);
+    }
+
+    std::pair<instance_wrapper*, void*> embedded_element() override {
+        if (unshared() && m_element.claim()) {
+            return {&m_element, m_element.storage()};
+        }
+        return {nullptr, nullptr};
+    }
+
+ private:
+
+    embedded_element_wrapper m_element;
+
+};
+
 } // namespace detail
 } // namespace actor
 } // namespace boost
@@ -39,6 +39,7 @@
 
 #include "boost/actor/io/buffer.hpp"
 #include "boost/actor/io/accept_handle.hpp"
+#include "boost/actor/io/datagram_handle.hpp"
 #include "boost/actor/io/connection_handle.hpp"
 
 namespace boost { namespace actor { class uniform_type_info; } }
@@ -56,6 +57,7 @@ using mapped_type_list = detail::type_list<
     atom_value,
     channel,
     connection_closed_msg,
+    datagram_closed_msg,
     down_msg,
     duration,
     exit_msg,
@@ -64,10 +66,12 @@ using mapped_type_list = detail::type_list<
     io::accept_handle,
     io::buffer,
     io::connection_handle,
+    io::datagram_handle,
     message,
     message_header,
     new_connection_msg,
     new_data_msg,
+    new_datagram_msg,
     sync_exited_msg,
     sync_timeout_msg,
     timeout_msg,
@@ -0,0 +1,213 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_WORK_STEALING_DEQUE_HPP
+#define BOOST_ACTOR_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "boost/actor/config.hpp"
+
+#include "boost/actor/detail/producer_consumer_list.hpp" // cache line size
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+/**
+ * @brief A lock-free work-stealing deque of pointers.
+ *
+ * The owner pushes and takes elements at the bottom end without any
+ * contention, while any other thread can steal elements from the top end.
+ * The ring buffer grows on demand by doubling its capacity, i.e., pushing
+ * to the deque never allocates unless the deque runs full. Retired buffers
+ * are kept alive until the deque is destroyed, because thieves might still
+ * read from them; their total size is bounded by the size of the current
+ * buffer.
+ *
+ * For implementation details see http://dl.acm.org/citation.cfm?id=1073974
+ * and http://dl.acm.org/citation.cfm?id=2442524 (C11 memory model).
+ */
+template<typename T>
+class work_stealing_deque {
+
+ public:
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+    typedef std::int64_t index_type;
+
+    static constexpr size_t default_log_capacity = 8;
+
+    work_stealing_deque(size_t log_capacity = default_log_capacity)
+    : m_top(0), m_bottom(0) {
+        m_buffers.emplace_back(new buffer(log_capacity));
+        m_buffer = m_buffers.back().get();
+    }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    /**
+     * @brief Pushes @p value to the bottom end.
+     * @warning Call only from the owner.
+     */
+    void push(pointer value) {
+        BOOST_ACTOR_REQUIRE(value != nullptr);
+        auto b = m_bottom.load(std::memory_order_relaxed);
+        auto t = m_top.load(std::memory_order_acquire);
+        auto buf = m_buffer.load(std::memory_order_relaxed);
+        if (b - t > buf->capacity() - 1) buf = grow(buf, t, b);
+        buf->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Takes the most recently pushed element from the bottom end.
+     * @returns The element or @p nullptr if the deque is empty.
+     * @warning Call only from the owner.
+     */
+    pointer take() {
+        auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+        auto buf = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = m_top.load(std::memory_order_relaxed);
+        pointer result = nullptr;
+        if (t <= b) {
+            result = buf->get(b);
+            if (t == b) {
+                // last element, race against thieves
+                if (!m_top.compare_exchange_strong(t, t + 1,
+                                                   std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                    result = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            // deque was empty
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Steals the least recently pushed element from the top end.
+     * @returns The element or @p nullptr if the deque is empty or if
+     *          another thread won the race for the top element.
+     * @note Can be called from any thread.
+     */
+    pointer steal() {
+        auto t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = m_bottom.load(std::memory_order_acquire);
+        if (t < b) {
+            auto buf = m_buffer.load(std::memory_order_acquire);
+            auto result = buf->get(t);
+            if (m_top.compare_exchange_strong(t, t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                return result;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns an approximation of the number of stored elements.
+     */
+    inline size_t size() const {
+        auto b = m_bottom.load(std::memory_order_relaxed);
+        auto t = m_top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    inline bool empty() const {
+        return size() == 0;
+    }
+
+ private:
+
+    class buffer {
+
+     public:
+
+        buffer(size_t log_capacity)
+        : m_mask((index_type{1} << log_capacity) - 1)
+        , m_data(new std::atomic<pointer>[size_t{1} << log_capacity]) { }
+
+        inline index_type capacity() const {
+            return m_mask + 1;
+        }
+
+        inline pointer get(index_type i) const {
+            return m_data[i & m_mask].load(std::memory_order_relaxed);
+        }
+
+        inline void put(index_type i, pointer value) {
+            m_data[i & m_mask].store(value, std::memory_order_relaxed);
+        }
+
+     private:
+
+        index_type m_mask;
+        std::unique_ptr<std::atomic<pointer>[]> m_data;
+
+    };
+
+    // called by the owner only; the old buffer stays valid for thieves
+    buffer* grow(buffer* old, index_type t, index_type b) {
+        size_t log_capacity = 0;
+        while ((index_type{1} << log_capacity) <= old->capacity()) {
+            ++log_capacity;
+        }
+        m_buffers.emplace_back(new buffer(log_capacity));
+        auto result = m_buffers.back().get();
+        for (auto i = t; i < b; ++i) result->put(i, old->get(i));
+        m_buffer.store(result, std::memory_order_release);
+        return result;
+    }
+
+    // read by thieves, written by thieves (CAS) and by the owner
+    std::atomic<index_type> m_top;
+    char m_pad1[BOOST_ACTOR_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+
+    // written by the owner only
+    std::atomic<index_type> m_bottom;
+    std::atomic<buffer*> m_buffer;
+    char m_pad2[BOOST_ACTOR_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)
+                - sizeof(std::atomic<buffer*>)];
+
+    // owns the current as well as all retired buffers
+    std::vector<std::unique_ptr<buffer>> m_buffers;
+
+};
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_WORK_STEALING_DEQUE_HPP
@@ -58,6 +58,12 @@ static constexpr std::uint32_t unhandled_sync_failure = 0x00004;
  */
 static constexpr std::uint32_t unhandled_sync_timeout = 0x00005;
 
+/**
+ * @brief Indicates that a synchronous request was rejected,
+ *        because the mailbox of its receiver was full.
+ */
+static constexpr std::uint32_t mailbox_overflow = 0x00006;
+
 /**
  * @brief Indicates that the actor was forced to shutdown by
  *        a user-generated event.
@@ -129,6 +129,21 @@ class group : detail::comparable<group>
 
 };
 
+/**
+ * @brief Sets the number of subscribers from which on local groups split
+ *        the delivery of a message into jobs for the scheduler's workers.
+ * @note Parallel delivery does not preserve the order of messages sent
+ *       to the same group, hence it is disabled by default, i.e., the
+ *       threshold is 0.
+ */
+void parallel_fan_out_threshold(size_t num_subscribers);
+
+/**
+ * @brief Queries the number of subscribers from which on local groups
+ *        deliver messages in parallel, 0 if disabled.
+ */
+size_t parallel_fan_out_threshold();
+
 } // namespace actor
 } // namespace boost
 
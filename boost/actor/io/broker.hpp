@@ -27,11 +27,13 @@
 #include "boost/actor/io/stream.hpp"
 #include "boost/actor/io/buffer.hpp"
 #include "boost/actor/io/acceptor.hpp"
+#include "boost/actor/io/udp_socket.hpp"
 #include "boost/actor/io/input_stream.hpp"
 #include "boost/actor/io/tcp_acceptor.hpp"
 #include "boost/actor/io/tcp_io_stream.hpp"
 #include "boost/actor/io/output_stream.hpp"
 #include "boost/actor/io/accept_handle.hpp"
+#include "boost/actor/io/datagram_handle.hpp"
 #include "boost/actor/io/connection_handle.hpp"
 
 #include "boost/actor/mixin/behavior_stack_based.hpp"
@@ -65,11 +67,13 @@ class broker : public extend<local_actor>::
     class scribe;
     class servant;
     class doorman;
+    class courier;
     class continuation;
 
     // ... and some helpers need friendship
     friend class scribe;
     friend class doorman;
+    friend class courier;
     friend class continuation;
 
     friend broker_ptr init_and_launch(broker_ptr);
@@ -110,6 +114,35 @@ class broker : public extend<local_actor>::
      */
     void write(const connection_handle& hdl, buffer&& buf);
 
+    /**
+     * @brief Sends a datagram to @p remote. Datagrams enqueued during the
+     *        same event loop iteration are sent with a single system call
+     *        where the platform supports it.
+     */
+    void write_datagram(const datagram_handle& hdl, const ip_endpoint& remote,
+                        size_t num_bytes, const void* buf);
+
+    /**
+     * @brief Sends a datagram to @p remote.
+     */
+    void write_datagram(const datagram_handle& hdl, const ip_endpoint& remote,
+                        const buffer& buf);
+
+    /**
+     * @brief Sends a datagram to @p remote.
+     */
+    void write_datagram(const datagram_handle& hdl, const ip_endpoint& remote,
+                        buffer&& buf);
+
+    /**
+     * @brief Sets the maximum size of datagrams received on @p hdl.
+     *        Larger datagrams are dropped.
+     * @note The default size is 65535 bytes. The middleman reserves
+     *       @p num_bytes for each of the up to 64 datagrams it receives
+     *       per system call.
+     */
+    void max_datagram_size(const datagram_handle& hdl, size_t num_bytes);
+
     /** @cond PRIVATE */
 
     template<typename F, typename... Ts>
@@ -145,6 +178,22 @@ class broker : public extend<local_actor>::
         return add_acceptor(tcp_acceptor::from_sockfd(tcp_sockfd));
     }
 
+    /**
+     * @brief Adds a UDP endpoint to this broker, i.e., each datagram
+     *        received on @p ptr causes a {@link new_datagram_msg}.
+     */
+    datagram_handle add_udp_endpoint(udp_socket_uptr ptr);
+
+    /**
+     * @brief Adds a UDP endpoint bound to @p port on @p addr, or on
+     *        @p INADDR_ANY if @p addr is @p nullptr.
+     * @throws bind_failure if @p port is in use.
+     */
+    inline datagram_handle add_udp_endpoint(std::uint16_t port,
+                                            const char* addr = nullptr) {
+        return add_udp_endpoint(udp_socket::create(port, addr));
+    }
+
     void enqueue(msg_hdr_cref, message, execution_unit*) override;
 
     template<typename F>
@@ -173,6 +222,8 @@ class broker : public extend<local_actor>::
 
     typedef std::unique_ptr<broker::doorman> doorman_pointer;
 
+    typedef std::unique_ptr<broker::courier> courier_pointer;
+
     bool initialized() const;
 
     /** @endcond */
@@ -199,8 +250,11 @@ class broker : public extend<local_actor>::
 
     void erase_acceptor(int id);
 
+    void erase_udp(int id);
+
     std::map<accept_handle, doorman_pointer> m_accept;
     std::map<connection_handle, scribe_pointer> m_io;
+    std::map<datagram_handle, courier_pointer> m_udp;
 
     policy::not_prioritizing  m_priority_policy;
     policy::sequential_invoke m_invoke_policy;
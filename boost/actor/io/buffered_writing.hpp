@@ -24,6 +24,7 @@
 #include "boost/actor/io/buffer.hpp"
 #include "boost/actor/io/middleman.hpp"
 #include "boost/actor/io/continuable.hpp"
+#include "boost/actor/io/output_queue.hpp"
 #include "boost/actor/io/output_stream.hpp"
 
 namespace boost {
@@ -46,23 +47,27 @@ class buffered_writing : public Base {
         BOOST_ACTOR_LOG_TRACE("");
         BOOST_ACTOR_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
         while (m_has_unwritten_data) {
-            size_t written;
-            try { written = m_out->write_some(m_buf.data(), m_buf.size()); }
+            bool flushed;
+            try { flushed = m_queue.flush(m_out.get()); }
             catch (std::exception& e) {
                 BOOST_ACTOR_LOG_ERROR(to_verbose_string(e));
                 static_cast<void>(e); // keep compiler happy
                 return continue_writing_result::failure;
             }
-            if (written != m_buf.size()) {
-                BOOST_ACTOR_LOG_DEBUG("tried to write " << m_buf.size() << "bytes, "
-                               << "only " << written << " bytes written");
-                m_buf.erase_leading(written);
-                return continue_writing_result::continue_later;
-            }
-            else {
-                m_buf.clear();
+            if (m_queue.empty()) {
+                if (m_next_out) {
+                    BOOST_ACTOR_LOG_DEBUG("switch output stream");
+                    m_out.swap(m_next_out);
+                    m_next_out.reset();
+                    std::swap(m_queue, m_next_queue);
+                    if (!m_queue.empty()) continue;
+                }
                 m_has_unwritten_data = false;
-                BOOST_ACTOR_LOG_DEBUG("write done, " << written << " bytes written");
+                BOOST_ACTOR_LOG_DEBUG("write done");
+            }
+            else if (!flushed) {
+                BOOST_ACTOR_LOG_DEBUG("partial write, try again later");
+                return continue_writing_result::continue_later;
             }
         }
         return continue_writing_result::done;
@@ -73,7 +78,7 @@ class buffered_writing : public Base {
     }
 
     void write(size_t num_bytes, const void* data) {
-        m_buf.write(num_bytes, data);
+        next_queue().write(num_bytes, data);
         register_for_writing();
     }
 
@@ -81,12 +86,13 @@ class buffered_writing : public Base {
         write(buf.size(), buf.data());
     }
 
+    /**
+     * @brief Enqueues @p buf without copying its content
+     *        unless it is small enough to be coalesced.
+     */
     void write(buffer&& buf) {
-        if (m_buf.empty()) m_buf = std::move(buf);
-        else {
-            m_buf.write(buf.size(), buf.data());
-            buf.clear();
-        }
+        next_queue().write(std::move(buf));
+        buf.clear();
         register_for_writing();
     }
 
@@ -94,12 +100,37 @@ class buffered_writing : public Base {
         if (!m_has_unwritten_data) {
             BOOST_ACTOR_LOG_DEBUG("register for writing");
             m_has_unwritten_data = true;
-            m_parent->continue_writer(this);
+            // write directly at the end of the current event loop
+            // iteration instead of waiting for a write event
+            m_parent->flush_later(this);
         }
     }
 
+    /**
+     * @brief Returns a buffer for serializing data in place. Bytes
+     *        appended to it are written after all previously enqueued
+     *        data once {@link register_for_writing()} was called.
+     */
     inline buffer& write_buffer() {
-        return m_buf;
+        return next_queue().next_chunk();
+    }
+
+    /**
+     * @brief Writes all data enqueued so far to the current output
+     *        stream and all data enqueued afterwards to @p next.
+     */
+    void switch_output(output_stream_ptr next) {
+        if (m_queue.empty()) m_out = std::move(next);
+        else m_next_out = std::move(next);
+    }
+
+    /**
+     * @brief Checks whether the previous call to {@link switch_output()}
+     *        did not take effect yet, i.e., whether data for the
+     *        current output stream is still pending.
+     */
+    inline bool switching_output() const {
+        return m_next_out != nullptr;
     }
 
  protected:
@@ -112,10 +143,17 @@ class buffered_writing : public Base {
 
  private:
 
+    // receives data enqueued after a call to switch_output()
+    inline output_queue& next_queue() {
+        return m_next_out ? m_next_queue : m_queue;
+    }
+
     middleman* m_parent;
     output_stream_ptr m_out;
     bool m_has_unwritten_data;
-    buffer m_buf;
+    output_queue m_queue;
+    output_stream_ptr m_next_out;
+    output_queue m_next_queue;
 
 };
 
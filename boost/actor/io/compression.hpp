@@ -0,0 +1,156 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_COMPRESSION_HPP
+#define BOOST_ACTOR_IO_COMPRESSION_HPP
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace boost {
+namespace actor {
+namespace io {
+
+/**
+ * @brief Compression algorithms for messages sent to remote nodes.
+ *        The values are used as bitmask to announce supported
+ *        algorithms to remote nodes.
+ */
+enum class compression : std::uint32_t {
+    none = 0x00,
+    lz4  = 0x01,
+    zlib = 0x02
+};
+
+/**
+ * @brief Returns a bitmask of all algorithms available in this build.
+ */
+std::uint32_t available_compressions();
+
+/**
+ * @brief Sets the algorithm used to compress messages to remote nodes.
+ *        Compression is used on a connection only if the remote node
+ *        announced to support @p algorithm. Other peers, including
+ *        nodes using older versions, receive uncompressed messages.
+ *
+ * Nodes announce their algorithms in a control message right after the
+ * handshake rather than in the handshake itself, because the handshake
+ * has a fixed layout that older versions cannot extend. Messages sent
+ * before the announcement arrived remain uncompressed.
+ * @throws std::invalid_argument if @p algorithm is not available
+ * @note Compression is disabled by default.
+ */
+void compression_algorithm(compression algorithm);
+
+/**
+ * @brief Returns the algorithm used to compress messages to remote nodes.
+ */
+compression compression_algorithm();
+
+/**
+ * @brief Sets the minimum size in bytes of a serialized message
+ *        in order to be compressed.
+ * @note The default threshold is 512 bytes.
+ */
+void compression_threshold(size_t num_bytes);
+
+/**
+ * @brief Returns the minimum size in bytes of a serialized message
+ *        in order to be compressed.
+ */
+size_t compression_threshold();
+
+/**
+ * @brief Describes a single compression or decompression.
+ */
+struct compression_event {
+
+    /**
+     * @brief The used algorithm.
+     */
+    compression algorithm;
+
+    /**
+     * @brief Denotes whether the event was a decompression.
+     */
+    bool decompressed;
+
+    /**
+     * @brief Size of the serialized message.
+     */
+    size_t original_size;
+
+    /**
+     * @brief Size of the message after compression.
+     */
+    size_t compressed_size;
+
+    /**
+     * @brief Time spent in the compression library.
+     */
+    std::chrono::nanoseconds cpu_time;
+
+    /**
+     * @brief Returns <tt>original_size / compressed_size</tt>.
+     */
+    inline double ratio() const {
+        return compressed_size == 0
+               ? 0.
+               : static_cast<double>(original_size) / compressed_size;
+    }
+
+};
+
+/**
+ * @brief Instrumentation hook invoked by the middleman
+ *        for each compressed or decompressed message.
+ */
+typedef std::function<void (const compression_event&)> compression_hook;
+
+/**
+ * @brief Sets the instrumentation hook for compression events.
+ *        Passing an empty function removes the hook.
+ * @note The hook is called concurrently from the threads running the
+ *       middleman. A replaced hook might still run in one of them.
+ */
+void set_compression_hook(compression_hook hook);
+
+/**
+ * @brief Stores the compressed representation of the
+ *        @p num_bytes bytes at @p data in @p storage.
+ * @returns @p false if @p algorithm is not available or failed
+ *          to produce output smaller than @p num_bytes.
+ */
+bool compress(compression algorithm, const void* data, size_t num_bytes,
+              std::vector<char>& storage);
+
+/**
+ * @brief Decompresses @p num_bytes at @p data to @p storage, which must
+ *        be able to hold exactly @p original_size bytes.
+ * @returns @p false if @p data is invalid.
+ */
+bool decompress(compression algorithm, const void* data, size_t num_bytes,
+                void* storage, size_t original_size);
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_COMPRESSION_HPP
@@ -52,6 +52,8 @@ enum class continue_writing_result {
  */
 class continuable {
 
+    friend class middleman_event_handler;
+
     continuable(const continuable&) = delete;
     continuable& operator=(const continuable&) = delete;
 
@@ -79,6 +81,12 @@ class continuable {
      */
     inline native_socket_type write_handle() const;
 
+    /**
+     * @brief Returns whether {@link write_handle()} becomes readable rather
+     *        than writable once this instance is able to continue writing.
+     */
+    inline bool write_via_doorbell() const;
+
     /**
      * @brief Reads from {@link read_handle()} if valid.
      */
@@ -106,6 +114,7 @@ class continuable {
 
     native_socket_type m_rd;
     native_socket_type m_wr;
+    bool m_doorbell;
 
 };
 
@@ -124,6 +133,10 @@ inline native_socket_type continuable::write_handle() const {
     return m_wr;
 }
 
+inline bool continuable::write_via_doorbell() const {
+    return m_doorbell;
+}
+
 } // namespace io
 } // namespace actor
 } // namespace boost
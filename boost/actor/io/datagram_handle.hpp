@@ -0,0 +1,53 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_DATAGRAM_HANDLE_HPP
+#define BOOST_ACTOR_IO_DATAGRAM_HANDLE_HPP
+
+#include "boost/actor/detail/handle.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+class broker;
+
+/**
+ * @brief Identifies a UDP endpoint of a {@link broker}.
+ */
+class datagram_handle : public detail::handle<datagram_handle> {
+
+    friend class detail::handle<datagram_handle>;
+
+    typedef detail::handle<datagram_handle> super;
+
+ public:
+
+    datagram_handle() = default;
+
+ private:
+
+    inline datagram_handle(int handle_id) : super{handle_id} { }
+
+};
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_DATAGRAM_HANDLE_HPP
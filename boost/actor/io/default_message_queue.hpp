@@ -19,7 +19,9 @@
 #ifndef BOOST_ACTOR_MESSAGE_QUEUE_HPP
 #define BOOST_ACTOR_MESSAGE_QUEUE_HPP
 
-#include <vector>
+#include <array>
+#include <deque>
+#include <cstdint>
 
 #include "boost/actor/message.hpp"
 #include "boost/actor/ref_counted.hpp"
@@ -29,6 +31,30 @@ namespace boost {
 namespace actor {
 namespace io {
 
+/**
+ * @brief Denotes the priority lanes multiplexed on a single connection.
+ */
+enum class message_lane : std::uint8_t {
+    // high priority messages and responses to synchronous requests
+    high,
+    // all other messages
+    normal
+};
+
+constexpr size_t num_message_lanes = 2;
+
+/**
+ * @brief Returns the lane used to send a message with header @p hdr.
+ */
+inline message_lane lane_of(msg_hdr_cref hdr) {
+    return (hdr.id.is_high_priority() || hdr.id.is_response())
+           ? message_lane::high
+           : message_lane::normal;
+}
+
+/**
+ * @brief Buffers messages for a remote node in one FIFO queue per lane.
+ */
 class default_message_queue : public ref_counted {
 
  public:
@@ -39,22 +65,42 @@ class default_message_queue : public ref_counted {
 
     ~default_message_queue();
 
-    template<typename... Ts>
-    void emplace(Ts&&... args) {
-        m_impl.emplace_back(std::forward<Ts>(args)...);
+    void emplace(msg_hdr_cref hdr, message msg) {
+        lane(lane_of(hdr)).emplace_back(hdr, std::move(msg));
     }
 
-    inline bool empty() const { return m_impl.empty(); }
+    inline bool empty() const {
+        for (auto& q : m_lanes) {
+            if (!q.empty()) return false;
+        }
+        return true;
+    }
 
+    inline bool empty(message_lane l) const {
+        return m_lanes[static_cast<size_t>(l)].empty();
+    }
+
+    /**
+     * @brief Removes the oldest message of the highest priority lane.
+     */
     inline value_type pop() {
-        value_type result(std::move(m_impl.front()));
-        m_impl.erase(m_impl.begin());
-        return result;
+        for (auto& q : m_lanes) {
+            if (!q.empty()) {
+                value_type result(std::move(q.front()));
+                q.pop_front();
+                return result;
+            }
+        }
+        return {};
     }
 
  private:
 
-    std::vector<value_type> m_impl;
+    inline std::deque<value_type>& lane(message_lane l) {
+        return m_lanes[static_cast<size_t>(l)];
+    }
+
+    std::array<std::deque<value_type>, num_message_lanes> m_lanes;
 
 };
 
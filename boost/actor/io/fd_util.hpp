@@ -50,6 +50,10 @@ void handle_write_result(ssize_t result, bool is_nonblocking_io);
 // reads @p result and @p errno and throws @p ios_base::failure on error
 void handle_read_result(ssize_t result, bool is_nonblocking_io);
 
+// returns the pending error of @p fd, e.g., the result of a
+// nonblocking connect(), or 0 if there is none
+int socket_error(native_socket_type fd);
+
 std::pair<native_socket_type, native_socket_type> create_pipe();
 
 } // namespace fd_util
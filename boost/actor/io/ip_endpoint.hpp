@@ -0,0 +1,101 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_IP_ENDPOINT_HPP
+#define BOOST_ACTOR_IO_IP_ENDPOINT_HPP
+
+#include <array>
+#include <string>
+#include <cstdint>
+
+#include "boost/actor/detail/comparable.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+/**
+ * @brief An IPv4 or IPv6 address along with a port,
+ *        e.g., the sender of a datagram.
+ */
+class ip_endpoint : detail::comparable<ip_endpoint> {
+
+ public:
+
+    /**
+     * @brief Creates the IPv4 endpoint <tt>0.0.0.0:0</tt>.
+     */
+    ip_endpoint();
+
+    /**
+     * @brief Creates an endpoint from the numeric address @p host,
+     *        e.g., <tt>"127.0.0.1"</tt> or <tt>"::1"</tt>.
+     * @throws network_error if @p host is not a valid IP address.
+     */
+    ip_endpoint(const std::string& host, std::uint16_t port);
+
+    /**
+     * @brief Returns the numeric address of this endpoint.
+     */
+    std::string host() const;
+
+    /**
+     * @brief Returns the port of this endpoint.
+     */
+    inline std::uint16_t port() const;
+
+    /**
+     * @brief Checks whether this endpoint has an IPv4 address.
+     */
+    bool is_v4() const;
+
+    int compare(const ip_endpoint& other) const;
+
+    /** @cond PRIVATE */
+
+    // creates an endpoint from a sockaddr_in or sockaddr_in6
+    static ip_endpoint from_sockaddr(const void* addr);
+
+    // stores this endpoint as sockaddr_in if @p family is AF_INET or as
+    // sockaddr_in6 otherwise and returns the number of bytes written,
+    // or 0 if this endpoint has no address of given family
+    size_t to_sockaddr(void* storage, int family) const;
+
+    /** @endcond */
+
+ private:
+
+    // IPv4 addresses are stored as IPv4-mapped IPv6 addresses
+    std::array<std::uint8_t, 16> m_addr;
+    std::uint16_t m_port;
+
+};
+
+/******************************************************************************
+ *             inline and template member function implementations            *
+ ******************************************************************************/
+
+inline std::uint16_t ip_endpoint::port() const {
+    return m_port;
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_IP_ENDPOINT_HPP
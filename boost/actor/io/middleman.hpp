@@ -55,9 +55,15 @@ typedef intrusive_ptr<input_stream> input_stream_ptr;
 typedef intrusive_ptr<output_stream> output_stream_ptr;
 
 /**
- * @brief Multiplexes asynchronous IO.
+ * @brief Multiplexes asynchronous IO using one or more event loops.
+ *
+ * Each event loop runs in its own thread. Peers are sharded across
+ * the event loops by their node ID, brokers run in the first event loop.
+ * Member functions that are not thread-safe operate on the event loop of
+ * the calling thread.
  * @note No member function except for @p run_later is safe to call from
- *       outside the event loop.
+ *       outside an event loop.
+ * @see scheduler::configuration::num_middleman_loops
  */
 class middleman {
 
@@ -68,11 +74,25 @@ class middleman {
     virtual ~middleman();
 
     /**
-     * @brief Runs @p fun in the event loop of the middleman.
+     * @brief Runs @p fun in the first event loop of the middleman.
      * @note This member function is thread-safe.
      */
     virtual void run_later(std::function<void()> fun) = 0;
 
+    /**
+     * @brief Runs @p fun in the event loop responsible for @p node.
+     * @note This member function is thread-safe.
+     */
+    virtual void run_later(const node_id& node, std::function<void()> fun) = 0;
+
+    /**
+     * @brief Runs @p fun in one of the resolver threads of the middleman,
+     *        which perform blocking name lookups outside of the event loops.
+     * @note This member function is thread-safe.
+     * @see scheduler::configuration::num_resolver_threads
+     */
+    virtual void run_blocking(std::function<void()> fun) = 0;
+
     /**
      * @brief Removes @p ptr from the list of active writers.
      */
@@ -83,6 +103,21 @@ class middleman {
      */
     void continue_writer(continuable* ptr);
 
+    /**
+     * @brief Lets @p ptr write its pending data at the end of the current
+     *        iteration of the event loop. @p ptr becomes an active writer
+     *        only if the OS does not accept all of its data at once.
+     * @warning This member function is not thread-safe.
+     */
+    void flush_later(continuable* ptr);
+
+    /**
+     * @brief Lets the write handle of @p ptr signal write events by
+     *        becoming readable, as required by {@link shm_io_stream}.
+     * @warning This member function is not thread-safe.
+     */
+    void use_doorbell(continuable* ptr);
+
     /**
      * @brief Checks wheter @p ptr is an active writer.
      * @warning This member function is not thread-safe.
@@ -133,6 +168,7 @@ class middleman {
 
     /**
      * @brief Delivers a message to given node.
+     * @note Must be called from the event loop responsible for @p node.
      */
     virtual void deliver(const node_id& node,
                          msg_hdr_cref hdr,
@@ -153,7 +189,7 @@ class middleman {
 
     /**
      * @brief Adds a new acceptor for incoming connections to @p pa
-     *        to the event loop of the middleman.
+     *        to one of the event loops of the middleman.
      * @note This member function is thread-safe.
      */
     virtual void register_acceptor(const actor_addr& pa,
@@ -184,14 +220,15 @@ class middleman {
     // initializes a singleton
     virtual void initialize() = 0;
 
+    // returns the event handler of the calling event loop
+    virtual middleman_event_handler& handler() = 0;
+
     // each middleman defines its own namespace
     actor_namespace m_namespace;
 
     // the node id of this middleman
     node_id_ptr m_node;
 
-    std::unique_ptr<middleman_event_handler> m_handler;
-
 };
 
 inline actor_namespace& middleman::get_namespace() {
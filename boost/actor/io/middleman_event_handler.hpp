@@ -22,6 +22,12 @@
 #include <vector>
 #include <utility>
 
+#include "boost/config.hpp"
+
+#ifdef BOOST_WINDOWS
+#   include <unordered_map>
+#endif
+
 #include "boost/actor/io/event.hpp"
 #include "boost/actor/io/platform.hpp"
 #include "boost/actor/io/continuable.hpp"
@@ -58,13 +64,33 @@ class middleman_event_handler {
      */
     void erase_later(continuable* ptr, event_bitmask e);
 
+    /**
+     * @brief Lets @p ptr write its pending data during the next
+     *        {@link update}. @p ptr gets registered for write events
+     *        only if the OS did not accept all of its data.
+     */
+    void flush_later(continuable* ptr);
+
+    /**
+     * @brief Lets the write handle of @p ptr signal write events by
+     *        becoming readable, e.g., because it is the doorbell of a
+     *        shared memory connection.
+     * @pre <tt>ptr->read_handle() == ptr->write_handle()</tt>
+     */
+    void use_doorbell(continuable* ptr);
+
     /**
      * @brief Poll all events.
      */
     template<typename F>
     void poll(const F& fun) {
         poll_impl();
-        for (auto& p : m_events) fun(p.first, p.second);
+        for (auto& p : m_events) {
+            if (p.second->write_via_doorbell()) {
+                p.first = doorbell_event(p.first, p.second);
+            }
+            fun(p.first, p.second);
+        }
         m_events.clear();
         update();
     }
@@ -75,12 +101,25 @@ class middleman_event_handler {
 
     inline size_t num_sockets() const { return m_meta.size(); }
 
+    /**
+     * @brief Enables edge-triggered readiness notification if supported
+     *        by the implementation. In this mode, each continuable has
+     *        to read or write until the OS would block.
+     */
+    inline void edge_triggered(bool value) { m_edge_triggered = value; }
+
+    /**
+     * @brief Returns whether edge-triggered readiness notification
+     *        has been enabled.
+     */
+    inline bool edge_triggered() const { return m_edge_triggered; }
+
     // implemented in platform-dependent .cpp file
     static std::unique_ptr<middleman_event_handler> create();
 
     /**
-     * @brief Performs all actions enqueued by {@link add_later}
-     *        or {@link erase_later}.
+     * @brief Performs all actions enqueued by {@link add_later},
+     *        {@link erase_later}, or {@link flush_later}.
      */
     void update();
 
@@ -95,7 +134,7 @@ class middleman_event_handler {
 
  protected:
 
-    std::vector<fd_meta_info> m_meta; // this vector is *always* sorted
+    std::vector<fd_meta_info> m_meta; // in no particular order
 
     std::vector<std::pair<fd_meta_info, fd_meta_event>> m_alterations;
 
@@ -103,11 +142,27 @@ class middleman_event_handler {
 
     std::vector<continuable*> m_dispose_list;
 
+    std::vector<continuable*> m_flush_list;
+
+    // fds changed by the current update, stores the previous bitmask
+    std::vector<fd_meta_info> m_changes;
+
+    bool m_edge_triggered;
+
     middleman_event_handler();
 
     // fills the event vector
     virtual void poll_impl() = 0;
 
+    // returns the events the OS has to watch for if ptr is
+    // interested in mask, i.e., translates writes to doorbell reads
+    static inline event_bitmask os_bitmask(continuable* ptr,
+                                           event_bitmask mask) {
+        return (ptr->write_via_doorbell() && mask != event::none)
+               ? event::read
+               : mask;
+    }
+
     virtual void handle_event(fd_meta_event me,
                               native_socket_type fd,
                               event_bitmask old_bitmask,
@@ -118,8 +173,32 @@ class middleman_event_handler {
 
     void alteration(continuable* ptr, event_bitmask e, fd_meta_event etype);
 
+    void flush_writers();
+
+    void apply_alterations();
+
+    // translates a read event on a doorbell to the events ptr waits for
+    event_bitmask doorbell_event(event_bitmask e, continuable* ptr) const;
+
     event_bitmask next_bitmask(event_bitmask old, event_bitmask arg, fd_meta_event op) const;
 
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // returns the position of fd in m_meta or npos
+    size_t index_of(native_socket_type fd) const;
+
+    void set_index(native_socket_type fd, size_t pos);
+
+    // removes m_meta[pos] by moving the last element to pos
+    void erase_meta(size_t pos);
+
+    // maps file descriptors to their position in m_meta
+#   ifdef BOOST_WINDOWS
+    std::unordered_map<native_socket_type, size_t> m_index;
+#   else
+    std::vector<size_t> m_index; // indexed by fd
+#   endif
+
 };
 
 } // namespace io
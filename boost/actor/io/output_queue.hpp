@@ -0,0 +1,120 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_OUTPUT_QUEUE_HPP
+#define BOOST_ACTOR_IO_OUTPUT_QUEUE_HPP
+
+#include <deque>
+#include <cstddef>
+
+#include "boost/actor/io/buffer.hpp"
+#include "boost/actor/io/output_stream.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+/**
+ * @brief Sets the number of bytes up to which consecutive small writes
+ *        to a connection are coalesced into a single chunk.
+ * @note The default threshold is 16KB.
+ */
+void coalescing_threshold(size_t num_bytes);
+
+/**
+ * @brief Queries the number of bytes up to which consecutive small
+ *        writes to a connection are coalesced into a single chunk.
+ */
+size_t coalescing_threshold();
+
+/**
+ * @brief A scatter/gather queue of chunks waiting to be written
+ *        to an output stream.
+ *
+ * Small writes are appended to the last chunk as long as it holds fewer
+ * bytes than {@link coalescing_threshold()}, larger buffers are moved into
+ * the queue without copying them. All chunks are flushed using a single
+ * gather write per call to {@link flush()}.
+ */
+class output_queue {
+
+ public:
+
+    output_queue() = default;
+
+    output_queue(output_queue&&) = default;
+
+    output_queue& operator=(output_queue&&) = default;
+
+    /**
+     * @brief Appends @p num_bytes bytes from @p data to the queue.
+     */
+    void write(size_t num_bytes, const void* data);
+
+    /**
+     * @brief Appends the content of @p buf to the queue, taking ownership
+     *        of its memory unless it is small enough to be coalesced.
+     */
+    void write(buffer&& buf);
+
+    /**
+     * @brief Returns a chunk for serializing data in place.
+     *        Bytes appended to the chunk are written after
+     *        all previously enqueued bytes.
+     * @note The reference remains valid until the next call to
+     *       {@link flush()}.
+     */
+    buffer& next_chunk();
+
+    /**
+     * @brief Writes as many enqueued bytes as possible to @p out.
+     * @returns @p false if @p out did not accept all bytes, i.e., if the
+     *          caller should wait until @p out becomes writable again.
+     * @throws std::ios_base::failure
+     */
+    bool flush(output_stream* out);
+
+    /**
+     * @brief Checks whether there are no bytes left to write.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Discards all enqueued bytes.
+     */
+    void clear();
+
+ private:
+
+    buffer& push_chunk();
+
+    std::deque<buffer> m_chunks;
+
+    // number of bytes of the first chunk that have already been written
+    size_t m_offset = 0;
+
+    // a previously flushed chunk that is reused to avoid allocations
+    buffer m_spare;
+
+};
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_OUTPUT_QUEUE_HPP
@@ -19,6 +19,8 @@
 #ifndef BOOST_ACTOR_OUTPUT_STREAM_HPP
 #define BOOST_ACTOR_OUTPUT_STREAM_HPP
 
+#include <cstddef>
+
 #include "boost/intrusive_ptr.hpp"
 
 #include "boost/actor/ref_counted.hpp"
@@ -29,6 +31,17 @@ namespace boost {
 namespace actor {
 namespace io {
 
+/**
+ * @brief Describes a contiguous block of memory for gather writes.
+ */
+struct const_buffer {
+
+    const void* data;
+
+    size_t size;
+
+};
+
 /**
  * @brief An abstract output stream interface.
  */
@@ -59,6 +72,16 @@ class output_stream : public virtual ref_counted {
      */
     virtual size_t write_some(const void* buf, size_t num_bytes) = 0;
 
+    /**
+     * @brief Tries to write the content of @p num_bufs buffers from @p bufs
+     *        in order, using a single system call if supported.
+     * @returns The number of written bytes.
+     * @throws std::ios_base::failure
+     * @note The default implementation calls @p write_some for each buffer
+     *       until a buffer could not be written completely.
+     */
+    virtual size_t write_some(const const_buffer* bufs, size_t num_bufs);
+
 };
 
 /**
@@ -20,17 +20,23 @@
 #define BOOST_ACTOR_peer_IMPL_HPP
 
 #include <map>
+#include <array>
+#include <vector>
 #include <cstdint>
 
 #include "boost/actor/extend.hpp"
 #include "boost/actor/node_id.hpp"
 #include "boost/actor/actor_proxy.hpp"
+#include "boost/actor/wire_format.hpp"
 #include "boost/actor/message_handler.hpp"
 #include "boost/actor/type_lookup_table.hpp"
 
 #include "boost/actor/io/buffer.hpp"
+#include "boost/actor/io/compression.hpp"
+#include "boost/actor/io/shm_io_stream.hpp"
 #include "boost/actor/io/input_stream.hpp"
 #include "boost/actor/io/output_stream.hpp"
+#include "boost/actor/io/receive_buffer.hpp"
 #include "boost/actor/io/buffered_writing.hpp"
 #include "boost/actor/io/default_message_queue.hpp"
 
@@ -40,6 +46,21 @@ namespace io {
 
 class middleman_impl;
 
+/**
+ * @brief Sets the maximum number of bytes per fragment of a message
+ *        sent to a remote node. Larger messages are split into fragments,
+ *        which allows high priority messages to overtake them on the wire.
+ *        A value of 0 disables fragmentation.
+ * @note The default fragment size is 16KB.
+ */
+void fragment_size(size_t num_bytes);
+
+/**
+ * @brief Queries the maximum number of bytes per fragment of a message
+ *        sent to a remote node.
+ */
+size_t fragment_size();
+
 class peer : public extend<continuable>::with<buffered_writing> {
 
     typedef combined_type super;
@@ -76,10 +97,8 @@ class peer : public extend<continuable>::with<buffered_writing> {
     enum read_state {
         // connection just established; waiting for process information
         wait_for_process_info,
-        // wait for the size of the next message
-        wait_for_msg_size,
-        // currently reading a message
-        read_message
+        // connection established; reading size-prefixed messages
+        read_messages
     };
 
     input_stream_ptr m_in;
@@ -89,7 +108,7 @@ class peer : public extend<continuable>::with<buffered_writing> {
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
 
-    buffer m_rd_buf;
+    receive_buffer m_rd_buf;
     buffer m_wr_buf;
 
     default_message_queue_ptr m_queue;
@@ -107,11 +126,61 @@ class peer : public extend<continuable>::with<buffered_writing> {
     // point to the published actor of the remote node
     bool m_stop_on_last_proxy_exited;
 
+    // handles system messages such as MONITOR or KILL_PROXY, built once
+    // per peer to dispatch on the leading atom of incoming messages
     message_handler m_content_handler;
 
+    // header of the message currently processed by m_content_handler
+    const message_header* m_current_hdr;
+
     type_lookup_table m_incoming_types;
     type_lookup_table m_outgoing_types;
 
+    // node IDs already sent/received using wire format v2
+    node_id_table m_incoming_nodes;
+    node_id_table m_outgoing_nodes;
+
+    // set to v2 once the remote node announced it is able to read it
+    wire_format m_outgoing_format;
+
+    // set once the remote node announced it is able to decompress
+    // the algorithm selected by compression_algorithm()
+    compression m_outgoing_compression;
+
+    std::vector<char> m_compress_buf;
+    std::vector<char> m_decompress_buf;
+
+    struct lane_state {
+        // frames waiting to be sent in fragments
+        std::vector<char> pending;
+        // number of bytes of pending already written
+        size_t written = 0;
+        // fragments received so far
+        std::vector<char> received;
+    };
+
+    std::array<lane_state, num_message_lanes> m_lanes;
+
+    // set once the remote node announced it is able to reassemble fragments
+    bool m_outgoing_fragments;
+
+    // the stream used for the handshake, which becomes the doorbell
+    // of m_shm if the remote node runs on the same host
+    stream_ptr m_doorbell;
+
+    // shared memory connection, either offered to or by the remote node
+    shm_io_stream_ptr m_shm;
+
+    // set after reading SHM_SWITCH, i.e., the remaining bytes of
+    // m_rd_buf are doorbell rings and m_shm provides all further data
+    bool m_shm_input_pending;
+
+    // set once this peer sent SHM_SWITCH to the remote node
+    bool m_shm_output;
+
+    // set once all data for the old output stream has been written
+    bool m_shm_armed;
+
     void monitor(const actor_addr& sender, const node_id_ptr& node, actor_id aid);
 
     void kill_proxy(const actor_addr& sender, const node_id_ptr& node, actor_id aid, std::uint32_t reason);
@@ -122,13 +191,43 @@ class peer : public extend<continuable>::with<buffered_writing> {
 
     void deliver(msg_hdr_cref hdr, message msg);
 
+    bool handle_frame(std::uint32_t prefix, const char* data, size_t size);
+
+    bool handle_fragment(const char* data, size_t size);
+
+    bool handle_message(wire_format fmt, const char* data, size_t size);
+
+    void init_content_handler();
+
+    // returns the decompressed message and updates size accordingly
+    // or returns nullptr if data is not a valid compressed message
+    const char* decompressed(const char* data, size_t& size);
+
     inline void enqueue(const message& msg) {
         enqueue({invalid_actor_addr, nullptr}, msg);
     }
 
     void enqueue_impl(msg_hdr_cref hdr, const message& msg);
 
-    void add_type_if_needed(const std::string& tname);
+    // writes msg immediately, i.e., msg cannot be overtaken
+    // by other messages and is never split into fragments
+    void write_control_message(const message& msg);
+
+    // maps the shared memory segment offered by the remote node
+    void open_shm(const std::string& name);
+
+    // writes SHM_SWITCH and sends all following data via m_shm
+    void switch_to_shm_output();
+
+    // serializes msg as a single frame into wbuf
+    bool write_frame(buffer& wbuf, msg_hdr_cref hdr,
+                     const message& msg, wire_format fmt);
+
+    // writes the next fragment or queued message to the write buffer,
+    // returns false if there is nothing left to write
+    bool write_next();
+
+    void add_type_if_needed(const message& msg);
 
 };
 
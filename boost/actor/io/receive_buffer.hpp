@@ -0,0 +1,110 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_RECEIVE_BUFFER_HPP
+#define BOOST_ACTOR_IO_RECEIVE_BUFFER_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "boost/actor/io/input_stream.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+/**
+ * @brief Sets the number of bytes a connection tries
+ *        to read from its socket per system call.
+ * @note The default chunk size is 64KB, @p 0 is treated as 1.
+ */
+void receive_chunk_size(size_t num_bytes);
+
+/**
+ * @brief Queries the number of bytes a connection tries
+ *        to read from its socket per system call.
+ */
+size_t receive_chunk_size();
+
+/**
+ * @brief A receive buffer that reads large chunks from an input stream
+ *        and allows parsing any number of complete frames in place.
+ *
+ * This is a linear buffer, i.e., a frame is always stored in a single
+ * contiguous memory region. Unconsumed bytes are moved to the front of
+ * the buffer when the free space at its tail is exhausted.
+ */
+class receive_buffer {
+
+ public:
+
+    receive_buffer();
+
+    /**
+     * @brief Reads as many bytes as are available from @p in
+     *        using a single call to {@link input_stream::read_some()}.
+     * @returns @p true if all free space was filled, i.e., if @p in
+     *          might have more data available.
+     * @throws std::ios_base::failure
+     */
+    bool fill(input_stream* in);
+
+    /**
+     * @brief Makes sure the buffer is able to hold a
+     *        contiguous frame of @p num_bytes bytes.
+     */
+    void reserve(size_t num_bytes);
+
+    /**
+     * @brief Marks the first @p num_bytes available bytes as processed.
+     */
+    void consume(size_t num_bytes);
+
+    /**
+     * @brief Returns the number of received, unprocessed bytes.
+     */
+    inline size_t available() const {
+        return m_wr - m_rd;
+    }
+
+    /**
+     * @brief Returns a pointer to the first unprocessed byte.
+     */
+    inline const char* data() const {
+        return m_data.data() + m_rd;
+    }
+
+ private:
+
+    void compact();
+
+    std::vector<char> m_data;
+
+    // position of the first unprocessed byte
+    size_t m_rd;
+
+    // position of the first free byte
+    size_t m_wr;
+
+};
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_RECEIVE_BUFFER_HPP
@@ -0,0 +1,161 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_SHM_IO_STREAM_HPP
+#define BOOST_ACTOR_IO_SHM_IO_STREAM_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "boost/actor/io/stream.hpp"
+#include "boost/actor/io/platform.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+/**
+ * @brief Sets the size of each of the two ring buffers of a shared
+ *        memory connection. Connections to nodes on the same host
+ *        switch to shared memory after the handshake unless the size
+ *        is 0 or the remote node does not support shared memory.
+ * @note The default ring size is 1MB.
+ */
+void shm_ring_size(size_t num_bytes);
+
+/**
+ * @brief Queries the size of each of the two ring buffers
+ *        of a shared memory connection.
+ */
+size_t shm_ring_size();
+
+class shm_io_stream;
+
+/**
+ * @brief A shared memory stream pointer.
+ */
+typedef intrusive_ptr<shm_io_stream> shm_io_stream_ptr;
+
+/**
+ * @brief A stream between two processes on the same host using two
+ *        single-producer, single-consumer ring buffers in shared memory.
+ *
+ * The stream used for the handshake remains open and serves as doorbell:
+ * a single byte wakes up the remote side whenever it waits for data or
+ * for free space. Hence, {@link read_handle()} and {@link write_handle()}
+ * both become readable rather than writable once writing can continue,
+ * and the middleman has to register them via
+ * {@link middleman::use_doorbell()}.
+ */
+class shm_io_stream : public stream {
+
+ public:
+
+    ~shm_io_stream();
+
+    /**
+     * @brief Creates a new shared memory segment with two rings
+     *        of @p ring_size bytes each and maps it.
+     * @throws network_error if shared memory is not available.
+     */
+    static shm_io_stream_ptr create(stream_ptr doorbell, size_t ring_size);
+
+    /**
+     * @brief Maps the segment @p name created by the process @p creator
+     *        via {@link create()} and removes its name from the system.
+     * @throws network_error if @p name does not denote a valid segment
+     *                       of @p creator. The name is removed only
+     *                       after the segment has been validated.
+     */
+    static shm_io_stream_ptr open(stream_ptr doorbell, const std::string& name,
+                                  std::uint32_t creator);
+
+    /**
+     * @brief Checks whether @p name has the form of names generated
+     *        by {@link create()} in the process @p creator.
+     */
+    static bool is_valid_name(const std::string& name, std::uint32_t creator);
+
+    /**
+     * @brief Returns the system-wide name of the shared memory segment.
+     */
+    inline const std::string& name() const {
+        return m_name;
+    }
+
+    /**
+     * @brief Removes the name of the shared memory segment from the system.
+     *        The segment remains valid until both sides unmapped it.
+     */
+    void unlink();
+
+    /**
+     * @brief Allows this stream to wake up a remote writer waiting for
+     *        free space. The owner calls this member function once the
+     *        doorbell is no longer used to transfer regular data.
+     */
+    void arm();
+
+    native_socket_type read_handle() const;
+
+    native_socket_type write_handle() const;
+
+    void read(void* buf, size_t len);
+
+    size_t read_some(void* buf, size_t len);
+
+    void write(const void* buf, size_t len);
+
+    size_t write_some(const void* buf, size_t len);
+
+    size_t write_some(const const_buffer* bufs, size_t num_bufs);
+
+    struct segment;
+
+    struct ring;
+
+ private:
+
+    shm_io_stream(stream_ptr doorbell, std::string name,
+                  segment* seg, size_t seg_size, bool is_creator);
+
+    void ring_doorbell();
+
+    // waits until the doorbell becomes readable
+    void await_doorbell();
+
+    stream_ptr m_doorbell;
+    std::string m_name;
+    segment* m_segment;
+    size_t m_segment_size;
+    size_t m_ring_size;
+    ring* m_in;
+    char* m_in_data;
+    ring* m_out;
+    char* m_out_data;
+    bool m_armed;
+    bool m_deferred_ring;
+
+};
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_SHM_IO_STREAM_HPP
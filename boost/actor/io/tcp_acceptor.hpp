@@ -33,8 +33,23 @@ class tcp_acceptor : public acceptor {
 
  public:
 
+    /**
+     * @brief Creates a listening socket for @p port on @p addr, or on
+     *        @p INADDR_ANY if @p addr is @p nullptr.
+     * @param reuse_port Sets @p SO_REUSEPORT, i.e., allows other sockets
+     *                   with this option to listen on the same port.
+     * @throws bind_failure if @p port is in use.
+     * @throws network_error if @p reuse_port is @p true on
+     *         a platform without @p SO_REUSEPORT.
+     */
     static std::unique_ptr<acceptor> create(std::uint16_t port,
-                                            const char* addr = nullptr);
+                                            const char* addr = nullptr,
+                                            bool reuse_port = false);
+
+    /**
+     * @brief Returns the port this acceptor is listening on.
+     */
+    std::uint16_t port() const;
 
     static std::unique_ptr<acceptor> from_sockfd(native_socket_type fd);
 
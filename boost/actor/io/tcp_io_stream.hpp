@@ -19,21 +19,57 @@
 #ifndef BOOST_ACTOR_tcp_IO_STREAM_HPP
 #define BOOST_ACTOR_tcp_IO_STREAM_HPP
 
+#include <vector>
+#include <cstdint>
+
 #include "boost/actor/io/stream.hpp"
 #include "boost/actor/io/platform.hpp"
 
+#ifndef BOOST_ACTOR_WINDOWS
+#   include <sys/socket.h>
+#endif
+
 namespace boost {
 namespace actor {
 namespace io {
 
+/**
+ * @brief An IPv4 or IPv6 address of a TCP endpoint.
+ */
+struct tcp_endpoint {
+    sockaddr_storage addr;
+    socklen_t length;
+};
+
 class tcp_io_stream : public stream {
 
  public:
 
     ~tcp_io_stream();
 
+    /**
+     * @brief Connects to @p host on @p port, trying each address
+     *        returned by {@link resolve()} in order.
+     * @throws network_error if no connection could be established.
+     */
     static stream_ptr connect_to(const char* host, std::uint16_t port);
 
+    /**
+     * @brief Returns all IPv4 and IPv6 addresses of @p host.
+     * @throws network_error if @p host cannot be resolved.
+     * @note This function blocks the caller.
+     */
+    static std::vector<tcp_endpoint> resolve(const char* host,
+                                             std::uint16_t port);
+
+    /**
+     * @brief Starts connecting to @p ep without blocking the caller.
+     *        The connection is established once the returned stream
+     *        becomes writable and <tt>fd_util::socket_error</tt> returns 0.
+     * @throws network_error if the connection attempt failed immediately.
+     */
+    static stream_ptr connect_nonblocking(const tcp_endpoint& ep);
+
     static stream_ptr from_native_socket(native_socket_type fd);
 
     native_socket_type read_handle() const;
@@ -48,6 +84,8 @@ class tcp_io_stream : public stream {
 
     size_t write_some(const void* buf, size_t len);
 
+    size_t write_some(const const_buffer* bufs, size_t num_bufs);
+
     static stream_ptr from_sockfd(native_socket_type fd);
 
  private:
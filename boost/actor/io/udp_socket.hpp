@@ -0,0 +1,183 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_IO_UDP_SOCKET_HPP
+#define BOOST_ACTOR_IO_UDP_SOCKET_HPP
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "boost/actor/io/buffer.hpp"
+#include "boost/actor/io/platform.hpp"
+#include "boost/actor/io/ip_endpoint.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+class udp_socket;
+
+typedef std::unique_ptr<udp_socket> udp_socket_uptr;
+
+/**
+ * @brief A nonblocking UDP socket receiving and sending datagrams in
+ *        batches, i.e., using a single system call for up to
+ *        {@link max_batch_size} datagrams where the platform provides
+ *        @p recvmmsg and @p sendmmsg.
+ * @note Each received datagram occupies a slot of {@link max_datagram_size}
+ *       bytes in a receive area for {@link max_batch_size} datagrams, i.e.,
+ *       up to 4MB of address space with the default size of 65535 bytes.
+ *       The OS commits only pages that actually received data.
+ */
+class udp_socket {
+
+    udp_socket(const udp_socket&) = delete;
+    udp_socket& operator=(const udp_socket&) = delete;
+
+ public:
+
+    /**
+     * @brief The maximum number of datagrams per system call.
+     */
+    static constexpr size_t max_batch_size = 64;
+
+    /**
+     * @brief An outgoing datagram.
+     */
+    struct datagram {
+        ip_endpoint remote;
+        buffer buf;
+    };
+
+    /**
+     * @brief Creates a UDP socket bound to @p port on @p addr, or on
+     *        @p INADDR_ANY if @p addr is @p nullptr. Passing 0 as @p port
+     *        binds the socket to an ephemeral port.
+     * @param reuse_port Sets @p SO_REUSEPORT, i.e., allows other sockets
+     *                   with this option to bind to the same port.
+     * @throws bind_failure if @p port is in use.
+     * @throws network_error if @p addr is not a valid IP address.
+     */
+    static udp_socket_uptr create(std::uint16_t port,
+                                  const char* addr = nullptr,
+                                  bool reuse_port = false);
+
+    /**
+     * @brief Takes ownership of the bound UDP socket @p fd.
+     */
+    static udp_socket_uptr from_sockfd(native_socket_type fd);
+
+    ~udp_socket();
+
+    native_socket_type file_handle() const;
+
+    /**
+     * @brief Returns the port this socket is bound to.
+     */
+    std::uint16_t port() const;
+
+    /**
+     * @brief Sets the maximum size of received datagrams.
+     *        Larger datagrams are dropped.
+     * @note The default size is 65535 bytes. Smaller sizes
+     *       reduce the memory of the receive area.
+     */
+    void max_datagram_size(size_t num_bytes);
+
+    /**
+     * @brief Returns the maximum size of received datagrams.
+     */
+    inline size_t max_datagram_size() const;
+
+    /**
+     * @brief Receives pending datagrams without blocking.
+     * @returns The number of received datagrams, which remain accessible
+     *          via {@link remote()}, {@link data()} and {@link size()}
+     *          until the next call to this member function.
+     * @throws std::ios_base::failure
+     */
+    size_t receive();
+
+    /**
+     * @brief Returns the sender of the @p i-th received datagram.
+     */
+    inline const ip_endpoint& remote(size_t i) const;
+
+    /**
+     * @brief Returns the content of the @p i-th received datagram.
+     */
+    inline const void* data(size_t i) const;
+
+    /**
+     * @brief Returns the size of the @p i-th received datagram.
+     */
+    inline size_t size(size_t i) const;
+
+    /**
+     * @brief Sends up to @p num datagrams starting at @p first without
+     *        blocking. Datagrams the OS refuses to send, e.g., because
+     *        the remote host is unreachable, are dropped.
+     * @returns The number of sent or dropped datagrams. A value
+     *          less than @p num indicates that the send buffer is full.
+     */
+    size_t send(const datagram* first, size_t num);
+
+ private:
+
+    udp_socket(native_socket_type fd);
+
+    struct received {
+        ip_endpoint remote;
+        const char* data;
+        size_t size;
+    };
+
+    native_socket_type m_fd;
+    int m_family;
+    size_t m_max_datagram_size;
+    std::unique_ptr<char[]> m_area;
+    std::vector<received> m_received;
+
+};
+
+/******************************************************************************
+ *             inline and template member function implementations            *
+ ******************************************************************************/
+
+inline size_t udp_socket::max_datagram_size() const {
+    return m_max_datagram_size;
+}
+
+inline const ip_endpoint& udp_socket::remote(size_t i) const {
+    return m_received[i].remote;
+}
+
+inline const void* udp_socket::data(size_t i) const {
+    return m_received[i].data;
+}
+
+inline size_t udp_socket::size(size_t i) const {
+    return m_received[i].size;
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_IO_UDP_SOCKET_HPP
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <unordered_map>
 
 #include "boost/actor/actor.hpp"
 #include "boost/actor/extend.hpp"
@@ -35,6 +36,7 @@
 #include "boost/actor/exit_reason.hpp"
 #include "boost/actor/typed_actor.hpp"
 #include "boost/actor/spawn_options.hpp"
+#include "boost/actor/mailbox_config.hpp"
 #include "boost/actor/message_header.hpp"
 #include "boost/actor/abstract_actor.hpp"
 #include "boost/actor/abstract_group.hpp"
@@ -45,6 +47,7 @@
 
 #include "boost/actor/mixin/memory_cached.hpp"
 
+#include "boost/actor/detail/timer_wheel.hpp"
 #include "boost/actor/detail/behavior_stack.hpp"
 #include "boost/actor/detail/typed_actor_util.hpp"
 #include "boost/actor/detail/single_reader_queue.hpp"
@@ -91,6 +94,22 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
         return eval_opts(Os, std::move(res));
     }
 
+    template<class C, spawn_options Os = no_spawn_options, typename... Ts>
+    actor spawn(mailbox_config cfg, Ts&&... args) {
+        constexpr auto os = make_unbound(Os);
+        auto res = spawn_class<C, os>(m_host, mailbox_configurator{cfg},
+                                      std::forward<Ts>(args)...);
+        return eval_opts(Os, std::move(res));
+    }
+
+    template<spawn_options Os = no_spawn_options, typename... Ts>
+    actor spawn(mailbox_config cfg, Ts&&... args) {
+        constexpr auto os = make_unbound(Os);
+        auto res = spawn_functor<os>(m_host, mailbox_configurator{cfg},
+                                     std::forward<Ts>(args)...);
+        return eval_opts(Os, std::move(res));
+    }
+
     template<class C, spawn_options Os, typename... Ts>
     actor spawn_in_group(const group& grp, Ts&&... args) {
         constexpr auto os = make_unbound(Os);
@@ -200,6 +219,54 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
                    make_message(std::forward<Ts>(what)...));
     }
 
+    /**
+     * @brief Sends @p what to the receiver specified in @p dest.
+     * @returns @p false if the receiver signalizes backpressure, i.e., its
+     *          bounded mailbox using {@link mailbox_overflow::backpressure}
+     *          exceeds its capacity with @p what, otherwise @p true.
+     */
+    bool try_send_tuple(message_priority prio, const channel& whom,
+                        message what);
+
+    /**
+     * @brief Sends @p what to the receiver specified in @p dest.
+     * @returns @p false if the receiver signalizes backpressure, i.e., its
+     *          bounded mailbox using {@link mailbox_overflow::backpressure}
+     *          is full, otherwise @p true.
+     */
+    inline bool try_send_tuple(const channel& whom, message what) {
+        return try_send_tuple(message_priority::normal, whom, std::move(what));
+    }
+
+    /**
+     * @brief Sends <tt>{what...}</tt> to @p whom.
+     * @returns @p false if the receiver signalizes backpressure, i.e., its
+     *          bounded mailbox using {@link mailbox_overflow::backpressure}
+     *          is full, otherwise @p true.
+     * @pre <tt>sizeof...(Ts) > 0</tt>.
+     */
+    template<typename... Ts>
+    inline bool try_send(message_priority prio, const channel& whom,
+                         Ts&&... what) {
+        static_assert(sizeof...(Ts) > 0, "sizeof...(Ts) == 0");
+        return try_send_tuple(prio, whom,
+                              make_message(std::forward<Ts>(what)...));
+    }
+
+    /**
+     * @brief Sends <tt>{what...}</tt> to @p whom.
+     * @returns @p false if the receiver signalizes backpressure, i.e., its
+     *          bounded mailbox using {@link mailbox_overflow::backpressure}
+     *          is full, otherwise @p true.
+     * @pre <tt>sizeof...(Ts) > 0</tt>.
+     */
+    template<typename... Ts>
+    inline bool try_send(const channel& whom, Ts&&... what) {
+        static_assert(sizeof...(Ts) > 0, "sizeof...(Ts) == 0");
+        return try_send_tuple(message_priority::normal, whom,
+                              make_message(std::forward<Ts>(what)...));
+    }
+
     /**
      * @brief Sends an exit message to @p whom.
      */
@@ -440,6 +507,29 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
         return res;
     }
 
+    void configure_mailbox(const mailbox_config& cfg);
+
+    // denotes whether a message is enqueued to a bounded mailbox
+    enum class admission {
+        accepted,
+        // accepted, but the sender has to slow down
+        overloaded,
+        // exceeds the capacity of the mailbox
+        dropped
+    };
+
+    inline admission admit_message(msg_hdr_cref hdr, const message& msg) {
+        return m_mailbox_capacity == 0 ? admission::accepted
+                                       : admit_bounded(hdr, msg);
+    }
+
+    // called by the reader for each message taken from its mailbox;
+    // returns true if the message exceeds the capacity of a bounded
+    // mailbox and therefore must be dropped
+    inline bool discard_dequeued(const mailbox_element& e) {
+        return m_mailbox_capacity > 0 && discard_bounded(e);
+    }
+
     inline void current_node(mailbox_element* ptr) {
         this->m_current_node = ptr;
     }
@@ -448,8 +538,9 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
         return this->m_current_node;
     }
 
-    inline message_id new_request_id() {
+    inline message_id new_request_id(message_priority mp) {
         auto result = ++m_last_request_id;
+        if (mp == message_priority::high) result = result.with_high_priority();
         m_pending_responses.push_back(result.response_id());
         return result;
     }
@@ -475,6 +566,13 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
                                     const actor& whom,
                                     message&& what);
 
+    // delivers msg to this actor after d unless cancelled before
+    detail::timer_handle schedule_timeout(const duration& d, message msg);
+
+    // cancels a message scheduled by schedule_timeout unless
+    // it has been delivered already
+    void cancel_timeout(const detail::timer_handle& handle);
+
     // returns the response ID
     template<typename... Rs, typename... Ts>
     message_id sync_send_tuple_impl(message_priority mp,
@@ -495,6 +593,14 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
 
     inline void mark_arrived(message_id response_id);
 
+    void cancel_sync_timeout(message_id response_id);
+
+    // drops the timer of a timed sync message once its timeout message
+    // arrives, regardless of whether the actor still awaits the response
+    inline void sync_timeout_fired(message_id response_id) {
+        m_sync_timeouts.erase(response_id.integer_value());
+    }
+
     inline std::uint32_t planned_exit_reason() const;
 
     inline void planned_exit_reason(std::uint32_t value);
@@ -535,6 +641,10 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
     // identifies all IDs of sync messages waiting for a response
     std::vector<message_id> m_pending_responses;
 
+    // timeouts of timed sync messages waiting for a response,
+    // keyed by the integer value of the response ID
+    std::unordered_map<std::uint64_t, detail::timer_handle> m_sync_timeouts;
+
     // "default value" for m_current_node
     mailbox_element m_dummy_node;
 
@@ -548,10 +658,23 @@ class local_actor : public extend<abstract_actor>::with<mixin::memory_cached> {
     // set by quit
     std::uint32_t m_planned_exit_reason;
 
+    // maximum number of messages in the mailbox; 0 means unbounded
+    size_t m_mailbox_capacity;
+
+    // denotes how to handle messages exceeding m_mailbox_capacity
+    mailbox_overflow m_mailbox_overflow;
+
+    // number of messages in a bounded mailbox
+    std::atomic<size_t> m_mailbox_size;
+
     /** @endcond */
 
  private:
 
+    admission admit_bounded(msg_hdr_cref hdr, const message& msg);
+
+    bool discard_bounded(const mailbox_element& e);
+
     std::function<void()> m_sync_failure_handler;
     std::function<void()> m_sync_timeout_handler;
 
@@ -604,6 +727,7 @@ inline void local_actor::mark_arrived(message_id response_id) {
     auto last = m_pending_responses.end();
     auto i = std::find(m_pending_responses.begin(), last, response_id);
     if (i != last) m_pending_responses.erase(i);
+    if (!m_sync_timeouts.empty()) cancel_sync_timeout(response_id);
 }
 
 inline std::uint32_t local_actor::planned_exit_reason() const {
@@ -0,0 +1,103 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_MAILBOX_CONFIG_HPP
+#define BOOST_ACTOR_MAILBOX_CONFIG_HPP
+
+#include <cstddef>
+
+namespace boost {
+namespace actor {
+
+/**
+ * @ingroup ActorCreation
+ * @{
+ */
+
+/**
+ * @brief Denotes how an actor handles messages that
+ *        exceed the capacity of its mailbox.
+ * @note Responses to synchronous requests as well as exit, down and
+ *       timeout messages are never dropped.
+ */
+enum class mailbox_overflow {
+
+    /**
+     * @brief Silently drops asynchronous messages that arrive at a full
+     *        mailbox. Dropped synchronous requests are answered like
+     *        {@link mailbox_overflow::reject} does, because their
+     *        senders would wait forever otherwise.
+     */
+    drop_newest,
+
+    /**
+     * @brief Accepts all messages, but the actor silently drops the
+     *        oldest messages until its mailbox fits its capacity
+     *        whenever it fetches a new message.
+     */
+    drop_oldest,
+
+    /**
+     * @brief Drops messages that arrive at a full mailbox and answers
+     *        dropped synchronous requests with a {@link sync_exited_msg}
+     *        using the reason {@link exit_reason::mailbox_overflow}.
+     */
+    reject,
+
+    /**
+     * @brief Accepts all messages, but signalizes senders to slow
+     *        down by returning @p false from {@link local_actor::try_send}.
+     */
+    backpressure
+
+};
+
+/**
+ * @brief Configures the mailbox of actors created by @p spawn.
+ */
+struct mailbox_config {
+
+    /**
+     * @brief The maximum number of messages or 0 for an unbounded mailbox.
+     */
+    size_t capacity;
+
+    /**
+     * @brief Denotes how to handle messages exceeding @p capacity.
+     */
+    mailbox_overflow overflow;
+
+};
+
+/**
+ * @brief Creates a {@link mailbox_config} for a mailbox holding
+ *        at most @p capacity messages.
+ * @relates mailbox_config
+ */
+inline mailbox_config bounded_mailbox(size_t capacity,
+                                      mailbox_overflow overflow
+                                      = mailbox_overflow::reject) {
+    return {capacity, overflow};
+}
+
+/** @} */
+
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_MAILBOX_CONFIG_HPP
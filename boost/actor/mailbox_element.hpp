@@ -57,10 +57,12 @@ class mailbox_element : public extend<memory_managed>::
     mailbox_element& operator=(mailbox_element&&) = delete;
     mailbox_element& operator=(const mailbox_element&) = delete;
 
-    template<typename T>
-    inline static mailbox_element* create(msg_hdr_cref hdr, T&& data) {
-        return detail::memory::create<mailbox_element>(hdr, std::forward<T>(data));
-    }
+    /**
+     * @brief Creates a new mailbox element for @p data. The element is
+     *        constructed into storage embedded into @p data if available,
+     *        i.e., if @p data is not shared.
+     */
+    static mailbox_element* create(msg_hdr_cref hdr, message data);
 
  private:
 
@@ -20,6 +20,8 @@
 #define BOOST_ACTOR_MATCH_EXPR_HPP
 
 #include <vector>
+#include <iterator>
+#include <algorithm>
 
 #include "boost/none.hpp"
 #include "boost/variant.hpp"
@@ -35,10 +37,12 @@
 
 #include "boost/actor/detail/matches.hpp"
 #include "boost/actor/detail/type_list.hpp"
+#include "boost/actor/detail/atom_guard.hpp"
 #include "boost/actor/detail/lifted_fun.hpp"
 #include "boost/actor/detail/tuple_dummy.hpp"
 #include "boost/actor/detail/pseudo_tuple.hpp"
 #include "boost/actor/detail/behavior_impl.hpp"
+#include "boost/actor/detail/dispatch_table.hpp"
 
 namespace boost {
 namespace actor {
@@ -226,8 +230,16 @@ struct invoke_util_impl<wildcard_position::nil,
     }
 
     template<class Tuple>
-    static bool can_invoke(const std::type_info& arg_types, const Tuple&) {
-        return arg_types == typeid(detail::type_list<Ts...>);
+    static bool can_invoke(const std::type_info& arg_types, const Tuple& tup) {
+        if (arg_types == typeid(detail::type_list<Ts...>)) return true;
+        if (!tup.dynamically_typed() || tup.size() != sizeof...(Ts)) {
+            return false;
+        }
+        auto& arr = arr_type::arr;
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            if (arr[i] != tup.type_at(i)) return false;
+        }
+        return true;
     }
 
 };
@@ -512,26 +524,13 @@ inline T& unroll_expr_result_unbox(optional<T>& opt) {
     return *opt;
 }
 
-template<typename Result, class PPFPs, typename PtrType, class Tuple>
-Result unroll_expr(PPFPs&, std::uint64_t, minus1l, const std::type_info&,
-                   bool, PtrType*, Tuple&) {
-    return none;
-}
-
-template<typename Result, class PPFPs, long N, typename PtrType, class Tuple>
-Result unroll_expr(PPFPs& fs,
-                   std::uint64_t bitmask,
-                   long_constant<N>,
+// invokes the N-th case if its pattern matches tup
+template<typename Result, long N, class PPFPs, typename PtrType, class Tuple>
+Result invoke_case(PPFPs& fs,
                    const std::type_info& type_token,
                    bool is_dynamic,
                    PtrType* ptr,
                    Tuple& tup) {
-    /* recursively evaluate sub expressions */ {
-        Result res = unroll_expr<Result>(fs, bitmask, long_constant<N-1>{},
-                                         type_token, is_dynamic, ptr, tup);
-        if (!get<none_t>(&res)) return res;
-    }
-    if ((bitmask & (0x01 << N)) == 0) return none;
     auto& f = get<N>(fs);
     typedef typename detail::rm_const_and_ref<decltype(f)>::type Fun;
     typedef typename Fun::pattern_type pattern_type;
@@ -547,6 +546,31 @@ Result unroll_expr(PPFPs& fs,
     return none;
 }
 
+// tries all cases selected by bitmask in order until one matches;
+// jumps directly to the selected cases using a table generated at
+// compile time rather than testing each bit of the bitmask in turn
+template<typename Result, class PPFPs, long... Is, typename PtrType,
+         class Tuple>
+Result unroll_expr(PPFPs& fs,
+                   std::uint64_t bitmask,
+                   int_list<Is...>,
+                   const std::type_info& type_token,
+                   bool is_dynamic,
+                   PtrType* ptr,
+                   Tuple& tup) {
+    typedef Result (*case_fun)(PPFPs&, const std::type_info&,
+                               bool, PtrType*, Tuple&);
+    static const case_fun cases[] = {
+        &invoke_case<Result, Is, PPFPs, PtrType, Tuple>...
+    };
+    for (; bitmask != 0; bitmask &= bitmask - 1) {
+        auto f = cases[dispatch_table::lowest_bit(bitmask)];
+        Result res = f(fs, type_token, is_dynamic, ptr, tup);
+        if (!get<none_t>(&res)) return res;
+    }
+    return none;
+}
+
 template<class PPFPs, class Tuple>
 inline std::uint64_t calc_bitmask(PPFPs&,
                                   minus1l,
@@ -564,10 +588,48 @@ inline std::uint64_t calc_bitmask(Case& fs,
     typedef typename detail::rm_const_and_ref<decltype(f)>::type Fun;
     typedef typename Fun::pattern_type pattern_type;
     typedef detail::invoke_util<pattern_type> policy;
-    std::uint64_t result = policy::can_invoke(tinf, tup) ? (0x01 << N) : 0x00;
+    auto flag = std::uint64_t{1} << N;
+    std::uint64_t result = policy::can_invoke(tinf, tup) ? flag : 0x00;
     return result | calc_bitmask(fs, long_constant<N-1l>(), tinf, tup);
 }
 
+template<class Case>
+inline std::uint64_t leading_atom_key(const Case&, std::false_type) {
+    return 0;
+}
+
+template<class Case>
+inline std::uint64_t leading_atom_key(const Case& f, std::true_type) {
+    return atom_key(get<0>(f.projection_funs()));
+}
+
+template<class PPFPs>
+inline void collect_case_keys(const PPFPs&, minus1l,
+                              std::uint64_t*, std::uint64_t&) {
+    // end of recursion
+}
+
+// stores the atom each case expects as first element or 0 into keys
+// and sets the bit of each case matching any message in catch_all
+template<class PPFPs, long N>
+inline void collect_case_keys(const PPFPs& fs,
+                              long_constant<N>,
+                              std::uint64_t* keys,
+                              std::uint64_t& catch_all) {
+    auto& f = get<N>(fs);
+    typedef typename detail::rm_const_and_ref<decltype(f)>::type Fun;
+    typedef typename Fun::pattern_type pattern_type;
+    std::integral_constant<
+        bool,
+        std::is_same<typename tl_head<pattern_type>::type, atom_value>::value
+    > token;
+    keys[N] = leading_atom_key(f, token);
+    if (std::is_same<pattern_type, type_list<anything>>::value) {
+        catch_all |= std::uint64_t{1} << N;
+    }
+    collect_case_keys(fs, long_constant<N-1l>(), keys, catch_all);
+}
+
 template<bool IsManipulator, typename T0, typename T1>
 struct mexpr_fwd_ {
     typedef T1 type;
@@ -681,6 +743,8 @@ class match_expr {
 
     static constexpr idx_token_type idx_token = idx_token_type{};
 
+    typedef typename detail::il_indices<cases_list>::type indices_token;
+
     template<typename T, typename... Ts>
     match_expr(T arg, Ts&&... args)
             : m_cases(std::move(arg), std::forward<Ts>(args)...) {
@@ -735,68 +799,93 @@ class match_expr {
     //                        ...>
     std::tuple<Cs...> m_cases;
 
-    static constexpr size_t cache_size = 10;
+    typedef std::pair<std::uint64_t, std::uint64_t> atom_entry;
 
-    typedef std::pair<const std::type_info*, std::uint64_t> cache_element;
+    // bitmasks of cases per message type, built lazily and
+    // thread-safe, because actors share their behavior
+    detail::dispatch_table m_table;
 
-    std::vector<cache_element> m_cache;
+    // bitmask for empty messages
+    std::uint64_t m_empty_mask;
 
-    // ring buffer like access to m_cache
-    size_t m_cache_begin;
-    size_t m_cache_end;
+    // (atom, bitmask) pairs for all cases with a leading atom,
+    // sorted by atom and computed once in init()
+    atom_entry m_atom_table[sizeof...(Cs)];
+    size_t m_atom_table_size;
 
-    cache_element m_dummy;
+    // cases matching any message, e.g., others()
+    std::uint64_t m_catch_all_mask;
 
-    static inline void advance_(size_t& i) {
-        i = (i + 1) % cache_size;
-    }
+    // cases selected by the type of a message, i.e., all cases
+    // that neither have a leading atom nor match any message
+    std::uint64_t m_typed_mask;
 
-    inline size_t find_token_pos(const std::type_info* type_token) {
-        for (size_t i = m_cache_begin ; i != m_cache_end; advance_(i)) {
-            if (m_cache[i].first == type_token) return i;
-        }
-        return m_cache_end;
+    std::uint64_t atom_cases(std::uint64_t atom) const {
+        auto first = m_atom_table;
+        auto last = first + m_atom_table_size;
+        auto i = std::lower_bound(first, last, atom,
+                                  [](const atom_entry& e, std::uint64_t x) {
+                                      return e.first < x;
+                                  });
+        return (i != last && i->first == atom) ? i->second : 0;
     }
 
-    template<class Tuple>
-    std::uint64_t get_cache_entry(const std::type_info* type_token,
-                                  const Tuple& value) {
-        BOOST_ACTOR_REQUIRE(type_token != nullptr);
-        if (value.dynamically_typed()) {
-            return m_dummy.second; // all groups enabled
+    // selects all cases that can possibly match vals; cases with a leading
+    // atom are selected by the atom alone, because invoking them
+    // checks the remaining types anyways
+    std::uint64_t get_bitmask(const detail::message_data& vals) {
+        auto result = m_catch_all_mask;
+        if (m_atom_table_size > 0) {
+            result |= atom_cases(detail::dispatch_table::leading_atom(vals));
         }
-        size_t i = find_token_pos(type_token);
-        // if we didn't found a cache entry ...
-        if (i == m_cache_end) {
-            // ... 'create' one (override oldest element in cache if full)
-            advance_(m_cache_end);
-            if (m_cache_end == m_cache_begin) advance_(m_cache_begin);
-            m_cache[i].first = type_token;
-            m_cache[i].second = calc_bitmask(m_cases,
-                                             idx_token,
-                                             *type_token,
-                                             value);
+        if (m_typed_mask != 0) {
+            auto ptr = m_table.find(vals);
+            if (ptr) return result | *ptr;
+            auto mask = calc_bitmask(m_cases, idx_token,
+                                     *vals.type_token(), vals);
+            mask &= m_typed_mask;
+            m_table.emplace(vals, mask);
+            result |= mask;
         }
-        return m_cache[i].second;
+        return result;
     }
 
     void init() {
-        m_dummy.second = std::numeric_limits<std::uint64_t>::max();
-        m_cache.resize(cache_size);
-        for (auto& entry : m_cache) { entry.first = nullptr; }
-        m_cache_begin = m_cache_end = 0;
+        detail::tuple_dummy td;
+        m_empty_mask = calc_bitmask(m_cases, idx_token, *td.type_token(), td);
+        std::uint64_t keys[sizeof...(Cs)];
+        m_catch_all_mask = 0;
+        detail::collect_case_keys(m_cases, idx_token, keys, m_catch_all_mask);
+        std::uint64_t atom_mask = 0;
+        m_atom_table_size = 0;
+        for (size_t i = 0; i < sizeof...(Cs); ++i) {
+            if (keys[i] == 0) continue;
+            auto flag = std::uint64_t{1} << i;
+            atom_mask |= flag;
+            auto last = m_atom_table + m_atom_table_size;
+            auto j = std::find_if(m_atom_table, last,
+                                  [&](const atom_entry& e) {
+                                      return e.first == keys[i];
+                                  });
+            if (j == last) {
+                *j = atom_entry{keys[i], 0};
+                ++m_atom_table_size;
+            }
+            j->second |= flag;
+        }
+        std::sort(m_atom_table, m_atom_table + m_atom_table_size);
+        auto all = (std::uint64_t{1} << sizeof...(Cs)) - 1;
+        m_typed_mask = all & ~(atom_mask | m_catch_all_mask);
     }
 
     template<class Tuple>
     result_type apply(Tuple& tup) {
         if (tup.empty()) {
             detail::tuple_dummy td;
-            auto td_token_ptr = td.type_token();
-            auto td_bitmask = get_cache_entry(td_token_ptr, td);
             return detail::unroll_expr<result_type>(m_cases,
-                                                    td_bitmask,
-                                                    idx_token,
-                                                    *td_token_ptr,
+                                                    m_empty_mask,
+                                                    indices_token{},
+                                                    *td.type_token(),
                                                     false,
                                                     static_cast<void*>(nullptr),
                                                     td);
@@ -808,11 +897,11 @@ class match_expr {
         auto& vals = tref.vals();
         auto ndp = fetch_native_data(vals, mutator_token);
         auto token_ptr = vals->type_token();
-        auto bitmask = get_cache_entry(token_ptr, *vals);
+        auto bitmask = get_bitmask(*vals);
         auto dynamically_typed = vals->dynamically_typed();
         return detail::unroll_expr<result_type>(m_cases,
                                                 bitmask,
-                                                idx_token,
+                                                indices_token{},
                                                 *token_ptr,
                                                 dynamically_typed,
                                                 ndp,
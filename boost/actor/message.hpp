@@ -229,6 +229,20 @@ inline bool operator!=(const message& lhs, const message& rhs) {
     return !(lhs == rhs);
 }
 
+/**
+ * @brief Sets whether {@link make_message} embeds storage for a mailbox
+ *        element into messages with a small payload, i.e., whether
+ *        sending such a message requires only a single allocation.
+ * @note Enabled by default.
+ */
+void embed_mailbox_elements(bool value);
+
+/**
+ * @brief Returns whether {@link make_message} embeds storage for
+ *        a mailbox element into messages with a small payload.
+ */
+bool embed_mailbox_elements();
+
 /**
  * @brief Creates an {@link message} containing the elements @p args.
  * @param args Values to initialize the tuple elements.
@@ -243,7 +257,20 @@ make_message(T&& arg, Ts&&... args) {
     using namespace detail;
     typedef tuple_vals<typename strip_and_convert<T>::type,
                        typename strip_and_convert<Ts>::type...> data;
-    auto ptr = new data(std::forward<T>(arg), std::forward<Ts>(args)...);
+    typedef tuple_vals_with_element<typename strip_and_convert<T>::type,
+                                    typename strip_and_convert<Ts>::type...>
+            data_with_element;
+    constexpr size_t max_payload = embedded_element_wrapper::max_payload;
+    message_data* ptr;
+    if (   sizeof(typename data::data_type) <= max_payload
+        && embed_mailbox_elements()) {
+        ptr = memory::create<data_with_element>(std::forward<T>(arg),
+                                                std::forward<Ts>(args)...);
+    }
+    else {
+        ptr = memory::create<data>(std::forward<T>(arg),
+                                   std::forward<Ts>(args)...);
+    }
     return message{detail::message_data::ptr{ptr}};
 }
 
@@ -53,16 +53,13 @@ class memory_cached : public Base {
                                 , outer_memory(nullptr) { }
 
     virtual void request_deletion() {
-        auto mc = detail::memory::get_cache_map_entry(&typeid(*this));
-        if (!mc) {
-            auto om = outer_memory;
-            if (om) {
-                om->destroy();
-                om->deallocate();
-            }
-            else delete this;
+        auto om = outer_memory;
+        if (om) {
+            // returns the memory to the cache of the allocating thread
+            om->destroy();
+            om->deallocate();
         }
-        else mc->release_instance(mc->downcast(this));
+        else delete this;
     }
 
  private:
@@ -23,6 +23,8 @@
 #include "boost/actor/duration.hpp"
 #include "boost/actor/system_messages.hpp"
 
+#include "boost/actor/detail/timer_wheel.hpp"
+
 namespace boost {
 namespace actor {
 namespace mixin {
@@ -45,6 +47,10 @@ class single_timeout : public Base {
             , m_timeout_id(0) { }
 
     void request_timeout(const duration& d) {
+        // a new timeout supersedes the pending one, i.e., there is
+        // no need to deliver the pending one just to drop it later on
+        this->cancel_timeout(m_timeout_handle);
+        m_timeout_handle.reset();
         if (d.valid()) {
             m_has_timeout = true;
             auto tid = ++m_timeout_id;
@@ -56,7 +62,7 @@ class single_timeout : public Base {
                 //auto e = this->new_mailbox_element(this, std::move(msg));
                 //this->m_mailbox.enqueue(e);
             }
-            else this->delayed_send_tuple(this, d, std::move(msg));
+            else m_timeout_handle = this->schedule_timeout(d, std::move(msg));
         }
         else m_has_timeout = false;
     }
@@ -74,6 +80,8 @@ class single_timeout : public Base {
     }
 
     inline void reset_timeout() {
+        this->cancel_timeout(m_timeout_handle);
+        m_timeout_handle.reset();
         m_has_timeout = false;
     }
 
@@ -81,6 +89,7 @@ class single_timeout : public Base {
 
     bool m_has_timeout;
     std::uint32_t m_timeout_id;
+    detail::timer_handle m_timeout_handle;
 
 };
 
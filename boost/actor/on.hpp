@@ -40,6 +40,7 @@
 
 #include "boost/actor/detail/boxed.hpp"
 #include "boost/actor/detail/unboxed.hpp"
+#include "boost/actor/detail/atom_guard.hpp"
 #include "boost/actor/detail/implicit_conversions.hpp"
 
 namespace boost {
@@ -314,6 +315,14 @@ struct to_guard<anything, false> {
 template<typename T>
 struct to_guard<detail::wrapped<T>, false> : to_guard<anything> { };
 
+// atoms get a guard that match_expr can use as dispatch key
+template<>
+struct to_guard<atom_value, false> {
+    static detail::atom_guard _(atom_value value) {
+        return value;
+    }
+};
+
 template<typename T>
 struct is_optional : std::false_type { };
 
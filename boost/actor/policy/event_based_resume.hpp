@@ -96,10 +96,19 @@ class event_based_resume {
                 if (actor_done() && done_cb()) return resume_result::done;
                 // else: enter resume loop
             }
+            auto max_throughput = scheduler::max_throughput();
+            size_t handled_msgs = 0;
             try {
                 for (;;) {
+                    if (handled_msgs == max_throughput) {
+                        BOOST_ACTOR_LOG_DEBUG("max throughput reached; "
+                                              "reschedule actor");
+                        if (host) host->exec_later(this);
+                        return resumable::resume_later;
+                    }
                     auto ptr = d->next_message();
                     if (ptr) {
+                        ++handled_msgs;
                         if (d->invoke_message(ptr)) {
                             if (actor_done() && done_cb()) {
                                 BOOST_ACTOR_LOG_DEBUG("actor exited");
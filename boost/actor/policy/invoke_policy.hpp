@@ -161,6 +161,7 @@ class invoke_policy {
             }
             else if (  msg.type_at(0)->equal_to(typeid(sync_timeout_msg))
                     && mid.is_response()) {
+                self->sync_timeout_fired(mid);
                 return msg_type::timeout_response;
             }
         }
@@ -24,6 +24,8 @@
 
 #include "boost/actor/mailbox_element.hpp"
 #include "boost/actor/message_priority.hpp"
+
+#include "boost/actor/detail/intrusive_list.hpp"
 #include "boost/actor/detail/sync_request_bouncer.hpp"
 
 namespace boost {
@@ -37,19 +39,23 @@ class prioritizing {
 
     typedef cache_type::iterator cache_iterator;
 
+    typedef detail::intrusive_list<mailbox_element, detail::disposer>
+            queue_type;
+
     template<class Actor>
     unique_mailbox_element_pointer next_message(Actor* self) {
         if (!m_high.empty()) return take_first(m_high);
-        // read whole mailbox
-        unique_mailbox_element_pointer tmp{self->mailbox().try_pop()};
-        while (tmp) {
-            if (tmp->mid.is_high_priority()) m_high.push_back(std::move(tmp));
-            else m_low.push_back(std::move(tmp));
-            tmp.reset(self->mailbox().try_pop());
+        // read whole mailbox at once and split it by priority
+        // without allocating any memory
+        queue_type fetched;
+        if (self->mailbox().take_all(fetched) > 0) {
+            for (auto e = fetched.pop_front(); e; e = fetched.pop_front()) {
+                if (e->mid.is_high_priority()) m_high.push_back(e);
+                else m_low.push_back(e);
+            }
+            if (!m_high.empty()) return take_first(m_high);
         }
-        if (!m_high.empty()) return take_first(m_high);
-        if (!m_low.empty()) return take_first(m_low);
-        return unique_mailbox_element_pointer{};
+        return take_first(m_low);
     }
 
     template<class Actor>
@@ -115,6 +121,10 @@ class prioritizing {
         });
     }
 
+    inline unique_mailbox_element_pointer take_first(queue_type& from) {
+        return unique_mailbox_element_pointer{from.pop_front()};
+    }
+
     inline unique_mailbox_element_pointer take_first(cache_type& from) {
         auto tmp = std::move(from.front());
         from.erase(from.begin());
@@ -122,8 +132,8 @@ class prioritizing {
     }
 
     cache_type m_cache;
-    cache_type m_high;
-    cache_type m_low;
+    queue_type m_high;
+    queue_type m_low;
 
 };
 
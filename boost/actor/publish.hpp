@@ -55,7 +55,7 @@ inline void publish(actor whom, io::acceptor_uptr acceptor) {
  */
 inline void publish(actor whom, uint16_t port, const char* addr = nullptr) {
     if (!whom) return;
-    publish(std::move(whom), io::tcp_acceptor::create(port, addr));
+    detail::publish_impl(detail::raw_access::get(whom), port, addr);
 }
 
 /**
@@ -75,8 +75,7 @@ void typed_publish(typed_actor<Rs...> whom,
                    std::uint16_t port,
                    const char* addr = nullptr) {
     if (!whom) return;
-    detail::publish_impl(detail::raw_access::get(whom),
-                         io::tcp_acceptor::create(port, addr));
+    detail::publish_impl(detail::raw_access::get(whom), port, addr);
 }
 
 } // namespace actor
@@ -20,6 +20,7 @@
 #define BOOST_ACTOR_REMOTE_ACTOR_HPP
 
 #include <set>
+#include <chrono>
 #include <string>
 #include <cstdint>
 
@@ -65,6 +66,26 @@ inline actor remote_actor(const std::string& host, uint16_t port) {
     return remote_actor(host.c_str(), port);
 }
 
+/**
+ * @brief Connects to the actor at @p host on given @p port without blocking
+ *        the caller. @p listener receives either
+ *        <tt>(atom("CONNECTED"), host, port, proxy)</tt> once the proxy
+ *        is ready or <tt>(atom("CONN_ERROR"), host, port, error_message)</tt>.
+ * @param listener Receives the result of the connection attempt.
+ * @param host Valid hostname, IPv4 or IPv6 address.
+ * @param port TCP port.
+ * @param timeout Maximum time for resolving @p host, connecting
+ *                to it and receiving the handshake.
+ * @note Host names are resolved by the resolver threads of the middleman,
+ *       connection attempts run concurrently in its event loop.
+ */
+inline void remote_actor(const actor& listener, std::string host,
+                         std::uint16_t port,
+                         std::chrono::milliseconds timeout
+                         = std::chrono::seconds(10)) {
+    detail::remote_actor_impl(listener, std::move(host), port, timeout);
+}
+
 /**
  * @copydoc remote_actor(io::stream_ptr_pair)
  */
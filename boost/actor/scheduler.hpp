@@ -20,11 +20,16 @@
 #define BOOST_ACTOR_SCHEDULER_HPP
 
 #include <chrono>
+#include <mutex>
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <thread>
+#include <vector>
 #include <cstdint>
 #include <functional>
 #include <type_traits>
+#include <condition_variable>
 
 #include "boost/actor/atom.hpp"
 #include "boost/actor/actor.hpp"
@@ -37,6 +42,8 @@
 #include "boost/actor/execution_unit.hpp"
 #include "boost/actor/message_header.hpp"
 
+#include "boost/actor/detail/timer_wheel.hpp"
+#include "boost/actor/detail/work_stealing_deque.hpp"
 #include "boost/actor/detail/producer_consumer_list.hpp"
 
 namespace boost {
@@ -50,22 +57,148 @@ namespace scheduler {
 
 class coordinator;
 
+/**
+ * @brief A list of CPU indexes a thread is allowed to run on.
+ *        An empty list does not restrict the thread.
+ */
+typedef std::vector<size_t> cpu_list;
+
+/**
+ * @brief Stores the configuration of the scheduling coordinator.
+ */
+class configuration {
+
+ public:
+
+    configuration();
+
+    /**
+     * @brief The number of workers, @p 0 selects
+     *        <tt>std::thread::hardware_concurrency()</tt>.
+     */
+    size_t num_workers;
+
+    /**
+     * @brief The CPUs of each worker, indexed by worker ID. Workers
+     *        without an entry run on all CPUs that are not reserved
+     *        for the middleman or the timer thread.
+     */
+    std::vector<cpu_list> worker_affinity;
+
+    /**
+     * @brief The NUMA node of each worker, indexed by worker ID. Idle workers
+     *        steal jobs from workers of the same node before they steal
+     *        from remote nodes. Workers without an entry belong to the node
+     *        of their first CPU if pinned and to node @p 0 otherwise.
+     */
+    std::vector<size_t> worker_numa_node;
+
+    /**
+     * @brief The number of event loops of the middleman, each running in
+     *        its own thread. Peers are distributed across the loops by the
+     *        hash value of their node ID.
+     * @note Defaults to @p 1, @p 0 is treated as @p 1.
+     */
+    size_t num_middleman_loops;
+
+    /**
+     * @brief CPUs reserved for the middleman threads. Each event loop gets
+     *        pinned to a CPU of its own if this list has at least
+     *        @p num_middleman_loops entries, otherwise all loops share
+     *        these CPUs.
+     */
+    cpu_list middleman_affinity;
+
+    /**
+     * @brief The number of threads the middleman uses for blocking
+     *        name lookups of asynchronous connection attempts.
+     * @note Defaults to @p 2, @p 0 is treated as @p 1.
+     */
+    size_t num_resolver_threads;
+
+    /**
+     * @brief Enables edge-triggered readiness notification in the event
+     *        loops of the middleman if supported by the platform (epoll).
+     * @note Defaults to @p false.
+     */
+    bool edge_triggered_io;
+
+    /**
+     * @brief Causes {@link publish} to open one listening socket per event
+     *        loop using @p SO_REUSEPORT, i.e., the OS distributes incoming
+     *        connections across all loops. Has no effect on platforms
+     *        without @p SO_REUSEPORT or if only one loop is configured.
+     * @note Defaults to @p false.
+     */
+    bool shard_acceptors;
+
+    /**
+     * @brief CPUs reserved for the timer and printer threads.
+     */
+    cpu_list timer_affinity;
+
+};
+
+/**
+ * @brief Sets the configuration of the scheduling coordinator.
+ * @throws std::logic_error if the coordinator is already running.
+ * @note The configuration is evaluated when the coordinator gets created,
+ *       i.e., this function must be called before spawning any actor.
+ */
+void set_configuration(const configuration& cfg);
+
+/**
+ * @brief Returns the configuration of the scheduling coordinator.
+ */
+configuration get_configuration();
+
+/**
+ * @brief Sets the number of polling attempts an idle worker makes
+ *        before it parks its thread until new work arrives.
+ * @param attempts The number of polling attempts. Higher values
+ *                 reduce wakeup latency at the cost of CPU time.
+ * @note Takes effect for workers that become idle after this call.
+ */
+void spin_attempts(size_t attempts);
+
+/**
+ * @brief Queries the number of polling attempts an idle worker makes
+ *        before it parks its thread.
+ */
+size_t spin_attempts();
+
+/**
+ * @brief Sets the maximum number of messages an event-based actor
+ *        processes before it returns its worker to the scheduler.
+ *
+ * An actor reaching this limit is rescheduled behind all other jobs of its
+ * worker, i.e., a single actor with a steadily refilled mailbox can no
+ * longer monopolize a worker. The default is unlimited, @p 0 restores
+ * the default.
+ */
+void max_throughput(size_t num_messages);
+
+/**
+ * @brief Queries the maximum number of messages an event-based actor
+ *        processes before it returns its worker to the scheduler.
+ */
+size_t max_throughput();
 
 /**
  * @brief A work-stealing scheduling worker.
  *
- * The work-stealing implementation of libcppa minimizes access to the
- * synchronized queue. The reasoning behind this design decision is that
- * it has been shown that stealing actually is very rare for workloads [1].
- * Hence, implementations should focus on the performance in
- * the non-stealing case. For this reason, each worker has an exposed
- * job queue that can be accessed by the central scheduler instance as
- * well as other workers, but it also has a private job list it is
- * currently working on. To account for the load balancing aspect, each
- * worker makes sure that at least one job is left in its exposed queue
- * to allow other workers to steal it.
+ * Each worker owns a lock-free work-stealing deque. The worker itself
+ * pushes and takes jobs at the bottom end of its deque without contention
+ * or allocation, while idle workers steal jobs from the top end [1].
+ * Jobs enqueued from other threads, e.g., by the central scheduler
+ * instance, go to a separate inbox of the worker, since only the owner
+ * is allowed to push to its deque.
+ *
+ * A worker that runs out of work polls for new jobs for a short time
+ * (see {@link spin_attempts}) before it registers itself as idle at the
+ * coordinator and blocks until another thread publishes new work.
  *
- * [1] http://dl.acm.org/citation.cfm?doid=2398857.2384639
+ * [1] http://dl.acm.org/citation.cfm?id=1073974
  */
 class worker : public execution_unit {
 
@@ -73,7 +206,7 @@ class worker : public execution_unit {
 
  public:
 
-    worker() = default;
+    worker();
 
     worker(worker&&);
 
@@ -85,10 +218,13 @@ class worker : public execution_unit {
 
     typedef resumable* job_ptr;
 
-    typedef detail::producer_consumer_list<resumable> job_queue;
+    typedef detail::work_stealing_deque<resumable> job_queue;
+
+    typedef detail::producer_consumer_list<resumable> inbox;
 
     /**
-     * @brief Attempt to steal an element from the exposed job queue.
+     * @brief Attempt to steal an element from this worker.
+     * @note Can be called from any thread.
      */
     job_ptr try_steal();
 
@@ -106,21 +242,33 @@ class worker : public execution_unit {
      */
     void exec_later(job_ptr) override;
 
+    /**
+     * @brief Returns how often jobs of this worker have been preempted
+     *        because they reached the {@link max_throughput} limit.
+     */
+    inline size_t num_preemptions() const {
+        return m_num_preemptions.load(std::memory_order_relaxed);
+    }
+
  private:
 
-    void start(size_t id, coordinator* parent); // called from coordinator
+    void start(coordinator* parent); // called from coordinator
 
     void run(); // work loop
 
     job_ptr raid(); // go on a raid in quest for a shiny new job
 
-    // this queue is exposed to others, i.e., other workers
-    // may attempt to steal jobs from it and the central scheduling
-    // unit can push new jobs to the queue
-    job_queue m_exposed_queue;
+    // tries to steal from the workers in `victims`, starting at `pos`
+    job_ptr raid(const std::vector<size_t>& victims, size_t& pos);
+
+    void park(); // blocks until unparked by the coordinator
+
+    // jobs of this worker; the worker pushes and takes jobs at the
+    // bottom, other workers steal jobs from the top
+    job_queue m_job_queue;
 
-    // internal job stack
-    std::vector<job_ptr> m_job_list;
+    // jobs enqueued by other threads, e.g., by the central scheduling unit
+    inbox m_inbox;
 
     // the worker's thread
     std::thread m_this_thread;
@@ -128,11 +276,34 @@ class worker : public execution_unit {
     // the worker's ID received from scheduler
     size_t m_id;
 
-    // the ID of the last victim we stole from
-    size_t m_last_victim;
+    // IDs of workers on the same NUMA node and the next victim's position
+    std::vector<size_t> m_local_victims;
+    size_t m_local_pos;
+
+    // IDs of workers on other NUMA nodes and the next victim's position
+    std::vector<size_t> m_remote_victims;
+    size_t m_remote_pos;
+
+    // the CPUs this worker is pinned to
+    cpu_list m_affinity;
+
+    // the NUMA node this worker belongs to
+    size_t m_numa_node;
 
     coordinator* m_parent;
 
+    // set by the coordinator to wake up this worker, guarded by
+    // the coordinator's m_idle_mtx
+    bool m_unparked;
+
+    std::condition_variable m_park_cv;
+
+    // the job currently executed by this worker
+    job_ptr m_current_job;
+
+    // written by this worker only, read by anyone
+    std::atomic<size_t> m_num_preemptions;
+
 };
 
 /**
@@ -142,6 +313,8 @@ class coordinator {
 
     friend class detail::singleton_manager;
 
+    friend class worker;
+
  public:
 
     class shutdown_helper;
@@ -156,28 +329,29 @@ class coordinator {
      */
     void enqueue(resumable* what);
 
-    template<typename Duration, typename... Data>
-    void delayed_send(message_header hdr,
-                      const Duration& rel_time,
-                      message data           ) {
-        auto tup = make_message(atom("SEND"),
-                                  duration{rel_time},
-                                  std::move(hdr),
-                                  std::move(data));
-        m_timer->enqueue(message_header{}, std::move(tup), nullptr);
-    }
+    /**
+     * @brief Delivers @p data to the receiver of @p hdr after @p rel_time.
+     * @returns A handle for cancelling the message via
+     *          {@link cancel_timeout}.
+     */
+    detail::timer_handle delayed_send(message_header hdr,
+                                      const duration& rel_time,
+                                      message data);
 
-    template<typename Duration, typename... Data>
-    void delayed_reply(message_header hdr,
-                       const Duration& rel_time,
-                       message data           ) {
-        BOOST_ACTOR_REQUIRE(hdr.id.valid() && hdr.id.is_response());
-        auto tup = make_message(atom("SEND"),
-                                  duration{rel_time},
-                                  std::move(hdr),
-                                  std::move(data));
-        m_timer->enqueue(message_header{}, std::move(tup), nullptr);
-    }
+    /**
+     * @brief Delivers the response @p data after @p rel_time.
+     * @returns A handle for cancelling the message via
+     *          {@link cancel_timeout}.
+     */
+    detail::timer_handle delayed_reply(message_header hdr,
+                                       const duration& rel_time,
+                                       message data);
+
+    /**
+     * @brief Cancels a message scheduled by @p delayed_send or
+     *        @p delayed_reply unless it has been delivered already.
+     */
+    void cancel_timeout(const detail::timer_handle& handle);
 
     inline size_t num_workers() const {
         return static_cast<unsigned>(m_workers.size());
@@ -199,7 +373,19 @@ class coordinator {
 
     void destroy();
 
-    intrusive_ptr<blocking_actor> m_timer;
+    // adds `w` to the set of idle workers
+    void register_idle(worker* w);
+
+    // removes `w` from the set of idle workers; returns false if
+    // `w` has been unparked in the meantime
+    bool unregister_idle(worker* w);
+
+    // wakes up one idle worker if there is any
+    void unpark_one();
+
+    class timer;
+
+    timer* m_timer;
     scoped_actor m_printer;
 
     std::thread m_timer_thread;
@@ -208,9 +394,16 @@ class coordinator {
     // ID of the worker receiving the next enqueue
     std::atomic<size_t> m_next_worker;
 
-    // vector of size std::thread::hardware_concurrency()
+    // vector of size configuration::num_workers
     std::vector<worker> m_workers;
 
+    // number of workers in m_idle, allows lock-free checks on enqueue
+    std::atomic<size_t> m_num_idle;
+
+    // workers currently waiting for new work
+    std::mutex m_idle_mtx;
+    std::vector<worker*> m_idle;
+
 };
 
 } // namespace scheduler
@@ -30,6 +30,7 @@
 namespace boost {
 namespace actor {
 
+class node_id;
 class actor_namespace;
 class uniform_type_info;
 class type_lookup_table;
@@ -93,6 +94,12 @@ class serializer {
      */
     virtual void write_tuple(size_t num, const primitive_variant* values) = 0;
 
+    /**
+     * @brief Writes the node ID @p nid or an invalid
+     *        node ID if <tt>nid == nullptr</tt>.
+     */
+    virtual void write_node_id(const node_id* nid);
+
     inline actor_namespace* get_namespace() {
         return m_namespace;
     }
@@ -199,6 +199,33 @@ actor spawn(Ts&&... args) {
                              std::forward<Ts>(args)...);
 }
 
+/**
+ * @brief Spawns an actor of type @p C using a mailbox configured by @p cfg.
+ * @param args Constructor arguments.
+ * @tparam Impl Subtype of {@link event_based_actor} or {@link sb_actor}.
+ * @tparam Os Optional flags to modify <tt>spawn</tt>'s behavior.
+ * @returns An {@link actor} to the spawned {@link actor}.
+ */
+template<class Impl, spawn_options Os = no_spawn_options, typename... Ts>
+actor spawn(mailbox_config cfg, Ts&&... args) {
+    return spawn_class<Impl, Os>(nullptr, mailbox_configurator{cfg},
+                                 std::forward<Ts>(args)...);
+}
+
+/**
+ * @brief Spawns a new {@link actor} that evaluates given arguments
+ *        using a mailbox configured by @p cfg.
+ * @param args A functor followed by its arguments.
+ * @tparam Os Optional flags to modify <tt>spawn</tt>'s behavior.
+ * @returns An {@link actor} to the spawned {@link actor}.
+ */
+template<spawn_options Os = no_spawn_options, typename... Ts>
+actor spawn(mailbox_config cfg, Ts&&... args) {
+    static_assert(sizeof...(Ts) > 0, "too few arguments provided");
+    return spawn_functor<Os>(nullptr, mailbox_configurator{cfg},
+                             std::forward<Ts>(args)...);
+}
+
 /**
  * @brief Spawns an actor of type @p C that immediately joins @p grp.
  * @param args Constructor arguments.
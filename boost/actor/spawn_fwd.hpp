@@ -34,6 +34,7 @@
 #include "boost/actor/group.hpp"
 #include "boost/actor/typed_actor.hpp"
 #include "boost/actor/spawn_options.hpp"
+#include "boost/actor/mailbox_config.hpp"
 
 #include "boost/actor/detail/type_list.hpp"
 
@@ -68,6 +69,23 @@ class group_subscriber {
 
 };
 
+class mailbox_configurator {
+
+ public:
+
+    inline mailbox_configurator(const mailbox_config& cfg) : m_cfg(cfg) { }
+
+    template<typename T>
+    inline void operator()(T* ptr) const {
+        ptr->configure_mailbox(m_cfg);
+    }
+
+ private:
+
+    mailbox_config m_cfg;
+
+};
+
 class empty_before_launch_callback {
 
  public:
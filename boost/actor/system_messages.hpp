@@ -26,7 +26,9 @@
 #include "boost/actor/actor_addr.hpp"
 
 #include "boost/actor/io/buffer.hpp"
+#include "boost/actor/io/ip_endpoint.hpp"
 #include "boost/actor/io/accept_handle.hpp"
+#include "boost/actor/io/datagram_handle.hpp"
 #include "boost/actor/io/connection_handle.hpp"
 
 #include "boost/actor/detail/tbind.hpp"
@@ -225,6 +227,56 @@ inline bool operator!=(const acceptor_closed_msg& lhs,
     return !(lhs == rhs);
 }
 
+/**
+ * @brief Signalizes a newly arrived datagram for a {@link broker}.
+ */
+struct new_datagram_msg {
+    /**
+     * @brief Handle to the related UDP endpoint.
+     */
+    io::datagram_handle handle;
+    /**
+     * @brief The sender of the datagram.
+     */
+    io::ip_endpoint remote;
+    /**
+     * @brief Buffer containing the received datagram.
+     */
+    io::buffer buf;
+};
+
+inline bool operator==(const new_datagram_msg& lhs,
+                       const new_datagram_msg& rhs) {
+    return    lhs.handle == rhs.handle
+           && lhs.remote == rhs.remote
+           && lhs.buf == rhs.buf;
+}
+
+inline bool operator!=(const new_datagram_msg& lhs,
+                       const new_datagram_msg& rhs) {
+    return !(lhs == rhs);
+}
+
+/**
+ * @brief Signalizes that a {@link broker} UDP endpoint has been closed.
+ */
+struct datagram_closed_msg {
+    /**
+     * @brief Handle to the closed UDP endpoint.
+     */
+    io::datagram_handle handle;
+};
+
+inline bool operator==(const datagram_closed_msg& lhs,
+                       const datagram_closed_msg& rhs) {
+    return lhs.handle == rhs.handle;
+}
+
+inline bool operator!=(const datagram_closed_msg& lhs,
+                       const datagram_closed_msg& rhs) {
+    return !(lhs == rhs);
+}
+
 template<typename T>
 typename std::enable_if<
     detail::tl_exists<
@@ -0,0 +1,135 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef BOOST_ACTOR_WIRE_FORMAT_HPP
+#define BOOST_ACTOR_WIRE_FORMAT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "boost/actor/node_id.hpp"
+
+namespace boost {
+namespace actor {
+
+/**
+ * @brief Denotes a version of the binary encoding used
+ *        by {@link binary_serializer} and {@link binary_deserializer}.
+ */
+enum class wire_format : std::uint8_t {
+
+    /**
+     * @brief Fixed-width integers, 32-bit length prefixes
+     *        and full node IDs for each actor address.
+     */
+    v1 = 1,
+
+    /**
+     * @brief LEB128 varint integers, compact atoms and a per-connection
+     *        dictionary that replaces repeated node IDs with an index.
+     */
+    v2 = 2
+
+};
+
+/**
+ * @brief Sets the highest wire format offered to remote nodes.
+ *        Connections use the highest format both sides support.
+ * @note The default is {@link wire_format::v2}.
+ */
+void max_wire_format(wire_format value);
+
+/**
+ * @brief Returns the highest wire format offered to remote nodes.
+ */
+wire_format max_wire_format();
+
+/**
+ * @brief Maps node IDs to small integers. One instance per connection
+ *        and direction is used by the {@link wire_format::v2} encoding.
+ *
+ * Valid IDs start at 1, since 0 denotes an invalid node ID on the wire.
+ * The table holds at most {@link max_size} entries. Both sides of a
+ * connection stop adding entries at this size, i.e., further nodes are
+ * always written in full using the ID <tt>max_size + 1</tt>.
+ */
+class node_id_table {
+
+ public:
+
+    /**
+     * @brief The maximum number of entries.
+     */
+    static constexpr size_t max_size = 1024;
+
+    /**
+     * @brief Returns the ID of @p nid or 0 if @p nid is not in the table.
+     */
+    std::uint32_t id_of(const node_id& nid) const;
+
+    /**
+     * @brief Returns the node ID stored under @p id
+     *        or @p nullptr if @p id is unknown.
+     */
+    node_id_ptr by_id(std::uint32_t id) const;
+
+    /**
+     * @brief Adds @p nid to the table unless it is full and returns the
+     *        ID denoting a new entry, i.e., <tt>size() + 1</tt> before
+     *        calling this member function.
+     */
+    std::uint32_t add(node_id_ptr nid);
+
+    /**
+     * @brief Returns the number of entries in the table.
+     */
+    inline size_t size() const {
+        return m_data.size();
+    }
+
+    /**
+     * @brief Removes all entries added after the table
+     *        had @p new_size elements.
+     */
+    void shrink(size_t new_size);
+
+ private:
+
+    struct hash {
+        size_t operator()(const node_id* ptr) const;
+    };
+
+    struct equal {
+        inline bool operator()(const node_id* lhs, const node_id* rhs) const {
+            return *lhs == *rhs;
+        }
+    };
+
+    // entry i has the ID i + 1
+    std::vector<node_id_ptr> m_data;
+
+    // maps the node IDs in m_data to their index + 1
+    std::unordered_map<const node_id*, std::uint32_t, hash, equal> m_ids;
+
+};
+
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_WIRE_FORMAT_HPP
@@ -16,6 +16,8 @@
 \******************************************************************************/
 
 
+#include "boost/actor/message.hpp"
+#include "boost/actor/message_header.hpp"
 #include "boost/actor/abstract_channel.hpp"
 
 namespace boost {
@@ -23,5 +25,12 @@ namespace actor {
 
 abstract_channel::~abstract_channel() { }
 
+bool abstract_channel::try_enqueue(msg_hdr_cref header,
+                                   message content,
+                                   execution_unit* host) {
+    enqueue(header, std::move(content), host);
+    return true;
+}
+
 } // namespace actor
 } // namespace boost
@@ -45,6 +45,14 @@ void* message_data::mutable_native_data() {
     return nullptr;
 }
 
+bool message_data::unshared() const {
+    return unique();
+}
+
+std::pair<instance_wrapper*, void*> message_data::embedded_element() {
+    return {nullptr, nullptr};
+}
+
 std::string get_tuple_type_names(const detail::message_data& tup) {
     std::string result = "@<>";
     for (size_t i = 0; i < tup.size(); ++i) {
@@ -57,7 +65,7 @@ std::string get_tuple_type_names(const detail::message_data& tup) {
 
 message_data* message_data::ptr::get_detached() {
     auto p = m_ptr.get();
-    if (!p->unique()) {
+    if (!p->unshared()) {
         auto np = p->copy();
         m_ptr.reset(np);
         return np;
@@ -18,6 +18,8 @@
 
 #include <utility>
 
+#include "boost/thread/locks.hpp"
+
 #include "boost/actor/logging.hpp"
 #include "boost/actor/node_id.hpp"
 #include "boost/actor/serializer.hpp"
@@ -34,39 +36,39 @@
 namespace boost {
 namespace actor {
 
+namespace {
+
+typedef lock_guard<detail::shared_spinlock> exclusive_guard;
+typedef shared_lock<detail::shared_spinlock> shared_guard;
+
+} // namespace <anonymous>
+
 void actor_namespace::write(serializer* sink, const actor_addr& addr) {
     BOOST_ACTOR_REQUIRE(sink != nullptr);
     if (!addr) {
-        node_id::host_id_type zero;
-        std::fill(zero.begin(), zero.end(), 0);
-        sink->write_value(static_cast<uint32_t>(0));         // actor id
-        sink->write_value(static_cast<uint32_t>(0));         // process id
-        sink->write_raw(node_id::host_id_size, zero.data()); // host id
+        sink->write_value(static_cast<uint32_t>(0)); // actor id
+        sink->write_node_id(nullptr);                // node id
     }
     else {
         // register locally running actors to be able to deserialize them later
         if (!addr.is_remote()) {
             get_actor_registry()->put(addr.id(), detail::raw_access::get(addr));
         }
-        auto& pinf = addr.node();
-        sink->write_value(addr.id());                                  // actor id
-        sink->write_value(pinf.process_id());                          // process id
-        sink->write_raw(node_id::host_id_size, pinf.host_id().data()); // host id
+        sink->write_value(addr.id());        // actor id
+        sink->write_node_id(&addr.node());   // node id
     }
 }
 
 actor_addr actor_namespace::read(deserializer* source) {
     BOOST_ACTOR_REQUIRE(source != nullptr);
-    node_id::host_id_type hid;
-    auto aid = source->read<uint32_t>();                 // actor id
-    auto pid = source->read<uint32_t>();                 // process id
-    source->read_raw(node_id::host_id_size, hid.data()); // host id
+    auto aid = source->read<uint32_t>(); // actor id
+    auto nid = source->read_node_id();   // node id
     auto this_node = get_middleman()->node();
-    if (aid == 0 && pid == 0) {
-        // 0:0 identifies an invalid actor
+    if (!nid) {
+        // an invalid node identifies an invalid actor
         return invalid_actor_addr;
     }
-    else if (pid == this_node->process_id() && hid == this_node->host_id()) {
+    else if (*nid == *this_node) {
         // identifies this exact process on this host, ergo: local actor
         auto a = get_actor_registry()->get(aid);
         // might be invalid
@@ -75,21 +77,22 @@ actor_addr actor_namespace::read(deserializer* source) {
     }
     else {
         // identifies a remote actor; create proxy if needed
-        node_id_ptr tmp = new node_id{pid, hid};
-        return get_or_put(tmp, aid)->address();
+        return get_or_put(std::move(nid), aid)->address();
     }
 }
 
 size_t actor_namespace::count_proxies(const node_id& node) {
+    shared_guard guard(m_proxies_mtx);
     auto i = m_proxies.find(node);
     return (i != m_proxies.end()) ? i->second.size() : 0;
 }
 
 actor_proxy_ptr actor_namespace::get(const node_id& node, actor_id aid) {
-    auto& submap = m_proxies[node];
-    auto i = submap.find(aid);
-    if (i != submap.end()) {
-        return i->second;
+    shared_guard guard(m_proxies_mtx);
+    auto i = m_proxies.find(node);
+    if (i != m_proxies.end()) {
+        auto j = i->second.find(aid);
+        if (j != i->second.end()) return j->second;
     }
     return nullptr;
 }
@@ -97,9 +100,18 @@ actor_proxy_ptr actor_namespace::get(const node_id& node, actor_id aid) {
 actor_proxy_ptr actor_namespace::get_or_put(node_id_ptr node, actor_id aid) {
     auto result = get(*node, aid);
     if (result == nullptr && m_factory) {
-        auto ptr = m_factory(aid, node);
-        put(*node, aid, ptr);
-        result = ptr;
+        // neither the factory nor the callback runs under the lock,
+        // since both might access the namespace or wait for an event loop
+        auto proxy = m_factory(aid, node);
+        { // lifetime scope of guard
+            exclusive_guard guard(m_proxies_mtx);
+            // check again, another thread might have created the proxy
+            auto res = m_proxies[*node].insert(std::make_pair(aid, proxy));
+            result = res.first->second;
+            // our proxy is destroyed after releasing the lock
+            if (!res.second) return result;
+        }
+        if (m_new_element_callback) m_new_element_callback(aid, *node);
     }
     return result;
 }
@@ -107,40 +119,65 @@ actor_proxy_ptr actor_namespace::get_or_put(node_id_ptr node, actor_id aid) {
 void actor_namespace::put(const node_id& node,
                           actor_id aid,
                           const actor_proxy_ptr& proxy) {
-    auto& submap = m_proxies[node];
-    auto i = submap.find(aid);
-    if (i == submap.end()) {
-        submap.insert(std::make_pair(aid, proxy));
-        if (m_new_element_callback) m_new_element_callback(aid, node);
-    }
-    else {
-        BOOST_ACTOR_LOG_ERROR("proxy for " << aid << ":"
-                       << to_string(node) << " already exists");
+    { // lifetime scope of guard
+        exclusive_guard guard(m_proxies_mtx);
+        auto& submap = m_proxies[node];
+        if (!submap.insert(std::make_pair(aid, proxy)).second) {
+            BOOST_ACTOR_LOG_ERROR("proxy for " << aid << ":"
+                           << to_string(node) << " already exists");
+            return;
+        }
     }
+    if (m_new_element_callback) m_new_element_callback(aid, node);
 }
 
-auto actor_namespace::proxies(node_id& node) -> proxy_map& {
-    return m_proxies[node];
+auto actor_namespace::proxies(const node_id& node) -> proxy_map {
+    shared_guard guard(m_proxies_mtx);
+    auto i = m_proxies.find(node);
+    return (i != m_proxies.end()) ? i->second : proxy_map{};
 }
 
+// note: erased proxies are destroyed after releasing the lock,
+//       since destroying a proxy might access the namespace
+
 void actor_namespace::erase(const actor_proxy_ptr& proxy) {
     BOOST_ACTOR_LOG_TRACE("proxy = " << proxy.get());
+    actor_proxy_ptr erased;
+    exclusive_guard guard(m_proxies_mtx);
     auto i = m_proxies.find(proxy->node());
     if (i != m_proxies.end()) {
-        i->second.erase(proxy->id());
+        auto j = i->second.find(proxy->id());
+        // a surplus proxy created by get_or_put() must not
+        // erase the proxy that has been inserted instead
+        if (j != i->second.end() && j->second == proxy) {
+            erased.swap(j->second);
+            i->second.erase(j);
+        }
     }
 }
 
 void actor_namespace::erase(node_id& inf) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(inf, to_string));
-    m_proxies.erase(inf);
+    proxy_map erased;
+    exclusive_guard guard(m_proxies_mtx);
+    auto i = m_proxies.find(inf);
+    if (i != m_proxies.end()) {
+        erased.swap(i->second);
+        m_proxies.erase(i);
+    }
 }
 
 void actor_namespace::erase(node_id& inf, actor_id aid) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(inf, to_string) << ", " << BOOST_ACTOR_ARG(aid));
+    actor_proxy_ptr erased;
+    exclusive_guard guard(m_proxies_mtx);
     auto i = m_proxies.find(inf);
     if (i != m_proxies.end()) {
-        i->second.erase(aid);
+        auto j = i->second.find(aid);
+        if (j != i->second.end()) {
+            erased.swap(j->second);
+            i->second.erase(j);
+        }
     }
 }
 
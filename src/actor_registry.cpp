@@ -27,7 +27,7 @@
 #include "boost/actor/exit_reason.hpp"
 #include "boost/actor/detail/actor_registry.hpp"
 
-#include "boost/actor/detail/shared_spinlock.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
 
 namespace boost {
 namespace actor {
@@ -35,10 +35,8 @@ namespace detail {
 
 namespace {
 
-typedef lock_guard<detail::shared_spinlock> exclusive_guard;
-typedef shared_lock<detail::shared_spinlock> shared_guard;
-typedef upgrade_lock<detail::shared_spinlock> upgrade_guard;
-typedef upgrade_to_unique_lock<detail::shared_spinlock> upgrade_to_unique_guard;
+typedef lock_guard<detail::scalable_rw_lock> exclusive_guard;
+typedef shared_lock<detail::scalable_rw_lock> shared_guard;
 
 } // namespace <anonymous>
 
@@ -47,28 +45,34 @@ actor_registry::~actor_registry() { }
 actor_registry::actor_registry() : m_running(0), m_ids(1) { }
 
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
-    shared_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
-        return i->second;
+    auto& s = shard_of(key);
+    shared_guard guard(s.mtx);
+    auto i = s.live.find(key);
+    if (i != s.live.end()) {
+        return {i->second, exit_reason::not_exited};
     }
-    BOOST_ACTOR_LOG_DEBUG("key not found: " << key);
-    return {nullptr, exit_reason::not_exited};
+    auto reason = find_tombstone(s, key);
+    if (reason == exit_reason::not_exited) {
+        BOOST_ACTOR_LOG_DEBUG("key not found: " << key);
+    }
+    return {nullptr, reason};
 }
 
 void actor_registry::put(actor_id key, const abstract_actor_ptr& value) {
-    bool add_attachable = false;
-    if (value != nullptr) {
-        upgrade_guard guard(m_instances_mtx);
-        auto i = m_entries.find(key);
-        if (i == m_entries.end()) {
-            auto entry = std::make_pair(key,
-                                        value_type(value,
-                                                   exit_reason::not_exited));
-            upgrade_to_unique_guard uguard(guard);
-            add_attachable = m_entries.insert(entry).second;
+    if (value == nullptr) return;
+    auto& s = shard_of(key);
+    { // fast path: actors are put each time they are serialized
+        shared_guard guard(s.mtx);
+        if (   s.live.count(key) > 0
+            || find_tombstone(s, key) != exit_reason::not_exited) {
+            return;
         }
     }
+    bool add_attachable;
+    { // lifetime scope of guard
+        exclusive_guard guard(s.mtx);
+        add_attachable = s.live.emplace(key, value).second;
+    }
     if (add_attachable) {
         BOOST_ACTOR_LOG_INFO("added actor with ID " << key);
         struct eraser : attachable {
@@ -87,14 +91,29 @@ void actor_registry::put(actor_id key, const abstract_actor_ptr& value) {
 }
 
 void actor_registry::erase(actor_id key, std::uint32_t reason) {
-    exclusive_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
-        auto& entry = i->second;
+    abstract_actor_ptr ptr; // destroyed outside of the critical section
+    auto& s = shard_of(key);
+    exclusive_guard guard(s.mtx);
+    auto i = s.live.find(key);
+    if (i != s.live.end()) {
         BOOST_ACTOR_LOG_INFO("erased actor with ID " << key << ", reason " << reason);
-        entry.first = nullptr;
-        entry.second = reason;
+        ptr.swap(i->second);
+        s.live.erase(i);
+        if (s.exited[s.current].size() >= max_tombstones) {
+            // start a new epoch by dropping the oldest generation
+            s.current = 1 - s.current;
+            s.exited[s.current].clear();
+        }
+        s.exited[s.current].emplace(key, reason);
+    }
+}
+
+std::uint32_t actor_registry::find_tombstone(const shard& s, actor_id key) {
+    for (auto& gen : s.exited) {
+        auto i = gen.find(key);
+        if (i != gen.end()) return i->second;
     }
+    return exit_reason::not_exited;
 }
 
 std::uint32_t actor_registry::next_id() {
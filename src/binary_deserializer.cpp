@@ -16,6 +16,7 @@
 \******************************************************************************/
 
 
+#include <limits>
 #include <string>
 #include <cstdint>
 #include <cstring>
@@ -127,18 +128,149 @@ pointer read_range(pointer begin, pointer end, std::u32string& storage) {
     return read_unicode_string<uint32_t>(begin, end, storage);
 }
 
+// reads an unsigned LEB128 varint
+pointer read_varint(pointer begin, pointer end, std::uint64_t& storage) {
+    storage = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+        if (shift > 63) {
+            throw std::out_of_range("binary_deserializer: varint too long");
+        }
+        std::uint8_t byte;
+        begin = read_range(begin, end, byte);
+        storage |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return begin;
+    }
+}
+
+template<typename T>
+T narrowed(std::uint64_t value) {
+    if (value > std::numeric_limits<T>::max()) {
+        throw std::out_of_range("binary_deserializer: varint out of range");
+    }
+    return static_cast<T>(value);
+}
+
+template<typename T>
+T zig_zag_decode(std::uint64_t value, std::true_type) {
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+    auto uval = narrowed<unsigned_type>(value);
+    auto sign = static_cast<unsigned_type>(0) - (uval & 1);
+    return static_cast<T>(static_cast<unsigned_type>(uval >> 1) ^ sign);
+}
+
+template<typename T>
+T zig_zag_decode(std::uint64_t value, std::false_type) {
+    return narrowed<T>(value);
+}
+
+pointer read_size(pointer begin, pointer end, wire_format format,
+                  std::uint32_t& storage) {
+    if (format == wire_format::v1) return read_range(begin, end, storage);
+    std::uint64_t tmp;
+    begin = read_varint(begin, end, tmp);
+    storage = narrowed<std::uint32_t>(tmp);
+    return begin;
+}
+
+// reads values written with wire_format::v2
+struct v2_reader {
+
+    template<typename T>
+    static pointer read(pointer begin, pointer end, T& storage,
+                        typename std::enable_if<std::is_integral<T>::value>::type* = 0) {
+        if (sizeof(T) == 1) return read_range(begin, end, storage);
+        std::uint64_t tmp;
+        begin = read_varint(begin, end, tmp);
+        storage = zig_zag_decode<T>(tmp, std::is_signed<T>{});
+        return begin;
+    }
+
+    template<typename T>
+    static pointer read(pointer begin, pointer end, T& storage,
+                        typename std::enable_if<std::is_floating_point<T>::value>::type* = 0) {
+        return read_range(begin, end, storage);
+    }
+
+    static pointer read(pointer begin, pointer end, long double& storage) {
+        std::string tmp;
+        begin = read(begin, end, tmp);
+        std::istringstream iss{std::move(tmp)};
+        iss >> storage;
+        return begin;
+    }
+
+    static pointer read(pointer begin, pointer end, std::string& storage) {
+        std::uint32_t str_size;
+        begin = read_size(begin, end, wire_format::v2, str_size);
+        range_check(begin, end, str_size);
+        storage.assign(as_char_pointer(begin), str_size);
+        return advanced(begin, str_size);
+    }
+
+    template<typename CharType, typename StringType>
+    static pointer read_unicode(pointer begin, pointer end, StringType& str) {
+        std::uint32_t str_size;
+        begin = read_size(begin, end, wire_format::v2, str_size);
+        str.clear();
+        str.reserve(str_size);
+        for (size_t i = 0; i < str_size; ++i) {
+            CharType c;
+            begin = read_range(begin, end, c);
+            str += static_cast<typename StringType::value_type>(c);
+        }
+        return begin;
+    }
+
+    static pointer read(pointer begin, pointer end, std::u16string& storage) {
+        return read_unicode<uint16_t>(begin, end, storage);
+    }
+
+    static pointer read(pointer begin, pointer end, std::u32string& storage) {
+        return read_unicode<uint32_t>(begin, end, storage);
+    }
+
+    // see binary_writer::operator()(const atom_value&)
+    static pointer read(pointer begin, pointer end, atom_value& storage) {
+        std::uint8_t first;
+        read_range(begin, end, first);
+        std::uint64_t num_chars = first & 0x0F;
+        if (num_chars == 0x0F) {
+            std::uint64_t tmp;
+            begin = read_range(advanced(begin, 1), end, tmp);
+            storage = static_cast<atom_value>(tmp);
+            return begin;
+        }
+        if (num_chars > 10) {
+            throw std::out_of_range("binary_deserializer: invalid atom");
+        }
+        auto len = (4 + 6 * num_chars + 7) / 8;
+        range_check(begin, end, len);
+        auto bytes = reinterpret_cast<const std::uint8_t*>(begin);
+        std::uint64_t packed = 0;
+        for (size_t i = 0; i < len; ++i) {
+            packed |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        storage = static_cast<atom_value>(packed >> 4);
+        return advanced(begin, len);
+    }
+
+};
+
 struct pt_reader : static_visitor<> {
 
     pointer begin;
     pointer end;
+    wire_format format;
 
-    pt_reader(pointer bbegin, pointer bend) : begin(bbegin), end(bend) { }
+    pt_reader(pointer bbegin, pointer bend, wire_format fmt)
+    : begin(bbegin), end(bend), format(fmt) { }
 
     inline void operator()(none_t&) { }
 
     template<typename T>
     inline void operator()(T& value) {
-        begin = read_range(begin, end, value);
+        if (format == wire_format::v2) begin = v2_reader::read(begin, end, value);
+        else begin = read_range(begin, end, value);
     }
 
 };
@@ -147,20 +279,45 @@ struct pt_reader : static_visitor<> {
 
 binary_deserializer::binary_deserializer(const void* buf, size_t buf_size,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(buf), m_end(advanced(buf, buf_size)) { }
+                                         type_lookup_table* tbl,
+                                         wire_format format,
+                                         node_id_table* node_ids)
+: super(ns, tbl), m_pos(buf), m_end(advanced(buf, buf_size))
+, m_format(format), m_node_ids(node_ids) { }
 
 binary_deserializer::binary_deserializer(const void* bbegin, const void* bend,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(bbegin), m_end(bend) { }
+                                         type_lookup_table* tbl,
+                                         wire_format format,
+                                         node_id_table* node_ids)
+: super(ns, tbl), m_pos(bbegin), m_end(bend)
+, m_format(format), m_node_ids(node_ids) { }
 
 const uniform_type_info* binary_deserializer::begin_object() {
-    std::uint8_t flag;
-    m_pos = read_range(m_pos, m_end, flag);
-    if (flag == 1) {
-        std::string tname;
-        m_pos = read_range(m_pos, m_end, tname);
+    bool by_name;
+    std::uint32_t type_id = 0;
+    std::string tname;
+    if (m_format == wire_format::v2) {
+        // the lowest bit distinguishes type IDs (0) from type names (1)
+        std::uint64_t tmp;
+        m_pos = read_varint(m_pos, m_end, tmp);
+        by_name = (tmp & 1) != 0;
+        auto value = narrowed<std::uint32_t>(tmp >> 1);
+        if (by_name) {
+            range_check(m_pos, m_end, value);
+            tname.assign(as_char_pointer(m_pos), value);
+            m_pos = advanced(m_pos, value);
+        }
+        else type_id = value;
+    }
+    else {
+        std::uint8_t flag;
+        m_pos = read_range(m_pos, m_end, flag);
+        by_name = flag == 1;
+        if (by_name) m_pos = read_range(m_pos, m_end, tname);
+        else m_pos = read_range(m_pos, m_end, type_id);
+    }
+    if (by_name) {
         auto uti = get_uniform_type_info_map()->by_uniform_name(tname);
         if (!uti) {
             std::string err = "received type name \"";
@@ -171,8 +328,6 @@ const uniform_type_info* binary_deserializer::begin_object() {
         return uti;
     }
     else {
-        std::uint32_t type_id;
-        m_pos = read_range(m_pos, m_end, type_id);
         auto it = incoming_types();
         if (!it) {
             std::string err = "received type ID ";
@@ -193,14 +348,14 @@ size_t binary_deserializer::begin_sequence() {
     static_assert(sizeof(size_t) >= sizeof(uint32_t),
                   "sizeof(size_t) < sizeof(uint32_t)");
     uint32_t result;
-    m_pos = read_range(m_pos, m_end, result);
+    m_pos = read_size(m_pos, m_end, m_format, result);
     return static_cast<size_t>(result);
 }
 
 void binary_deserializer::end_sequence() { }
 
 void binary_deserializer::read_value(primitive_variant& storage) {
-    pt_reader ptr(m_pos, m_end);
+    pt_reader ptr(m_pos, m_end, m_format);
     apply_visitor(ptr, storage);
     m_pos = ptr.begin;
 }
@@ -211,5 +366,27 @@ void binary_deserializer::read_raw(size_t num_bytes, void* storage) {
     m_pos = advanced(m_pos, num_bytes);
 }
 
+node_id_ptr binary_deserializer::read_node_id() {
+    if (m_format == wire_format::v1 || m_node_ids == nullptr) {
+        return super::read_node_id();
+    }
+    // see binary_serializer::write_node_id
+    std::uint64_t tmp;
+    m_pos = read_varint(m_pos, m_end, tmp);
+    if (tmp == 0) return nullptr;
+    auto id = narrowed<std::uint32_t>(tmp);
+    if (id <= m_node_ids->size()) return m_node_ids->by_id(id);
+    if (id != m_node_ids->size() + 1) {
+        throw std::runtime_error("received unknown node id");
+    }
+    m_pos = read_varint(m_pos, m_end, tmp);
+    auto pid = narrowed<std::uint32_t>(tmp);
+    node_id::host_id_type hid;
+    read_raw(node_id::host_id_size, hid.data());
+    node_id_ptr result = new node_id{pid, hid};
+    m_node_ids->add(result);
+    return result;
+}
+
 } // namespace actor
 } // namespace boost
@@ -42,23 +42,68 @@ class binary_writer : public static_visitor<> {
 
  public:
 
-    binary_writer(io::buffer* sink) : m_sink(sink) { }
+    binary_writer(io::buffer* sink, wire_format format)
+    : m_sink(sink), m_format(format) { }
 
     template<typename T>
     static inline void write_int(io::buffer* sink, const T& value) {
         sink->write(sizeof(T), &value, io::grow_if_needed);
     }
 
-    static inline void write_string(io::buffer* sink,
+    // writes an unsigned integer as LEB128 varint
+    static inline void write_varint(io::buffer* sink, std::uint64_t value) {
+        std::uint8_t buf[10];
+        size_t pos = 0;
+        while (value >= 0x80) {
+            buf[pos++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        buf[pos++] = static_cast<std::uint8_t>(value);
+        sink->write(pos, buf, io::grow_if_needed);
+    }
+
+    // zig-zag encoding maps small negative values to small varints
+    template<typename T>
+    static inline std::uint64_t zig_zag(T value, std::true_type) {
+        typedef typename std::make_unsigned<T>::type unsigned_type;
+        auto uval = static_cast<unsigned_type>(value);
+        auto sign = static_cast<unsigned_type>(value < 0 ? -1 : 0);
+        return static_cast<unsigned_type>(uval << 1) ^ sign;
+    }
+
+    template<typename T>
+    static inline std::uint64_t zig_zag(T value, std::false_type) {
+        return value;
+    }
+
+    // writes @p value using the integer encoding of @p format
+    template<typename T>
+    static inline void write_integer(io::buffer* sink, wire_format format,
+                                     T value) {
+        if (format == wire_format::v1 || sizeof(T) == 1) {
+            write_int(sink, value);
+        }
+        else write_varint(sink, zig_zag(value, std::is_signed<T>{}));
+    }
+
+    static inline void write_size(io::buffer* sink, wire_format format,
+                                  size_t value) {
+        if (format == wire_format::v1) {
+            write_int(sink, static_cast<std::uint32_t>(value));
+        }
+        else write_varint(sink, value);
+    }
+
+    static inline void write_string(io::buffer* sink, wire_format format,
                                     const std::string& str) {
-        write_int(sink, static_cast<std::uint32_t>(str.size()));
+        write_size(sink, format, str.size());
         sink->write(str.size(), str.c_str(), io::grow_if_needed);
     }
 
     template<typename T>
     void operator()(const T& value,
                     typename std::enable_if<std::is_integral<T>::value>::type* = 0) const {
-        write_int(m_sink, value);
+        write_integer(m_sink, m_format, value);
     }
 
     template<typename T>
@@ -73,19 +118,41 @@ class binary_writer : public static_visitor<> {
     void operator()(const long double& v) const {
         std::ostringstream oss;
         oss << std::setprecision(std::numeric_limits<long double>::digits) << v;
-        write_string(m_sink, oss.str());
+        write_string(m_sink, m_format, oss.str());
     }
 
     void operator()(const atom_value& val) const {
-        (*this)(static_cast<uint64_t>(val));
+        auto value = static_cast<uint64_t>(val);
+        if (m_format == wire_format::v1) {
+            write_int(m_sink, value);
+            return;
+        }
+        // v2 stores the number of 6-bit characters in the lower 4 bits
+        // of the first byte followed by the characters themselves,
+        // i.e., an atom with N characters needs (4 + 6 * N + 7) / 8 bytes
+        std::uint64_t num_chars = 0;
+        for (auto tmp = value; tmp != 0; tmp >>= 6) ++num_chars;
+        if (num_chars > 10) {
+            // not created by atom(), use nibble 0xF and write all 64 bit
+            write_int(m_sink, static_cast<std::uint8_t>(0x0F));
+            write_int(m_sink, value);
+            return;
+        }
+        auto packed = (value << 4) | num_chars;
+        std::uint8_t buf[8];
+        auto len = (4 + 6 * num_chars + 7) / 8;
+        for (size_t i = 0; i < len; ++i) {
+            buf[i] = static_cast<std::uint8_t>(packed >> (8 * i));
+        }
+        m_sink->write(len, buf, io::grow_if_needed);
     }
 
     void operator()(const std::string& str) const {
-        write_string(m_sink, str);
+        write_string(m_sink, m_format, str);
     }
 
     void operator()(const std::u16string& str) const {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
+        write_size(m_sink, m_format, str.size());
         for (char16_t c : str) {
             // force writer to use exactly 16 bit
             write_int(m_sink, static_cast<std::uint16_t>(c));
@@ -93,7 +160,7 @@ class binary_writer : public static_visitor<> {
     }
 
     void operator()(const std::u32string& str) const {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
+        write_size(m_sink, m_format, str.size());
         for (char32_t c : str) {
             // force writer to use exactly 32 bit
             write_int(m_sink, static_cast<std::uint32_t>(c));
@@ -103,6 +170,7 @@ class binary_writer : public static_visitor<> {
  private:
 
     io::buffer* m_sink;
+    wire_format m_format;
 
 };
 
@@ -110,29 +178,42 @@ class binary_writer : public static_visitor<> {
 
 binary_serializer::binary_serializer(io::buffer* buf,
                                      actor_namespace* ns,
-                                     type_lookup_table* tbl)
-: super(ns, tbl), m_sink(buf) { }
+                                     type_lookup_table* tbl,
+                                     wire_format format,
+                                     node_id_table* node_ids)
+: super(ns, tbl), m_sink(buf), m_format(format), m_node_ids(node_ids) { }
 
 void binary_serializer::begin_object(const uniform_type_info* uti) {
     BOOST_ACTOR_REQUIRE(uti != nullptr);
     auto ot = outgoing_types();
     std::uint32_t id = (ot) ? ot->id_of(uti) : 0;
+    if (m_format == wire_format::v2) {
+        // the lowest bit distinguishes type IDs (0) from type names (1)
+        if (id != 0) binary_writer::write_varint(m_sink, std::uint64_t{id} << 1);
+        else {
+            auto tname = uti->name();
+            auto len = strlen(tname);
+            binary_writer::write_varint(m_sink, (len << 1) | 1);
+            m_sink->write(len, tname, io::grow_if_needed);
+        }
+        return;
+    }
     std::uint8_t flag = (id == 0) ? 1 : 0;
     binary_writer::write_int(m_sink, flag);
-    if (flag == 1) binary_writer::write_string(m_sink, uti->name());
+    if (flag == 1) binary_writer::write_string(m_sink, m_format, uti->name());
     else binary_writer::write_int(m_sink, id);
 }
 
 void binary_serializer::end_object() { }
 
 void binary_serializer::begin_sequence(size_t list_size) {
-    binary_writer::write_int(m_sink, static_cast<std::uint32_t>(list_size));
+    binary_writer::write_size(m_sink, m_format, list_size);
 }
 
 void binary_serializer::end_sequence() { }
 
 void binary_serializer::write_value(const primitive_variant& value) {
-    apply_visitor(binary_writer(m_sink), value);
+    apply_visitor(binary_writer(m_sink, m_format), value);
 }
 
 void binary_serializer::write_raw(size_t num_bytes, const void* data) {
@@ -147,5 +228,29 @@ void binary_serializer::write_tuple(size_t size,
     }
 }
 
+void binary_serializer::write_node_id(const node_id* nid) {
+    if (m_format == wire_format::v1 || m_node_ids == nullptr) {
+        super::write_node_id(nid);
+        return;
+    }
+    // 0 denotes an invalid node, known nodes are replaced by their index
+    // and new nodes are written as index of the new entry followed by
+    // process ID and host ID
+    if (nid == nullptr) {
+        binary_writer::write_varint(m_sink, 0);
+        return;
+    }
+    auto id = m_node_ids->id_of(*nid);
+    if (id != 0) {
+        binary_writer::write_varint(m_sink, id);
+        return;
+    }
+    id = m_node_ids->add(new node_id(*nid));
+    binary_writer::write_varint(m_sink, id);
+    binary_writer::write_varint(m_sink, nid->process_id());
+    m_sink->write(nid->host_id().size(), nid->host_id().data(),
+                  io::grow_if_needed);
+}
+
 } // namespace actor
 } // namespace boost
@@ -304,6 +304,159 @@ class broker::doorman : public broker::servant {
 // avoid weak-vtables warning by providing dtor out-of-line
 broker::doorman::~doorman() { }
 
+// sends and receives datagrams on behalf of the broker
+class broker::courier : public broker::servant {
+
+    typedef servant super;
+
+ public:
+
+    ~courier();
+
+    courier(broker_ptr parent, udp_socket_uptr ptr)
+    : super{std::move(parent), ptr->file_handle(), ptr->file_handle()}
+    , m_has_unwritten_data{false}, m_num_queued{0}, m_num_sent{0} {
+        m_read_msg = make_message(new_datagram_msg{});
+        read_msg().handle = id();
+        m_ptr.swap(ptr);
+    }
+
+    void dispose() override {
+        auto ptr = m_broker;
+        ptr->erase_udp(read_handle());
+    }
+
+    void max_datagram_size(size_t num_bytes) {
+        m_ptr->max_datagram_size(num_bytes);
+    }
+
+    continue_reading_result continue_reading() override {
+        BOOST_ACTOR_LOG_TRACE("");
+        for (;;) {
+            size_t num;
+            try { num = m_ptr->receive(); }
+            catch (std::ios_base::failure&) {
+                disconnect();
+                return continue_reading_result::failure;
+            }
+            BOOST_ACTOR_LOG_DEBUG("received " << num << " datagrams");
+            if (num == 0) return continue_reading_result::continue_later;
+            for (size_t i = 0; i < num; ++i) {
+                // stop reading if actor finished execution
+                if (m_broker->exit_reason() != exit_reason::not_exited) {
+                    BOOST_ACTOR_LOG_DEBUG("broker already done; exit reason: "
+                                   << m_broker->exit_reason());
+                    return continue_reading_result::closed;
+                }
+                // don't overwrite a datagram the broker kept a reference to
+                if (!m_read_msg.vals()->unique()) {
+                    BOOST_ACTOR_LOG_INFO("detached datagram");
+                    m_read_msg = make_message(new_datagram_msg{});
+                    read_msg().handle = id();
+                }
+                auto& msg = read_msg();
+                msg.remote = m_ptr->remote(i);
+                msg.buf.clear();
+                msg.buf.write(m_ptr->size(i), m_ptr->data(i));
+                m_broker->invoke_message({invalid_actor_addr, nullptr},
+                                         m_read_msg);
+            }
+        }
+    }
+
+    continue_writing_result continue_writing() override {
+        BOOST_ACTOR_LOG_TRACE("");
+        while (m_num_sent < m_num_queued) {
+            size_t num;
+            try {
+                num = m_ptr->send(m_queue.data() + m_num_sent,
+                                  m_num_queued - m_num_sent);
+            }
+            catch (std::exception& e) {
+                BOOST_ACTOR_LOG_ERROR(to_verbose_string(e));
+                static_cast<void>(e); // keep compiler happy
+                return continue_writing_result::failure;
+            }
+            m_num_sent += num;
+            if (m_num_sent < m_num_queued) {
+                BOOST_ACTOR_LOG_DEBUG("send buffer full, try again later");
+                return continue_writing_result::continue_later;
+            }
+        }
+        // keep buffers of a regular batch for subsequent writes
+        if (m_queue.size() > udp_socket::max_batch_size) {
+            m_queue.resize(udp_socket::max_batch_size);
+        }
+        m_num_queued = 0;
+        m_num_sent = 0;
+        m_has_unwritten_data = false;
+        return continue_writing_result::done;
+    }
+
+    void write(const ip_endpoint& remote, size_t num_bytes, const void* data) {
+        auto& dg = next_datagram(remote);
+        dg.buf.clear();
+        dg.buf.write(num_bytes, data);
+        register_for_writing();
+    }
+
+    void write(const ip_endpoint& remote, buffer&& buf) {
+        next_datagram(remote).buf = std::move(buf);
+        buf.clear();
+        register_for_writing();
+    }
+
+    new_datagram_msg& read_msg() {
+        return m_read_msg.get_as_mutable<new_datagram_msg>(0);
+    }
+
+    template<typename... Ts>
+    static std::unique_ptr<courier> make(Ts&&... args) {
+        return std::unique_ptr<courier>(new courier(std::forward<Ts>(args)...));
+    }
+
+    datagram_handle id() const {
+        return datagram_handle::from_int(read_handle());
+    }
+
+ protected:
+
+    message disconnect_message() override {
+        return make_message(datagram_closed_msg{id()});
+    }
+
+ private:
+
+    udp_socket::datagram& next_datagram(const ip_endpoint& remote) {
+        // reuse the buffers of previously sent datagrams
+        if (m_num_queued == m_queue.size()) m_queue.emplace_back();
+        auto& dg = m_queue[m_num_queued++];
+        dg.remote = remote;
+        return dg;
+    }
+
+    void register_for_writing() {
+        if (!m_has_unwritten_data) {
+            BOOST_ACTOR_LOG_DEBUG("register for writing");
+            m_has_unwritten_data = true;
+            // send all datagrams enqueued during the current
+            // event loop iteration at once
+            get_middleman()->flush_later(this);
+        }
+    }
+
+    udp_socket_uptr m_ptr;
+    message m_read_msg;
+    bool m_has_unwritten_data;
+    std::vector<udp_socket::datagram> m_queue;
+    size_t m_num_queued;
+    size_t m_num_sent;
+
+};
+
+// avoid weak-vtables warning by providing dtor out-of-line
+broker::courier::~courier() { }
+
 void broker::invoke_message(msg_hdr_cref hdr, message msg) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(msg, to_string));
     if (planned_exit_reason() != exit_reason::not_exited || bhvr_stack().empty()) {
@@ -422,10 +575,37 @@ void broker::write(const connection_handle& hdl, const buffer& buf) {
 }
 
 void broker::write(const connection_handle& hdl, buffer&& buf) {
-    write(hdl, buf.size(), buf.data());
+    auto i = m_io.find(hdl);
+    if (i != m_io.end()) i->second->write(std::move(buf));
     buf.clear();
 }
 
+void broker::write_datagram(const datagram_handle& hdl,
+                            const ip_endpoint& remote,
+                            size_t num_bytes, const void* buf) {
+    auto i = m_udp.find(hdl);
+    if (i != m_udp.end()) i->second->write(remote, num_bytes, buf);
+}
+
+void broker::write_datagram(const datagram_handle& hdl,
+                            const ip_endpoint& remote,
+                            const buffer& buf) {
+    write_datagram(hdl, remote, buf.size(), buf.data());
+}
+
+void broker::write_datagram(const datagram_handle& hdl,
+                            const ip_endpoint& remote,
+                            buffer&& buf) {
+    auto i = m_udp.find(hdl);
+    if (i != m_udp.end()) i->second->write(remote, std::move(buf));
+    buf.clear();
+}
+
+void broker::max_datagram_size(const datagram_handle& hdl, size_t num_bytes) {
+    auto i = m_udp.find(hdl);
+    if (i != m_udp.end()) i->second->max_datagram_size(num_bytes);
+}
+
 broker_ptr init_and_launch(broker_ptr ptr) {
     BOOST_ACTOR_PUSH_AID(ptr->id());
     BOOST_ACTOR_LOGF_TRACE("init and launch broker with id " << ptr->id());
@@ -446,6 +626,10 @@ broker_ptr init_and_launch(broker_ptr ptr) {
                 BOOST_ACTOR_LOGF_DEBUG("launch doorman " << kvp.second.get());
                 mm->continue_reader(kvp.second.get());
             }
+            for (auto& kvp : self->m_udp) {
+                BOOST_ACTOR_LOGF_DEBUG("launch courier " << kvp.second.get());
+                mm->continue_reader(kvp.second.get());
+            }
             self->m_initialized = true;
             // run user-defined initialization code
             auto bhvr = self->make_behavior();
@@ -477,6 +661,10 @@ void broker::erase_acceptor(int id) {
     m_accept.erase(accept_handle::from_int(id));
 }
 
+void broker::erase_udp(int id) {
+    m_udp.erase(datagram_handle::from_int(id));
+}
+
 connection_handle broker::add_connection(input_stream_ptr in, output_stream_ptr out) {
     using namespace std;
     auto id = connection_handle::from_int(in->read_handle());
@@ -510,6 +698,22 @@ accept_handle broker::add_acceptor(acceptor_uptr ptr) {
     return id;
 }
 
+datagram_handle broker::add_udp_endpoint(udp_socket_uptr ptr) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_MARG(ptr, get));
+    using namespace std;
+    auto id = datagram_handle::from_int(ptr->file_handle());
+    auto ires = m_udp.insert(make_pair(id, courier::make(this, std::move(ptr))));
+    BOOST_ACTOR_REQUIRE(ires.second == true);
+    // 'launch' backend only if broker is already initialized
+    if (initialized()) {
+        BOOST_ACTOR_LOG_DEBUG("launch courier " << ires.first->second.get());
+        auto cptr = ires.first->second.get();
+        auto mm = get_middleman();
+        mm->continue_reader(cptr);
+    }
+    return id;
+}
+
 actor broker::fork_impl(std::function<behavior (broker*)> fun,
                         connection_handle hdl) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_MARG(hdl, id));
@@ -0,0 +1,173 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#ifdef BOOST_ACTOR_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef BOOST_ACTOR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "boost/actor/io/compression.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+namespace {
+
+std::atomic<compression> s_algorithm{compression::none};
+std::atomic<size_t> s_threshold{512};
+// accessed via std::atomic_load and std::atomic_store only, because
+// the middleman threads report events while users set the hook
+std::shared_ptr<compression_hook> s_hook;
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+void report(compression algorithm, bool decompressed, size_t original_size,
+            size_t compressed_size, clock_type::time_point start) {
+    auto hook = std::atomic_load(&s_hook);
+    if (!hook) return;
+    auto t = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 clock_type::now() - start);
+    (*hook)(compression_event{algorithm, decompressed, original_size,
+                             compressed_size, t});
+}
+
+} // namespace <anonymous>
+
+std::uint32_t available_compressions() {
+    std::uint32_t result = 0;
+#   ifdef BOOST_ACTOR_HAVE_LZ4
+    result |= static_cast<std::uint32_t>(compression::lz4);
+#   endif
+#   ifdef BOOST_ACTOR_HAVE_ZLIB
+    result |= static_cast<std::uint32_t>(compression::zlib);
+#   endif
+    return result;
+}
+
+void compression_algorithm(compression algorithm) {
+    auto mask = static_cast<std::uint32_t>(algorithm);
+    if ((available_compressions() & mask) != mask) {
+        throw std::invalid_argument("compression algorithm not available");
+    }
+    s_algorithm = algorithm;
+}
+
+compression compression_algorithm() {
+    return s_algorithm;
+}
+
+void compression_threshold(size_t num_bytes) {
+    s_threshold = num_bytes;
+}
+
+size_t compression_threshold() {
+    return s_threshold;
+}
+
+void set_compression_hook(compression_hook hook) {
+    std::shared_ptr<compression_hook> ptr;
+    if (hook) ptr = std::make_shared<compression_hook>(std::move(hook));
+    std::atomic_store(&s_hook, std::move(ptr));
+}
+
+bool compress(compression algorithm, const void* data, size_t num_bytes,
+              std::vector<char>& storage) {
+    auto start = clock_type::now();
+    size_t result = 0;
+    switch (algorithm) {
+        default:
+            return false;
+#       ifdef BOOST_ACTOR_HAVE_LZ4
+        case compression::lz4: {
+            auto bound = LZ4_compressBound(static_cast<int>(num_bytes));
+            if (bound <= 0) return false;
+            storage.resize(static_cast<size_t>(bound));
+            auto res = LZ4_compress_default(reinterpret_cast<const char*>(data),
+                                            storage.data(),
+                                            static_cast<int>(num_bytes),
+                                            bound);
+            if (res <= 0) return false;
+            result = static_cast<size_t>(res);
+            break;
+        }
+#       endif
+#       ifdef BOOST_ACTOR_HAVE_ZLIB
+        case compression::zlib: {
+            auto bound = compressBound(static_cast<uLong>(num_bytes));
+            storage.resize(bound);
+            auto dest_len = static_cast<uLongf>(bound);
+            auto res = compress2(reinterpret_cast<Bytef*>(storage.data()),
+                                 &dest_len,
+                                 reinterpret_cast<const Bytef*>(data),
+                                 static_cast<uLong>(num_bytes),
+                                 Z_BEST_SPEED);
+            if (res != Z_OK) return false;
+            result = static_cast<size_t>(dest_len);
+            break;
+        }
+#       endif
+    }
+    report(algorithm, false, num_bytes, result, start);
+    if (result >= num_bytes) return false;
+    storage.resize(result);
+    return true;
+}
+
+bool decompress(compression algorithm, const void* data, size_t num_bytes,
+                void* storage, size_t original_size) {
+    auto start = clock_type::now();
+    switch (algorithm) {
+        default:
+            return false;
+#       ifdef BOOST_ACTOR_HAVE_LZ4
+        case compression::lz4: {
+            auto res = LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+                                           reinterpret_cast<char*>(storage),
+                                           static_cast<int>(num_bytes),
+                                           static_cast<int>(original_size));
+            if (res < 0 || static_cast<size_t>(res) != original_size) {
+                return false;
+            }
+            break;
+        }
+#       endif
+#       ifdef BOOST_ACTOR_HAVE_ZLIB
+        case compression::zlib: {
+            auto dest_len = static_cast<uLongf>(original_size);
+            auto res = uncompress(reinterpret_cast<Bytef*>(storage), &dest_len,
+                                  reinterpret_cast<const Bytef*>(data),
+                                  static_cast<uLong>(num_bytes));
+            if (res != Z_OK || dest_len != original_size) return false;
+            break;
+        }
+#       endif
+    }
+    report(algorithm, true, original_size, num_bytes, start);
+    return true;
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
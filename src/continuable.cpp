@@ -25,7 +25,7 @@ namespace io {
 continuable::~continuable() { }
 
 continuable::continuable(native_socket_type rd, native_socket_type wr)
-: m_rd(rd), m_wr(wr) { }
+: m_rd(rd), m_wr(wr), m_doorbell(false) { }
 
 continue_reading_result continuable::continue_reading() {
     return continue_reading_result::closed;
@@ -0,0 +1,84 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "boost/actor/config.hpp"
+#include "boost/actor/detail/cpu_affinity.hpp"
+
+#ifdef BOOST_ACTOR_LINUX
+
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+#include <sched.h>
+#include <dirent.h>
+#include <pthread.h>
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+bool set_thread_affinity(const std::vector<size_t>& cpus) {
+    if (cpus.empty()) return false;
+    cpu_set_t cs;
+    CPU_ZERO(&cs);
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cs);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cs), &cs) == 0;
+}
+
+size_t numa_node_of(size_t cpu) {
+    // sysfs lists a 'node<N>' link in the directory of each CPU
+    auto path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    auto dir = opendir(path.c_str());
+    if (!dir) return 0;
+    size_t result = 0;
+    for (auto entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "node", 4) == 0) {
+            result = strtoul(entry->d_name + 4, nullptr, 10);
+            break;
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#else // BOOST_ACTOR_LINUX
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+bool set_thread_affinity(const std::vector<size_t>&) {
+    return false;
+}
+
+size_t numa_node_of(size_t) {
+    return 0;
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
+
+#endif // BOOST_ACTOR_LINUX
@@ -17,6 +17,7 @@
 
 
 #include <string>
+#include <algorithm>
 
 #include "boost/actor/deserializer.hpp"
 #include "boost/actor/uniform_type_info.hpp"
@@ -33,6 +34,18 @@ deserializer::deserializer(actor_namespace* ns, type_lookup_table* ot)
 
 deserializer::~deserializer() { }
 
+node_id_ptr deserializer::read_node_id() {
+    node_id::host_id_type hid;
+    auto pid = read<std::uint32_t>();
+    read_raw(node_id::host_id_size, hid.data());
+    auto is_zero = [](std::uint8_t value) { return value == 0; };
+    if (pid == 0 && std::all_of(hid.begin(), hid.end(), is_zero)) {
+        // invalid process information (nullptr)
+        return nullptr;
+    }
+    return new node_id{pid, hid};
+}
+
 void deserializer::read_raw(size_t num_bytes, io::buffer& storage) {
     storage.acquire(num_bytes);
     read_raw(num_bytes, storage.data());
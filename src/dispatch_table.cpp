@@ -0,0 +1,132 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <memory>
+#include <algorithm>
+
+#include "boost/actor/atom.hpp"
+#include "boost/actor/uniform_type_info.hpp"
+
+#include "boost/actor/detail/dispatch_table.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+namespace {
+
+constexpr size_t initial_capacity = 16;
+
+} // namespace <anonymous>
+
+dispatch_table::dispatch_table() : m_table(nullptr), m_size(0) { }
+
+dispatch_table::~dispatch_table() {
+    auto ptr = m_table.load();
+    while (ptr) {
+        auto prev = ptr->prev;
+        delete ptr;
+        ptr = prev;
+    }
+}
+
+void dispatch_table::emplace(const message_data& msg, bitmask mask) {
+    std::lock_guard<std::mutex> guard{m_mtx};
+    // another thread might have stored the signature of msg in the meantime
+    if (find(msg)) return;
+    auto tbl = reserve(m_size.load(std::memory_order_relaxed) + 1);
+    auto token = msg.dynamically_typed() ? nullptr : msg.type_token();
+    auto h = hash_of(token, msg);
+    auto& e = free_slot(*tbl, h);
+    e.hash = h;
+    e.token = token;
+    e.mask = mask;
+    if (token == nullptr) {
+        e.types.reserve(msg.size());
+        for (size_t i = 0; i < msg.size(); ++i) {
+            e.types.push_back(msg.type_at(i));
+        }
+    }
+    // readers probe tbl concurrently and must not see a partial entry
+    e.used.store(true, std::memory_order_release);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+dispatch_table::entry& dispatch_table::free_slot(table& tbl, size_t hash) {
+    auto mod = tbl.capacity - 1;
+    auto i = hash & mod;
+    while (tbl.entries[i].used.load(std::memory_order_relaxed)) {
+        i = (i + 1) & mod;
+    }
+    return tbl.entries[i];
+}
+
+dispatch_table::table* dispatch_table::reserve(size_t new_size) {
+    auto base = m_table.load(std::memory_order_relaxed);
+    // keep the load factor at or below 1/2
+    if (base && new_size * 2 <= base->capacity) return base;
+    auto capacity = base ? base->capacity * 2 : initial_capacity;
+    std::unique_ptr<table> next{new table(base, capacity)};
+    if (base) {
+        for (size_t i = 0; i < base->capacity; ++i) {
+            auto& x = base->entries[i];
+            if (!x.used.load(std::memory_order_relaxed)) continue;
+            auto& y = free_slot(*next, x.hash);
+            y.hash = x.hash;
+            y.token = x.token;
+            y.mask = x.mask;
+            y.types = x.types;
+            // published as a whole by storing next to m_table below
+            y.used.store(true, std::memory_order_relaxed);
+        }
+    }
+    // readers probe base concurrently, i.e., it stays alive
+    // as part of the chain of tables until destruction
+    m_table.store(next.get(), std::memory_order_release);
+    return next.release();
+}
+
+std::uint64_t dispatch_table::leading_atom(const message_data& msg) {
+    static auto atom_type = uniform_typeid<atom_value>();
+    if (msg.size() > 0 && msg.type_at(0) == atom_type) {
+        auto value = *reinterpret_cast<const atom_value*>(msg.at(0));
+        return static_cast<std::uint64_t>(value);
+    }
+    return 0;
+}
+
+std::uint64_t dispatch_table::dynamic_hash(const message_data& msg) {
+    std::uint64_t result = msg.size();
+    for (size_t i = 0; i < msg.size(); ++i) {
+        auto uti = reinterpret_cast<std::uintptr_t>(msg.type_at(i));
+        result = (result * 31) ^ uti;
+    }
+    return result;
+}
+
+bool dispatch_table::same_types(const entry& e, const message_data& msg) {
+    if (e.types.size() != msg.size()) return false;
+    for (size_t i = 0; i < msg.size(); ++i) {
+        if (e.types[i] != msg.type_at(i)) return false;
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
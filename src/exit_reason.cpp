@@ -27,11 +27,12 @@ namespace { constexpr const char* s_names_table[] = {
     "unhandled_exception",
     "unallowed_function_call",
     "unhandled_sync_failure",
-    "unhandled_sync_timeout"
+    "unhandled_sync_timeout",
+    "mailbox_overflow"
 }; }
 
 const char* as_string(std::uint32_t value) {
-    if (value <= unhandled_sync_timeout) return s_names_table[value];
+    if (value <= mailbox_overflow) return s_names_table[value];
     if (value == remote_link_unreachable) return "remote_link_unreachable";
     if (value >= user_defined) return "user_defined";
     return "illegal_exit_reason";
@@ -87,6 +87,16 @@ void handle_read_result(ssize_t res, bool is_nonblock) {
     if (res == 0) throw_io_failure("cannot read from closed file descriptor");
 }
 
+int socket_error(native_socket_type fd) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR,
+                   reinterpret_cast<socket_recv_ptr>(&err), &len) < 0) {
+        return last_socket_error();
+    }
+    return err;
+}
+
 #ifndef BOOST_WINDOWS // Linux or Mac OS
 
 std::string last_socket_error_as_string() {
@@ -16,6 +16,8 @@
 \******************************************************************************/
 
 
+#include <atomic>
+
 #include "boost/actor/group.hpp"
 #include "boost/actor/channel.hpp"
 #include "boost/actor/message.hpp"
@@ -26,6 +28,20 @@
 namespace boost {
 namespace actor {
 
+namespace {
+
+std::atomic<size_t> s_parallel_fan_out_threshold{0};
+
+} // namespace <anonymous>
+
+void parallel_fan_out_threshold(size_t num_subscribers) {
+    s_parallel_fan_out_threshold = num_subscribers;
+}
+
+size_t parallel_fan_out_threshold() {
+    return s_parallel_fan_out_threshold;
+}
+
 group::group(const invalid_group_t&) : m_ptr(nullptr) { }
 
 group::group(abstract_group_ptr ptr) : m_ptr(std::move(ptr)) { }
@@ -18,6 +18,7 @@
 
 #include <set>
 #include <mutex>
+#include <vector>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
@@ -46,14 +47,59 @@ namespace detail {
 
 namespace {
 
-typedef lock_guard<detail::shared_spinlock> exclusive_guard;
-typedef shared_lock<detail::shared_spinlock> shared_guard;
-typedef upgrade_lock<detail::shared_spinlock> upgrade_guard;
-typedef upgrade_to_unique_lock<detail::shared_spinlock> upgrade_to_unique_guard;
+typedef lock_guard<detail::scalable_rw_lock> exclusive_guard;
+typedef shared_lock<detail::scalable_rw_lock> shared_guard;
+typedef upgrade_lock<detail::scalable_rw_lock> upgrade_guard;
+typedef upgrade_to_unique_lock<detail::scalable_rw_lock> upgrade_to_unique_guard;
 
 class local_broker;
 class local_group_module;
 
+// immutable, sorted list of subscribers shared by all ongoing deliveries
+class subscriber_snapshot : public ref_counted {
+
+ public:
+
+    std::vector<channel> subscribers;
+
+};
+
+typedef intrusive_ptr<subscriber_snapshot> subscriber_snapshot_ptr;
+
+// delivers a message to a range of subscribers on a scheduler worker
+class fan_out_job : public resumable {
+
+ public:
+
+    fan_out_job(subscriber_snapshot_ptr snapshot, size_t first, size_t last,
+                msg_hdr_cref hdr, message msg)
+    : m_snapshot(std::move(snapshot)), m_first(first), m_last(last)
+    , m_hdr(hdr), m_msg(std::move(msg)) { }
+
+    void attach_to_scheduler() override { }
+
+    void detach_from_scheduler() override {
+        delete this;
+    }
+
+    resume_result resume(detail::cs_thread*, execution_unit* eu) override {
+        auto& subscribers = m_snapshot->subscribers;
+        for (auto i = m_first; i < m_last; ++i) {
+            subscribers[i]->enqueue(m_hdr, m_msg, eu);
+        }
+        return done;
+    }
+
+ private:
+
+    subscriber_snapshot_ptr m_snapshot;
+    size_t m_first;
+    size_t m_last;
+    message_header m_hdr;
+    message m_msg;
+
+};
+
 class local_group : public abstract_group {
 
  public:
@@ -62,9 +108,26 @@ class local_group : public abstract_group {
                               execution_unit* eu) {
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(hdr.sender, to_string) << ", "
                        << BOOST_ACTOR_TARG(msg, to_string));
-        shared_guard guard(m_mtx);
-        for (auto& s : m_subscribers) {
-            s->enqueue(hdr, msg, eu);
+        auto snapshot = subscribers();
+        auto& subscribers = snapshot->subscribers;
+        auto threshold = parallel_fan_out_threshold();
+        auto num_workers = get_scheduling_coordinator()->num_workers();
+        if (threshold == 0 || subscribers.size() < threshold || num_workers < 2) {
+            for (auto& s : subscribers) {
+                s->enqueue(hdr, msg, eu);
+            }
+            return;
+        }
+        // one chunk per worker, the first one is delivered by the caller
+        auto chunk_size = (subscribers.size() + num_workers - 1) / num_workers;
+        for (auto first = chunk_size; first < subscribers.size();
+             first += chunk_size) {
+            auto last = std::min(first + chunk_size, subscribers.size());
+            get_scheduling_coordinator()->enqueue(
+                new fan_out_job(snapshot, first, last, hdr, msg));
+        }
+        for (size_t i = 0; i < chunk_size; ++i) {
+            subscribers[i]->enqueue(hdr, msg, eu);
         }
     }
 
@@ -77,18 +140,39 @@ class local_group : public abstract_group {
 
     std::pair<bool, size_t> add_subscriber(const channel& who) {
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(who, to_string));
-        exclusive_guard guard(m_mtx);
-        if (who && m_subscribers.insert(who).second) {
-            return {true, m_subscribers.size()};
+        std::lock_guard<std::mutex> guard(m_write_mtx);
+        // only writers replace m_subscribers, i.e., we can read it
+        // without acquiring m_mtx while holding m_write_mtx
+        auto& current = m_subscribers->subscribers;
+        auto i = std::lower_bound(current.begin(), current.end(), who);
+        if (!who || (i != current.end() && *i == who)) {
+            return {false, current.size()};
         }
-        return {false, m_subscribers.size()};
+        auto next = make_counted<subscriber_snapshot>();
+        next->subscribers.reserve(current.size() + 1);
+        next->subscribers.insert(next->subscribers.end(), current.begin(), i);
+        next->subscribers.push_back(who);
+        next->subscribers.insert(next->subscribers.end(), i, current.end());
+        auto result = next->subscribers.size();
+        publish(std::move(next));
+        return {true, result};
     }
 
     std::pair<bool, size_t> erase_subscriber(const channel& who) {
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(who, to_string));
-        exclusive_guard guard(m_mtx);
-        auto success = m_subscribers.erase(who) > 0;
-        return {success, m_subscribers.size()};
+        std::lock_guard<std::mutex> guard(m_write_mtx);
+        auto& current = m_subscribers->subscribers;
+        auto i = std::lower_bound(current.begin(), current.end(), who);
+        if (i == current.end() || *i != who) {
+            return {false, current.size()};
+        }
+        auto next = make_counted<subscriber_snapshot>();
+        next->subscribers.reserve(current.size() - 1);
+        next->subscribers.insert(next->subscribers.end(), current.begin(), i);
+        next->subscribers.insert(next->subscribers.end(), i + 1, current.end());
+        auto result = next->subscribers.size();
+        publish(std::move(next));
+        return {true, result};
     }
 
     abstract_group::subscription subscribe(const channel& who) {
@@ -114,8 +198,26 @@ class local_group : public abstract_group {
 
  protected:
 
-    detail::shared_spinlock m_mtx;
-    std::set<channel> m_subscribers;
+    // returns the current subscribers, which remain valid
+    // and unchanged as long as the caller holds the snapshot
+    subscriber_snapshot_ptr subscribers() {
+        shared_guard guard(m_mtx);
+        return m_subscribers;
+    }
+
+    // replaces the current snapshot, requires m_write_mtx; the previous
+    // snapshot is released outside of the critical section or by the
+    // last delivery still using it
+    void publish(subscriber_snapshot_ptr next) {
+        exclusive_guard guard(m_mtx);
+        m_subscribers.swap(next);
+    }
+
+    // serializes modifications of m_subscribers
+    std::mutex m_write_mtx;
+    // guards the pointer m_subscribers only, never the scan over it
+    detail::scalable_rw_lock m_mtx;
+    subscriber_snapshot_ptr m_subscribers;
     actor m_broker;
 
 };
@@ -341,9 +443,9 @@ class local_group_module : public abstract_group::module {
 
     node_id_ptr m_process;
     const uniform_type_info* m_actor_utype;
-    detail::shared_spinlock m_instances_mtx;
+    detail::scalable_rw_lock m_instances_mtx;
     std::map<std::string, local_group_ptr> m_instances;
-    detail::shared_spinlock m_proxies_mtx;
+    detail::scalable_rw_lock m_proxies_mtx;
     std::map<actor, local_group_ptr> m_proxies;
 
 };
@@ -567,7 +669,8 @@ class remote_group_module : public abstract_group::module {
 local_group::local_group(bool spawn_local_broker,
                          local_group_module* mod,
                          std::string id)
-: abstract_group(mod, std::move(id)) {
+: abstract_group(mod, std::move(id))
+, m_subscribers(make_counted<subscriber_snapshot>()) {
     if (spawn_local_broker) m_broker = spawn<local_broker, hidden>(this);
 }
 
@@ -0,0 +1,118 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <cstring>
+
+#include "boost/actor/config.hpp"
+#include "boost/actor/exception.hpp"
+
+#include "boost/actor/io/ip_endpoint.hpp"
+
+#ifdef BOOST_ACTOR_WINDOWS
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <arpa/inet.h>
+#   include <sys/socket.h>
+#   include <netinet/in.h>
+#endif
+
+namespace boost {
+namespace actor {
+namespace io {
+
+namespace {
+
+constexpr std::uint8_t v4_mapped_prefix[] = { 0, 0, 0, 0, 0, 0,
+                                              0, 0, 0, 0, 0xFF, 0xFF };
+
+} // namespace <anonymous>
+
+ip_endpoint::ip_endpoint() : m_port(0) {
+    m_addr.fill(0);
+    memcpy(m_addr.data(), v4_mapped_prefix, sizeof(v4_mapped_prefix));
+}
+
+ip_endpoint::ip_endpoint(const std::string& host, std::uint16_t port)
+: m_port(port) {
+    m_addr.fill(0);
+    if (::inet_pton(AF_INET, host.c_str(), m_addr.data() + 12) == 1) {
+        memcpy(m_addr.data(), v4_mapped_prefix, sizeof(v4_mapped_prefix));
+    }
+    else if (::inet_pton(AF_INET6, host.c_str(), m_addr.data()) != 1) {
+        throw network_error("invalid IP address: " + host);
+    }
+}
+
+std::string ip_endpoint::host() const {
+    char buf[INET6_ADDRSTRLEN];
+    const char* res;
+    if (is_v4()) res = ::inet_ntop(AF_INET, m_addr.data() + 12,
+                                   buf, sizeof(buf));
+    else res = ::inet_ntop(AF_INET6, m_addr.data(), buf, sizeof(buf));
+    return res ? res : "";
+}
+
+bool ip_endpoint::is_v4() const {
+    return memcmp(m_addr.data(), v4_mapped_prefix,
+                  sizeof(v4_mapped_prefix)) == 0;
+}
+
+int ip_endpoint::compare(const ip_endpoint& other) const {
+    auto res = memcmp(m_addr.data(), other.m_addr.data(), m_addr.size());
+    return res != 0 ? res : static_cast<int>(m_port) - other.m_port;
+}
+
+ip_endpoint ip_endpoint::from_sockaddr(const void* addr) {
+    ip_endpoint result;
+    auto sa = reinterpret_cast<const sockaddr*>(addr);
+    if (sa->sa_family == AF_INET) {
+        auto sin = reinterpret_cast<const sockaddr_in*>(addr);
+        memcpy(result.m_addr.data() + 12, &sin->sin_addr, 4);
+        result.m_port = ntohs(sin->sin_port);
+    }
+    else if (sa->sa_family == AF_INET6) {
+        auto sin6 = reinterpret_cast<const sockaddr_in6*>(addr);
+        memcpy(result.m_addr.data(), &sin6->sin6_addr, 16);
+        result.m_port = ntohs(sin6->sin6_port);
+    }
+    return result;
+}
+
+size_t ip_endpoint::to_sockaddr(void* storage, int family) const {
+    if (family == AF_INET) {
+        if (!is_v4()) return 0;
+        auto sin = reinterpret_cast<sockaddr_in*>(storage);
+        memset(sin, 0, sizeof(sockaddr_in));
+        sin->sin_family = AF_INET;
+        memcpy(&sin->sin_addr, m_addr.data() + 12, 4);
+        sin->sin_port = htons(m_port);
+        return sizeof(sockaddr_in);
+    }
+    // IPv6 sockets reach IPv4 hosts via IPv4-mapped addresses
+    auto sin6 = reinterpret_cast<sockaddr_in6*>(storage);
+    memset(sin6, 0, sizeof(sockaddr_in6));
+    sin6->sin6_family = AF_INET6;
+    memcpy(&sin6->sin6_addr, m_addr.data(), 16);
+    sin6->sin6_port = htons(m_port);
+    return sizeof(sockaddr_in6);
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
@@ -24,6 +24,7 @@
 #include "boost/actor/local_actor.hpp"
 
 #include "boost/actor/detail/raw_access.hpp"
+#include "boost/actor/detail/sync_request_bouncer.hpp"
 
 namespace boost {
 namespace actor {
@@ -63,7 +64,9 @@ class down_observer : public attachable {
 
 local_actor::local_actor()
         : m_trap_exit(false), m_dummy_node(), m_current_node(&m_dummy_node)
-        , m_planned_exit_reason(exit_reason::not_exited) {
+        , m_planned_exit_reason(exit_reason::not_exited)
+        , m_mailbox_capacity(0), m_mailbox_overflow(mailbox_overflow::reject)
+        , m_mailbox_size(0) {
     m_node = get_middleman()->node();
 }
 
@@ -137,6 +140,64 @@ void local_actor::send_tuple(message_priority prio, const channel& dest, message
     dest->enqueue({address(), dest, id}, std::move(what), m_host);
 }
 
+bool local_actor::try_send_tuple(message_priority prio, const channel& dest,
+                                 message what) {
+    if (!dest) return true;
+    message_id id;
+    if (prio == message_priority::high) id = id.with_high_priority();
+    return dest->try_enqueue({address(), dest, id}, std::move(what), m_host);
+}
+
+void local_actor::configure_mailbox(const mailbox_config& cfg) {
+    m_mailbox_capacity = cfg.capacity;
+    m_mailbox_overflow = cfg.overflow;
+}
+
+namespace {
+
+// responses and system messages are never dropped, because senders
+// and the runtime rely on them, and do not count towards the capacity
+bool never_dropped(const message_id& mid, const message& msg) {
+    return    mid.is_response()
+           || msg.has_types<exit_msg>()
+           || msg.has_types<down_msg>()
+           || msg.has_types<timeout_msg>()
+           || msg.has_types<group_down_msg>();
+}
+
+} // namespace <anonymous>
+
+auto local_actor::admit_bounded(msg_hdr_cref hdr,
+                                const message& msg) -> admission {
+    if (never_dropped(hdr.id, msg)) return admission::accepted;
+    if (m_mailbox_size++ < m_mailbox_capacity) return admission::accepted;
+    switch (m_mailbox_overflow) {
+        case mailbox_overflow::drop_oldest:
+            // the reader drops excess messages
+            return admission::accepted;
+        case mailbox_overflow::backpressure:
+            return admission::overloaded;
+        case mailbox_overflow::reject:
+        case mailbox_overflow::drop_newest:
+            --m_mailbox_size;
+            // the sender of a dropped request would wait forever otherwise
+            if (hdr.id.is_request()) {
+                detail::sync_request_bouncer f{exit_reason::mailbox_overflow};
+                f(hdr.sender, hdr.id);
+            }
+            return admission::dropped;
+    }
+    return admission::accepted;
+}
+
+bool local_actor::discard_bounded(const mailbox_element& e) {
+    if (never_dropped(e.mid, e.msg)) return false;
+    // the counter includes e
+    auto n = m_mailbox_size--;
+    return    m_mailbox_overflow == mailbox_overflow::drop_oldest
+           && n > m_mailbox_capacity;
+}
+
 void local_actor::send_exit(const actor_addr& whom, std::uint32_t reason) {
     send(detail::raw_access::get(whom), exit_msg{address(), reason});
 }
@@ -158,8 +219,28 @@ response_promise local_actor::make_response_promise() {
     return result;
 }
 
+detail::timer_handle local_actor::schedule_timeout(const duration& d,
+                                                   message msg) {
+    return get_scheduling_coordinator()->delayed_send({address(), this}, d,
+                                                      std::move(msg));
+}
+
+void local_actor::cancel_timeout(const detail::timer_handle& handle) {
+    if (handle) get_scheduling_coordinator()->cancel_timeout(handle);
+}
+
+void local_actor::cancel_sync_timeout(message_id response_id) {
+    auto i = m_sync_timeouts.find(response_id.integer_value());
+    if (i != m_sync_timeouts.end()) {
+        cancel_timeout(i->second);
+        m_sync_timeouts.erase(i);
+    }
+}
+
 void local_actor::cleanup(std::uint32_t reason) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(reason));
+    for (auto& p : m_sync_timeouts) cancel_timeout(p.second);
+    m_sync_timeouts.clear();
     m_subscriptions.clear();
     super::cleanup(reason);
 }
@@ -190,12 +271,13 @@ message_id local_actor::timed_sync_send_tuple_impl(message_priority mp,
         throw std::invalid_argument("cannot send synchronous message "
                                     "to invalid_actor");
     }
-    auto nri = new_request_id();
-    if (mp == message_priority::high) nri = nri.with_high_priority();
+    auto nri = new_request_id(mp);
     dest->enqueue({address(), dest, nri}, std::move(what), m_host);
     auto rri = nri.response_id();
-    get_scheduling_coordinator()->delayed_send({address(), this, rri}, rtime,
-                                  make_message(sync_timeout_msg{}));
+    auto handle = get_scheduling_coordinator()->delayed_send(
+                      {address(), this, rri}, rtime,
+                      make_message(sync_timeout_msg{}));
+    m_sync_timeouts.emplace(rri.integer_value(), std::move(handle));
     return rri;
 }
 
@@ -206,8 +288,7 @@ message_id local_actor::sync_send_tuple_impl(message_priority mp,
         throw std::invalid_argument("cannot send synchronous message "
                                     "to invalid_actor");
     }
-    auto nri = new_request_id();
-    if (mp == message_priority::high) nri = nri.with_high_priority();
+    auto nri = new_request_id(mp);
     dest->enqueue({address(), dest, nri}, std::move(what), m_host);
     return nri.response_id();
 }
@@ -27,5 +27,51 @@ mailbox_element::mailbox_element(msg_hdr_cref hdr, message data)
 
 mailbox_element::~mailbox_element() { }
 
+mailbox_element* mailbox_element::create(msg_hdr_cref hdr, message data) {
+    if (data.cvals()) {
+        // data.vals() would detach if the instance is not unshared,
+        // while embedded_element() performs this check on its own
+        auto ptr = const_cast<detail::message_data*>(data.cvals().operator->());
+        auto storage = ptr->embedded_element();
+        if (storage.second) {
+            return detail::memory::create_embedded<mailbox_element>(
+                        storage, hdr, std::move(data));
+        }
+    }
+    return detail::memory::create<mailbox_element>(hdr, std::move(data));
+}
+
+namespace detail {
+
+constexpr size_t embedded_element_wrapper::storage_size;
+
+constexpr size_t embedded_element_wrapper::max_payload;
+
+static_assert(sizeof(mailbox_element) <= embedded_element_wrapper::storage_size,
+              "embedded_element_wrapper::storage_size is too small "
+              "for a mailbox_element");
+
+embedded_element_wrapper::embedded_element_wrapper(message_data* parent)
+        : m_parent(parent), m_claimed(false) { }
+
+bool embedded_element_wrapper::claim() {
+    if (m_claimed.exchange(true, std::memory_order_acquire)) return false;
+    m_parent->ref(); // released in deallocate()
+    return true;
+}
+
+void embedded_element_wrapper::destroy() {
+    reinterpret_cast<mailbox_element*>(storage())->~mailbox_element();
+}
+
+void embedded_element_wrapper::deallocate() {
+    // the storage can be claimed again if the message is sent
+    // once more; this might be the last reference to m_parent
+    m_claimed.store(false, std::memory_order_release);
+    m_parent->deref();
+}
+
+} // namespace detail
+
 } // namespace actor
 } // namespace boost
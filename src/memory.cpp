@@ -16,37 +16,46 @@
 \******************************************************************************/
 
 
+#include <atomic>
 #include <vector>
-#include <typeinfo>
 
 #include "boost/actor/detail/memory.hpp"
-#include "boost/actor/mailbox_element.hpp"
 
 using namespace std;
 
-#ifdef BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
-
-int cppa_memory_keep_compiler_happy() { return 0; }
-
-#else // BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
-
 namespace boost {
 namespace actor {
 namespace detail {
 
+instance_wrapper::~instance_wrapper() { }
+
+memory_cache::~memory_cache() { }
+
+#ifndef BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
+
 namespace {
 
 pthread_key_t s_key;
 pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
 
-} // namespace <anonymous>
+std::atomic<size_t> s_next_cache_index{0};
 
-memory_cache::~memory_cache() { }
+} // namespace <anonymous>
 
-typedef map<const type_info*, unique_ptr<memory_cache> > cache_map;
+// maps memory::cache_index<T>() to the cache of the thread for T
+typedef vector<memory_cache*> cache_map;
 
 void cache_map_destructor(void* ptr) {
-    if (ptr) delete reinterpret_cast<cache_map*>(ptr);
+    if (ptr) {
+        auto cache = reinterpret_cast<cache_map*>(ptr);
+        for (auto mc : *cache) {
+            if (mc) {
+                mc->close();
+                mc->deref();
+            }
+        }
+        delete cache;
+    }
 }
 
 void make_cache_map() {
@@ -59,28 +68,31 @@ cache_map& get_cache_map() {
     if (!cache) {
         cache = new cache_map;
         pthread_setspecific(s_key, cache);
-        // insert default types
-        unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-        cache->insert(make_pair(&typeid(mailbox_element), boost::move(tmp)));
     }
     return *cache;
 }
 
-memory_cache* memory::get_cache_map_entry(const type_info* tinf) {
-    auto& cache = get_cache_map();
-    auto i = cache.find(tinf);
-    if (i != cache.end()) return i->second.get();
-    return nullptr;
+memory_cache* memory::get_cache(size_t idx) {
+    // never creates a map, because this is called on any thread that
+    // releases an element, including threads in their TLS teardown
+    pthread_once(&s_key_once, make_cache_map);
+    auto cache = reinterpret_cast<cache_map*>(pthread_getspecific(s_key));
+    return cache && idx < cache->size() ? (*cache)[idx] : nullptr;
+}
+
+size_t memory::next_cache_index() {
+    return s_next_cache_index++;
 }
 
-void memory::add_cache_map_entry(const type_info* tinf, memory_cache* instance) {
+void memory::set_cache(size_t idx, memory_cache* instance) {
     auto& cache = get_cache_map();
-    cache[tinf].reset(instance);
+    if (idx >= cache.size()) cache.resize(idx + 1, nullptr);
+    BOOST_ACTOR_REQUIRE(cache[idx] == nullptr);
+    instance->ref(); // released in cache_map_destructor
+    cache[idx] = instance;
 }
 
-instance_wrapper::~instance_wrapper() { }
+#endif // BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
 
 } } // namespace actor
 } // namespace boost::detail
-
-#endif // BOOST_ACTOR_DISABLE_MEM_MANAGEMENT
@@ -16,6 +16,8 @@
 \******************************************************************************/
 
 
+#include <atomic>
+
 #include "boost/actor/message.hpp"
 #include "boost/actor/singletons.hpp"
 
@@ -24,6 +26,20 @@
 namespace boost {
 namespace actor {
 
+namespace {
+
+std::atomic<bool> s_embed_mailbox_elements{true};
+
+} // namespace <anonymous>
+
+void embed_mailbox_elements(bool value) {
+    s_embed_mailbox_elements = value;
+}
+
+bool embed_mailbox_elements() {
+    return s_embed_mailbox_elements.load(std::memory_order_relaxed);
+}
+
 message::message(detail::message_data* ptr) : m_vals(ptr) { }
 
 message::message(message&& other) : m_vals(std::move(other.m_vals)) { }
@@ -16,14 +16,20 @@
 \******************************************************************************/
 
 
+#include <deque>
+#include <mutex>
 #include <tuple>
+#include <atomic>
+#include <thread>
 #include <cerrno>
 #include <memory>
 #include <cstring>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <condition_variable>
 
+#include "boost/thread/locks.hpp"
 #include "boost/algorithm/string.hpp"
 
 #include "boost/actor/on.hpp"
@@ -32,12 +38,14 @@
 #include "boost/actor/logging.hpp"
 #include "boost/actor/node_id.hpp"
 #include "boost/actor/to_string.hpp"
+#include "boost/actor/scheduler.hpp"
 #include "boost/actor/actor_proxy.hpp"
 #include "boost/actor/binary_serializer.hpp"
 #include "boost/actor/uniform_type_info.hpp"
 #include "boost/actor/binary_deserializer.hpp"
 
 #include "boost/actor/detail/ripemd_160.hpp"
+#include "boost/actor/detail/cpu_affinity.hpp"
 #include "boost/actor/detail/get_root_uuid.hpp"
 #include "boost/actor/detail/get_mac_addresses.hpp"
 
@@ -55,6 +63,7 @@
 
 #include "boost/actor/detail/safe_equal.hpp"
 #include "boost/actor/detail/make_counted.hpp"
+#include "boost/actor/detail/shared_spinlock.hpp"
 #include "boost/actor/detail/actor_registry.hpp"
 #include "boost/actor/detail/single_reader_queue.hpp"
 
@@ -79,14 +88,16 @@ void notify_queue_event(native_socket_type fd) {
     static_cast<void>(res);
 }
 
+// maximum number of events num_queue_events() reads at once
+constexpr size_t max_queue_events = 64;
+
 size_t num_queue_events(native_socket_type fd) {
-    static constexpr size_t num_dummies = 64;
-    char dummies[num_dummies];
+    char dummies[max_queue_events];
     // on unix, we have file handles, on windows, we actually have sockets
 #   ifdef BOOST_ACTOR_WINDOWS
-    auto read_result = ::recv(fd, dummies, num_dummies, 0);
+    auto read_result = ::recv(fd, dummies, max_queue_events, 0);
 #   else
-    auto read_result = ::read(fd, dummies, num_dummies);
+    auto read_result = ::read(fd, dummies, max_queue_events);
 #   endif
     if (read_result < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
@@ -121,84 +132,258 @@ class middleman_event {
 
 void middleman::continue_writer(continuable* ptr) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
-    m_handler->add_later(ptr, event::write);
+    handler().add_later(ptr, event::write);
 }
 
 void middleman::stop_writer(continuable* ptr) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
-    m_handler->erase_later(ptr, event::write);
+    handler().erase_later(ptr, event::write);
+}
+
+void middleman::flush_later(continuable* ptr) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
+    handler().flush_later(ptr);
+}
+
+void middleman::use_doorbell(continuable* ptr) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
+    handler().use_doorbell(ptr);
 }
 
 bool middleman::has_writer(continuable* ptr) {
-    return m_handler->has_writer(ptr);
+    return handler().has_writer(ptr);
 }
 
 void middleman::continue_reader(continuable* ptr) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
-    m_handler->add_later(ptr, event::read);
+    handler().add_later(ptr, event::read);
 }
 
 void middleman::stop_reader(continuable* ptr) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
-    m_handler->erase_later(ptr, event::read);
+    handler().erase_later(ptr, event::read);
 }
 
 bool middleman::has_reader(continuable* ptr) {
-    return m_handler->has_reader(ptr);
+    return handler().has_reader(ptr);
 }
 
 typedef detail::single_reader_queue<middleman_event> middleman_queue;
 
+class middleman_impl;
+
+struct peer_entry {
+    peer* impl;
+    default_message_queue_ptr queue;
+    // set while the loop selected by the hash value of the node hands
+    // over the messages it has queued before the peer was registered
+    bool awaits_handoff;
+};
+
+/*
+ * An event loop of the middleman, i.e., a thread with its own event
+ * handler, its own run-later queue and its own set of peers and acceptors.
+ */
+class event_loop {
+
+ public:
+
+    event_loop(middleman_impl* parent, size_t id)
+    : m_parent(parent), m_id(id), m_done(false)
+    , m_handler(middleman_event_handler::create()) {
+        auto pipefds = fd_util::create_pipe();
+        m_pipe_out = pipefds.first;
+        m_pipe_in = pipefds.second;
+        fd_util::nonblocking(m_pipe_out, true);
+        // the overseer unblocks the queue while processing events,
+        // i.e., only the first enqueue operation writes to the pipe
+        m_queue.try_block();
+    }
+
+    ~event_loop() {
+        closesocket(m_pipe_out);
+        closesocket(m_pipe_in);
+    }
+
+    void run_later(std::function<void()> fun) {
+        auto res = m_queue.enqueue(new middleman_event(std::move(fun)));
+        if (res == detail::enqueue_result::unblocked_reader) {
+            notify_queue_event(m_pipe_in);
+        }
+    }
+
+    middleman_impl* m_parent;
+    size_t m_id;
+    bool m_done;
+    std::unique_ptr<middleman_event_handler> m_handler;
+    std::thread m_thread;
+    native_socket_type m_pipe_out;
+    native_socket_type m_pipe_in;
+    middleman_queue m_queue;
+    std::map<actor_addr, std::vector<peer_acceptor*>> m_acceptors;
+    std::map<node_id, peer_entry> m_peers;
+
+};
+
+void middleman_loop(event_loop* loop);
+
+/*
+ * A fixed set of threads for blocking jobs such as name lookups,
+ * started on first use.
+ */
+class resolver_pool {
+
+ public:
+
+    resolver_pool() : m_done(false) { }
+
+    void enqueue(std::function<void()> fun) {
+        std::lock_guard<std::mutex> guard(m_mtx);
+        if (m_done) return;
+        if (m_threads.empty()) {
+            auto cfg = scheduler::get_configuration();
+            auto num = std::max(cfg.num_resolver_threads, size_t{1});
+            for (size_t i = 0; i < num; ++i) {
+                m_threads.emplace_back([this] { run(); });
+            }
+        }
+        m_jobs.push_back(std::move(fun));
+        m_cv.notify_one();
+    }
+
+    // discards all pending jobs and waits for running jobs to finish
+    void stop() {
+        { // lifetime scope of guard
+            std::lock_guard<std::mutex> guard(m_mtx);
+            m_done = true;
+            m_jobs.clear();
+        }
+        m_cv.notify_all();
+        for (auto& t : m_threads) t.join();
+        m_threads.clear();
+    }
+
+ private:
+
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            { // lifetime scope of guard
+                std::unique_lock<std::mutex> guard(m_mtx);
+                m_cv.wait(guard, [&] { return m_done || !m_jobs.empty(); });
+                if (m_done) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_jobs;
+    std::vector<std::thread> m_threads;
+    bool m_done;
+
+};
+
+namespace {
+
+// the event loop of the calling thread or nullptr
+__thread event_loop* t_loop = nullptr;
+
+typedef lock_guard<detail::shared_spinlock> exclusive_guard;
+typedef shared_lock<detail::shared_spinlock> shared_guard;
+
+size_t hash_of(const node_id& node) {
+    // FNV-1a over host ID and process ID
+    size_t result = 2166136261u;
+    auto add = [&](std::uint8_t byte) {
+        result ^= byte;
+        result *= 16777619u;
+    };
+    for (auto byte : node.host_id()) add(byte);
+    auto pid = node.process_id();
+    for (size_t i = 0; i < sizeof(pid); ++i) {
+        add(static_cast<std::uint8_t>(pid >> (i * 8)));
+    }
+    return result;
+}
+
+} // namespace <anonymous>
+
 /*
  * A middleman also implements a "namespace" for actors.
  */
 class middleman_impl : public middleman {
 
     friend class middleman;
-    friend void middleman_loop(middleman_impl*);
+    friend void middleman_loop(event_loop*);
 
  public:
 
-    middleman_impl() : m_done(false) { }
+    middleman_impl() : m_next_loop(0) { }
 
     ~middleman_impl();
 
     void run_later(std::function<void()> fun) override {
-        m_queue.enqueue(new middleman_event(std::move(fun)));
-        std::atomic_thread_fence(std::memory_order_seq_cst);
-        notify_queue_event(m_pipe_in);
+        m_loops.front()->run_later(std::move(fun));
+    }
+
+    void run_later(const node_id& node, std::function<void()> fun) override {
+        if (m_loops.size() == 1) {
+            m_loops.front()->run_later(std::move(fun));
+            return;
+        }
+        // posting while holding the lock guarantees that functors posted
+        // to the hash loop of node are ahead of the handoff request that
+        // register_peer posts once it has added a route for node
+        shared_guard guard(m_routes_mtx);
+        loop_for(node).run_later(std::move(fun));
+    }
+
+    void run_blocking(std::function<void()> fun) override {
+        m_resolvers.enqueue(std::move(fun));
     }
 
     bool register_peer(const node_id& node, peer* ptr) override {
         BOOST_ACTOR_LOG_TRACE("node = " << to_string(node) << ", ptr = " << ptr);
-        auto& entry = m_peers[node];
-        if (entry.impl == nullptr) {
-            if (entry.queue == nullptr) {
-                entry.queue = detail::make_counted<default_message_queue>();
-            }
-            ptr->set_queue(entry.queue);
-            entry.impl = ptr;
-            if (!entry.queue->empty()) {
-                auto tmp = entry.queue->pop();
-                ptr->enqueue(tmp.first, tmp.second);
+        auto& loop = current();
+        auto& hloop = hash_loop(node);
+        { // lifetime scope of guard
+            exclusive_guard guard(m_routes_mtx);
+            if (!m_routes.insert(std::make_pair(node, loop.m_id)).second) {
+                BOOST_ACTOR_LOG_WARNING("peer " << to_string(node)
+                                        << " already defined, multiple "
+                                           "calls to remote_actor()?");
+                return false;
             }
-            BOOST_ACTOR_LOG_INFO("peer " << to_string(node) << " added");
-            return true;
+            if (&hloop != &loop) request_handoff(hloop, loop, node);
         }
-        else {
-            BOOST_ACTOR_LOG_WARNING("peer " << to_string(node) << " already defined, "
-                             "multiple calls to remote_actor()?");
-            return false;
+        auto& entry = loop.m_peers[node];
+        BOOST_ACTOR_REQUIRE(entry.impl == nullptr);
+        if (entry.queue == nullptr) {
+            entry.queue = detail::make_counted<default_message_queue>();
+        }
+        entry.impl = ptr;
+        if (&hloop != &loop) {
+            // messages queued by the hash loop go first, i.e., we
+            // hold back everything until the handoff completed
+            entry.awaits_handoff = true;
         }
+        else start_writing(entry);
+        BOOST_ACTOR_LOG_INFO("peer " << to_string(node) << " added");
+        return true;
     }
 
     peer* get_peer(const node_id& node) override {
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_TARG(node, to_string));
-        auto i = m_peers.find(node);
+        auto& peers = current().m_peers;
+        auto i = peers.find(node);
         // future work (?): we *could* try to be smart here and try to
         // route all messages to node via other known peers in the network
         // if i->second.impl == nullptr
-        if (i != m_peers.end() && i->second.impl != nullptr) {
+        if (i != peers.end() && i->second.impl != nullptr) {
             BOOST_ACTOR_LOG_DEBUG("result = " << i->second.impl);
             return i->second.impl;
         }
@@ -207,23 +392,39 @@ class middleman_impl : public middleman {
     }
 
     void del_acceptor(peer_acceptor* ptr) override {
-        auto i = m_acceptors.begin();
-        auto e = m_acceptors.end();
+        auto& acceptors = current().m_acceptors;
+        auto i = acceptors.begin();
+        auto e = acceptors.end();
         while (i != e) {
             auto& vec = i->second;
             auto last = vec.end();
             auto iter = std::find(vec.begin(), last, ptr);
             if (iter != last) vec.erase(iter);
             if (not vec.empty()) ++i;
-            else i = m_acceptors.erase(i);
+            else i = acceptors.erase(i);
         }
     }
 
     void deliver(const node_id& node,
                  msg_hdr_cref hdr,
                  message msg                  ) override {
-        auto& entry = m_peers[node];
-        if (entry.impl) {
+        auto& loop = current();
+        if (m_loops.size() > 1 && loop.m_peers.count(node) == 0) {
+            // only the loop owning the peer and the hash loop, whose
+            // queue is handed over to the owner, may queue messages
+            event_loop* target;
+            { // lifetime scope of guard
+                shared_guard guard(m_routes_mtx);
+                target = &loop_for(node);
+            }
+            if (target != &loop && &hash_loop(node) != &loop) {
+                node_id_ptr nptr{new node_id(node)};
+                target->run_later([=] { deliver(*nptr, hdr, msg); });
+                return;
+            }
+        }
+        auto& entry = loop.m_peers[node];
+        if (entry.impl && !entry.awaits_handoff) {
             BOOST_ACTOR_REQUIRE(entry.queue != nullptr);
             if (!entry.impl->has_unwritten_data()) {
                 BOOST_ACTOR_REQUIRE(entry.queue->empty());
@@ -239,9 +440,10 @@ class middleman_impl : public middleman {
 
     void last_proxy_exited(peer* pptr) override {
         BOOST_ACTOR_REQUIRE(pptr != nullptr);
-        BOOST_ACTOR_REQUIRE(pptr->m_queue != nullptr);
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(pptr)
                        << ", pptr->node() = " << to_string(pptr->node()));
+        // queued messages might still be on their way from the hash loop
+        if (pptr->m_queue == nullptr) return;
         if (pptr->stop_on_last_proxy_exited() && pptr->queue().empty()) {
             stop_reader(pptr);
         }
@@ -258,22 +460,28 @@ class middleman_impl : public middleman {
 
     void del_peer(peer* pptr) override {
         BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(pptr));
-        auto i = m_peers.find(pptr->node());
-        if (i != m_peers.end()) {
+        auto& loop = current();
+        auto i = loop.m_peers.find(pptr->node());
+        if (i != loop.m_peers.end()) {
             BOOST_ACTOR_LOG_DEBUG_IF(i->second.impl != pptr,
                               "node " << to_string(pptr->node())
                               << " does not exist in m_peers");
             if (i->second.impl == pptr) {
-                m_peers.erase(i);
+                loop.m_peers.erase(i);
+                exclusive_guard guard(m_routes_mtx);
+                m_routes.erase(pptr->node());
             }
         }
     }
 
     void register_acceptor(const actor_addr& aa, peer_acceptor* ptr) override {
-        run_later([=] {
+        // distribute acceptors round-robin across all event loops
+        auto& loop = *m_loops[m_next_loop++ % m_loops.size()];
+        auto lptr = &loop;
+        loop.run_later([=] {
             BOOST_ACTOR_LOGC_TRACE("cppa::io::middleman",
                             "register_acceptor$lambda", "");
-            m_acceptors[aa].push_back(ptr);
+            lptr->m_acceptors[aa].push_back(ptr);
             continue_reader(ptr);
         });
     }
@@ -289,12 +497,11 @@ class middleman_impl : public middleman {
         }
 #       endif
         m_node = compute_node_id();
-        m_handler = middleman_event_handler::create();
         auto mm = this;
         m_namespace.set_proxy_factory([=](actor_id aid, node_id_ptr ptr) -> actor_proxy_ptr {
-            auto res = detail::make_counted<remote_actor_proxy>(aid, std::move(ptr), this);
+            auto res = detail::make_counted<remote_actor_proxy>(aid, ptr, this);
             res->attach_functor([=](uint32_t) {
-                mm->run_later([=] {
+                mm->run_later(*ptr, [=] {
                     mm->m_namespace.erase(res);
                 });
             });
@@ -302,34 +509,61 @@ class middleman_impl : public middleman {
         });
         m_namespace.set_new_element_callback([=](actor_id aid,
                                                  const node_id& node) {
-            deliver(node,
-                    {invalid_actor_addr, nullptr},
-                    make_message(atom("MONITOR"),
-                                   m_node,
-                                   aid));
+            // the namespace is accessed from all event loops,
+            // but only the loop responsible for node can deliver to it
+            node_id_ptr nptr{new node_id(node)};
+            run_later(node, [=] {
+                deliver(*nptr,
+                        {invalid_actor_addr, nullptr},
+                        make_message(atom("MONITOR"), m_node, aid));
+            });
         });
-        auto pipefds = fd_util::create_pipe();
-        m_pipe_out = pipefds.first;
-        m_pipe_in = pipefds.second;
-        fd_util::nonblocking(m_pipe_out, true);
-        // start threads
-        m_thread = std::thread([this] { middleman_loop(this); });
+        auto cfg = scheduler::get_configuration();
+        auto num_loops = std::max(cfg.num_middleman_loops, size_t{1});
+        for (size_t i = 0; i < num_loops; ++i) {
+            m_loops.emplace_back(new event_loop(this, i));
+            m_loops.back()->m_handler->edge_triggered(cfg.edge_triggered_io);
+        }
+        // start threads; pin each loop to a CPU of its own if
+        // there are enough reserved CPUs
+        auto& cpus = cfg.middleman_affinity;
+        for (auto& loop : m_loops) {
+            auto lptr = loop.get();
+            auto affinity = cpus.size() < num_loops
+                          ? cpus
+                          : scheduler::cpu_list{cpus[loop->m_id]};
+            loop->m_thread = std::thread([lptr, affinity] {
+                if (   !affinity.empty()
+                    && !detail::set_thread_affinity(affinity)) {
+                    BOOST_ACTOR_LOG_WARNING("unable to set CPU affinity");
+                }
+                middleman_loop(lptr);
+            });
+        }
     }
 
     void destroy() override {
         BOOST_ACTOR_LOG_TRACE("");
-        run_later([this] {
-            BOOST_ACTOR_LOGM_TRACE("destroy$helper", "");
-            this->m_done = true;
-        });
-        m_thread.join();
-        closesocket(m_pipe_out);
-        closesocket(m_pipe_in);
+        // resolver jobs post their results to the event loops
+        m_resolvers.stop();
+        for (auto& loop : m_loops) {
+            auto lptr = loop.get();
+            loop->run_later([lptr] {
+                BOOST_ACTOR_LOGM_TRACE("destroy$helper", "");
+                lptr->m_done = true;
+            });
+        }
+        for (auto& loop : m_loops) loop->m_thread.join();
+        m_loops.clear();
 #       ifdef BOOST_ACTOR_WINDOWS
         WSACleanup();
 #       endif
     }
 
+    middleman_event_handler& handler() override {
+        return *current().m_handler;
+    }
+
  private:
 
     static node_id_ptr compute_node_id() {
@@ -341,26 +575,96 @@ class middleman_impl : public middleman {
         return new node_id(static_cast<uint32_t>(getpid()), nid);
     }
 
-    inline void quit() { m_done = true; }
+    // returns the event loop of the calling thread, threads
+    // outside of the middleman operate on the first loop
+    inline event_loop& current() {
+        return t_loop ? *t_loop : *m_loops.front();
+    }
 
-    inline bool done() const { return m_done; }
+    // returns the event loop owning the peer for node if connected,
+    // otherwise the loop selected by the hash value of node;
+    // requires a lock on m_routes_mtx
+    event_loop& loop_for(const node_id& node) {
+        auto i = m_routes.find(node);
+        if (i != m_routes.end()) return *m_loops[i->second];
+        return hash_loop(node);
+    }
 
-    bool m_done;
+    // returns the event loop for node as long as it is not connected
+    inline event_loop& hash_loop(const node_id& node) {
+        return *m_loops[hash_of(node) % m_loops.size()];
+    }
 
-    middleman_event_handler& handler();
+    // passes the queue to the peer and starts writing queued messages
+    void start_writing(peer_entry& entry) {
+        entry.impl->set_queue(entry.queue);
+        if (!entry.queue->empty()) {
+            auto tmp = entry.queue->pop();
+            entry.impl->enqueue(tmp.first, tmp.second);
+        }
+    }
 
-    std::thread m_thread;
-    native_socket_type m_pipe_out;
-    native_socket_type m_pipe_in;
-    middleman_queue m_queue;
+    // moves all messages hloop has queued for node to owner; must be
+    // called while holding m_routes_mtx exclusively, see run_later()
+    void request_handoff(event_loop& hloop, event_loop& owner,
+                         const node_id& node) {
+        auto hptr = &hloop;
+        auto optr = &owner;
+        node_id_ptr nptr{new node_id(node)};
+        hloop.run_later([=] {
+            default_message_queue_ptr backlog;
+            auto i = hptr->m_peers.find(*nptr);
+            if (i != hptr->m_peers.end() && i->second.impl == nullptr) {
+                backlog = std::move(i->second.queue);
+                hptr->m_peers.erase(i);
+            }
+            optr->run_later([=] { complete_handoff(*nptr, backlog); });
+        });
+    }
 
-    struct peer_entry {
-        peer* impl;
-        default_message_queue_ptr queue;
-    };
+    // runs in the loop owning the peer for node
+    void complete_handoff(const node_id& node,
+                          const default_message_queue_ptr& backlog) {
+        auto& peers = current().m_peers;
+        auto i = peers.find(node);
+        if (i == peers.end() || !i->second.awaits_handoff) {
+            // the peer is gone, route messages to whichever loop
+            // is responsible for node now
+            while (backlog && !backlog->empty()) {
+                auto tmp = backlog->pop();
+                node_id_ptr nptr{new node_id(node)};
+                run_later(node, [=] { deliver(*nptr, tmp.first, tmp.second); });
+            }
+            return;
+        }
+        auto& entry = i->second;
+        if (backlog && !backlog->empty()) {
+            // older messages from the hash loop go first
+            while (!entry.queue->empty()) {
+                auto tmp = entry.queue->pop();
+                backlog->emplace(tmp.first, std::move(tmp.second));
+            }
+            while (!backlog->empty()) {
+                auto tmp = backlog->pop();
+                entry.queue->emplace(tmp.first, std::move(tmp.second));
+            }
+        }
+        entry.awaits_handoff = false;
+        start_writing(entry);
+        BOOST_ACTOR_LOG_DEBUG("handoff of queued messages for "
+                              << to_string(node) << " completed");
+    }
 
-    std::map<actor_addr, std::vector<peer_acceptor*>> m_acceptors;
-    std::map<node_id, peer_entry> m_peers;
+    std::vector<std::unique_ptr<event_loop>> m_loops;
+
+    resolver_pool m_resolvers;
+
+    // selects the loop for the next acceptor
+    std::atomic<size_t> m_next_loop;
+
+    // maps each connected node to the ID of the loop owning its peer
+    detail::shared_spinlock m_routes_mtx;
+    std::map<node_id, size_t> m_routes;
 
 };
 
@@ -387,18 +691,24 @@ class middleman_overseer : public continuable {
         // on MacOS, recv() on a pipe fd will fail,
         // on Windows, our pipe is actually composed of two sockets
         // and there's no read() function to read from sockets
-        auto events = num_queue_events(read_handle());
-        BOOST_ACTOR_LOG_DEBUG("read " << events << " messages from queue");
-        for (size_t i = 0; i < events; ++i) {
+        // drain the pipe first, as required for edge-triggered notification;
+        // a byte written after this point signals an event we have yet to run
+        while (num_queue_events(read_handle()) == max_queue_events) {
+            // repeat
+        }
+        // run_later writes to the pipe only if it unblocked the queue,
+        // i.e., we run all events until we can block the queue again
+        for (;;) {
             std::unique_ptr<middleman_event> msg(m_queue.try_pop());
-            if (!msg) {
-                BOOST_ACTOR_LOG_ERROR("nullptr dequeued");
-                BOOST_ACTOR_CRITICAL("nullptr dequeued");
+            if (msg) {
+                BOOST_ACTOR_LOGF_DEBUG("execute run_later functor");
+                (*msg)();
+            }
+            else if (m_queue.try_block()) {
+                return continue_reading_result::continue_later;
             }
-            BOOST_ACTOR_LOGF_DEBUG("execute run_later functor");
-            (*msg)();
+            // else: new events arrived
         }
-        return continue_reading_result::continue_later;
     }
 
     void io_failed(event_bitmask) override {
@@ -416,16 +726,18 @@ middleman_overseer::~middleman_overseer() { }
 
 middleman::~middleman() { }
 
-void middleman_loop(middleman_impl* impl) {
-    middleman_event_handler* handler = impl->m_handler.get();
-    BOOST_ACTOR_LOGF_TRACE("run middleman loop");
+void middleman_loop(event_loop* loop) {
+    t_loop = loop;
+    auto impl = loop->m_parent;
+    middleman_event_handler* handler = loop->m_handler.get();
+    BOOST_ACTOR_LOGF_TRACE("run middleman loop " << loop->m_id);
     BOOST_ACTOR_LOGF_INFO("middleman runs at "
                    << to_string(impl->node()));
     handler->init();
-    impl->continue_reader(new middleman_overseer(impl->m_pipe_out,
-                                                 impl->m_queue));
+    impl->continue_reader(new middleman_overseer(loop->m_pipe_out,
+                                                 loop->m_queue));
     handler->update();
-    while (!impl->done()) {
+    while (!loop->m_done) {
         handler->poll([&](event_bitmask mask, continuable* io) {
             switch (mask) {
                 default: BOOST_ACTOR_CRITICAL("invalid event");
@@ -17,6 +17,7 @@
 
 
 #include <string>
+#include <algorithm>
 
 #include "boost/actor/logging.hpp"
 
@@ -37,7 +38,9 @@ inline std::string eb2str(event_bitmask e) {
     }
 }
 
-middleman_event_handler::middleman_event_handler() { }
+constexpr size_t middleman_event_handler::npos;
+
+middleman_event_handler::middleman_event_handler() : m_edge_triggered(false) { }
 
 middleman_event_handler::~middleman_event_handler() { }
 
@@ -89,54 +92,104 @@ event_bitmask middleman_event_handler::next_bitmask(event_bitmask old, event_bit
     return (op == fd_meta_event::add) ? old | arg : old & ~arg;
 }
 
+void middleman_event_handler::flush_later(continuable* ptr) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
+    m_flush_list.push_back(ptr);
+}
+
 void middleman_event_handler::update() {
     BOOST_ACTOR_LOG_TRACE("");
-    auto mless = [](const fd_meta_info& lhs, native_socket_type rhs) {
-        return lhs.fd < rhs;
-    };
+    // writing may enqueue alterations and disposing a continuable
+    // may cause writes, so repeat until nothing is left to do
+    while (!m_flush_list.empty() || !m_alterations.empty()) {
+        flush_writers();
+        apply_alterations();
+    }
+}
+
+void middleman_event_handler::flush_writers() {
+    // writers may enqueue further writers, e.g., by delivering messages
+    for (size_t i = 0; i < m_flush_list.size(); ++i) {
+        auto ptr = m_flush_list[i];
+        switch (ptr->continue_writing()) {
+            case continue_writing_result::failure:
+                ptr->io_failed(event::write);
+                break;
+            case continue_writing_result::continue_later:
+                // wait until the OS accepts more data
+                add_later(ptr, event::write);
+                break;
+            default:
+                break;
+        }
+    }
+    m_flush_list.clear();
+}
+
+void middleman_event_handler::apply_alterations() {
+    // apply all alterations to m_meta first to call handle_event
+    // only once per file descriptor
     for (auto& elem_pair : m_alterations) {
         auto& elem = elem_pair.first;
-        auto old = event::none;
-        auto last = m_meta.end();
-        auto iter = std::lower_bound(m_meta.begin(), last, elem.fd, mless);
-        if (iter != last) old = iter->mask;
+        auto pos = index_of(elem.fd);
+        auto old = pos != npos ? m_meta[pos].mask : event::none;
         auto mask = next_bitmask(old, elem.mask, elem_pair.second);
+        if (mask == old) continue;
         auto ptr = elem.ptr;
         BOOST_ACTOR_LOG_DEBUG("new bitmask for "
                        << elem.ptr << ": " << eb2str(mask));
-        if (iter == last || iter->fd != elem.fd) {
-            if (mask != event::none) {
-                // element has been removed from m_meta by an
-                // previous alteration but is not put back in
-                m_meta.insert(iter, elem);
-                handle_event(fd_meta_event::add, elem.fd,
-                             event::none, mask, ptr);
-            }
+        m_changes.emplace_back(elem.fd, ptr, os_bitmask(ptr, old));
+        if (pos == npos) {
+            // element has been removed from m_meta by an
+            // previous alteration but is not put back in
+            set_index(elem.fd, m_meta.size());
+            m_meta.emplace_back(elem.fd, ptr, mask);
         }
-        else if (iter->fd == elem.fd) {
-            BOOST_ACTOR_REQUIRE(iter->ptr == elem.ptr);
+        else {
+            BOOST_ACTOR_REQUIRE(m_meta[pos].ptr == elem.ptr);
             if (mask == event::none) {
                 // note: we cannot decide whether it's safe to dispose `ptr`,
                 // because we didn't parse all alterations yet
                 m_dispose_list.emplace_back(ptr);
-                m_meta.erase(iter);
-                handle_event(fd_meta_event::erase, elem.fd, old, mask, ptr);
-            }
-            else {
-                iter->mask = mask;
-                handle_event(fd_meta_event::mod, elem.fd, old, mask, ptr);
+                erase_meta(pos);
             }
+            else m_meta[pos].mask = mask;
         }
     }
     m_alterations.clear();
-    // m_meta won't be touched inside loop
-    auto first = m_meta.begin();
-    auto last = m_meta.end();
+    // the first change of each fd stores its bitmask before this update
+    std::stable_sort(m_changes.begin(), m_changes.end(),
+                     [](const fd_meta_info& lhs, const fd_meta_info& rhs) {
+                         return lhs.fd < rhs.fd;
+                     });
+    auto last = std::unique(m_changes.begin(), m_changes.end(),
+                            [](const fd_meta_info& lhs,
+                               const fd_meta_info& rhs) {
+                                return lhs.fd == rhs.fd;
+                            });
+    for (auto i = m_changes.begin(); i != last; ++i) {
+        auto pos = index_of(i->fd);
+        auto old = i->mask;
+        auto mask = pos != npos ? os_bitmask(m_meta[pos].ptr, m_meta[pos].mask)
+                                : event::none;
+        if (mask == old) continue;
+        if (old == event::none) {
+            handle_event(fd_meta_event::add, i->fd, old, mask,
+                         m_meta[pos].ptr);
+        }
+        else if (mask == event::none) {
+            handle_event(fd_meta_event::erase, i->fd, old, mask, i->ptr);
+        }
+        else {
+            handle_event(fd_meta_event::mod, i->fd, old, mask,
+                         m_meta[pos].ptr);
+        }
+    }
+    m_changes.clear();
     // checks whether an element can be safely deleted,
     // i.e., was not put back into m_meta by some alteration
     auto is_alive = [&](native_socket_type fd) -> bool {
-        auto iter = std::lower_bound(first, last, fd, mless);
-        return iter != last && iter->fd == fd;
+        return index_of(fd) != npos;
     };
     // dispose everything that wasn't put back into m_meta again
     for (auto elem : m_dispose_list) {
@@ -150,16 +203,84 @@ void middleman_event_handler::update() {
     m_dispose_list.clear();
 }
 
+void middleman_event_handler::use_doorbell(continuable* ptr) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(ptr));
+    BOOST_ACTOR_REQUIRE(ptr->read_handle() == ptr->write_handle());
+    if (ptr->m_doorbell) return;
+    auto fd = ptr->read_handle();
+    auto pos = index_of(fd);
+    if (pos == npos || m_meta[pos].ptr != ptr) {
+        ptr->m_doorbell = true;
+        return;
+    }
+    // update the registration right away, because the OS
+    // would otherwise keep reporting the handle as writable
+    auto old = os_bitmask(ptr, m_meta[pos].mask);
+    ptr->m_doorbell = true;
+    auto mask = os_bitmask(ptr, m_meta[pos].mask);
+    if (old != mask) handle_event(fd_meta_event::mod, fd, old, mask, ptr);
+}
+
+event_bitmask middleman_event_handler::doorbell_event(event_bitmask e,
+                                                      continuable* ptr) const {
+    if ((e & event::read) == 0) return e;
+    auto pos = index_of(ptr->read_handle());
+    if (pos == npos || m_meta[pos].mask == event::none) return e;
+    return m_meta[pos].mask;
+}
+
 bool middleman_event_handler::has_reader(continuable* ptr) {
-    return std::any_of(m_meta.begin(), m_meta.end(), [=](fd_meta_info& meta) {
-        return meta.ptr == ptr && (meta.mask & event::read);
-    });
+    auto pos = index_of(ptr->read_handle());
+    return    pos != npos
+           && m_meta[pos].ptr == ptr
+           && (m_meta[pos].mask & event::read);
 }
 
 bool middleman_event_handler::has_writer(continuable* ptr) {
-    return std::any_of(m_meta.begin(), m_meta.end(), [=](fd_meta_info& meta) {
-        return meta.ptr == ptr && (meta.mask & event::write);
-    });
+    auto pos = index_of(ptr->write_handle());
+    return    pos != npos
+           && m_meta[pos].ptr == ptr
+           && (m_meta[pos].mask & event::write);
+}
+
+#ifdef BOOST_WINDOWS
+
+size_t middleman_event_handler::index_of(native_socket_type fd) const {
+    auto i = m_index.find(fd);
+    return i != m_index.end() ? i->second : npos;
+}
+
+void middleman_event_handler::set_index(native_socket_type fd, size_t pos) {
+    if (pos == npos) m_index.erase(fd);
+    else m_index[fd] = pos;
+}
+
+#else // BOOST_WINDOWS
+
+size_t middleman_event_handler::index_of(native_socket_type fd) const {
+    auto i = static_cast<size_t>(fd);
+    return i < m_index.size() ? m_index[i] : npos;
+}
+
+void middleman_event_handler::set_index(native_socket_type fd, size_t pos) {
+    auto i = static_cast<size_t>(fd);
+    if (i >= m_index.size()) {
+        if (pos == npos) return;
+        m_index.resize(i + 1, npos);
+    }
+    m_index[i] = pos;
+}
+
+#endif // BOOST_WINDOWS
+
+void middleman_event_handler::erase_meta(size_t pos) {
+    auto fd = m_meta[pos].fd;
+    if (pos + 1 < m_meta.size()) {
+        m_meta[pos] = m_meta.back();
+        set_index(m_meta[pos].fd, pos);
+    }
+    m_meta.pop_back();
+    set_index(fd, npos);
 }
 
 } } // namespace actor
@@ -114,11 +114,13 @@ class middleman_event_handler_impl : public middleman_event_handler {
                 break;
             case event::write:
                 ee.events = EPOLLOUT;
+                break;
             case event::both:
                 ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
                 break;
             default: BOOST_ACTOR_CRITICAL("invalid event bitmask");
         }
+        if (m_edge_triggered) ee.events |= EPOLLET;
         switch (me) {
             case fd_meta_event::add:
                 operation = EPOLL_CTL_ADD;
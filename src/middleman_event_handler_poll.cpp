@@ -51,10 +51,6 @@ static constexpr unsigned input_event  = POLLIN | POLLPRI;
 static constexpr unsigned error_event  = POLLRDHUP | POLLERR | POLLHUP | POLLNVAL;
 static constexpr unsigned output_event = POLLOUT;
 
-bool pollfd_less(const pollfd& lhs, native_socket_type rhs) {
-    return lhs.fd < rhs;
-}
-
 short to_poll_bitmask(event_bitmask mask) {
     switch (mask) {
         case event::read:  return POLLIN;
@@ -68,11 +64,26 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
  public:
 
+    middleman_event_handler_impl() : m_dirty(false) { }
+
     void init() { }
 
  protected:
 
     void poll_impl() {
+        if (m_dirty) {
+            // poll() is O(n) anyways, so we simply rebuild
+            // the pollset whenever m_meta has changed
+            m_pollset.clear();
+            for (auto& meta : m_meta) {
+                pollfd tmp;
+                tmp.fd = meta.fd;
+                tmp.events = to_poll_bitmask(os_bitmask(meta.ptr, meta.mask));
+                tmp.revents = 0;
+                m_pollset.push_back(tmp);
+            }
+            m_dirty = false;
+        }
         BOOST_ACTOR_REQUIRE(m_pollset.empty() == false);
         BOOST_ACTOR_REQUIRE(m_pollset.size() == m_meta.size());
         int presult = -1;
@@ -116,49 +127,19 @@ class middleman_event_handler_impl : public middleman_event_handler {
         }
     }
 
-    void handle_event(fd_meta_event me,
-                      native_socket_type fd,
+    void handle_event(fd_meta_event,
+                      native_socket_type,
+                      event_bitmask,
                       event_bitmask,
-                      event_bitmask new_bitmask,
                       continuable*) {
-        auto last = m_pollset.end();
-        auto iter = std::lower_bound(m_pollset.begin(), last, fd, pollfd_less);
-        switch (me) {
-            case fd_meta_event::add: {
-                pollfd tmp;
-                tmp.fd = fd;
-                tmp.events = to_poll_bitmask(new_bitmask);
-                tmp.revents = 0;
-                m_pollset.insert(iter, tmp);
-                BOOST_ACTOR_LOG_DEBUG("inserted new element");
-                break;
-            }
-            case fd_meta_event::erase: {
-                BOOST_ACTOR_LOG_ERROR_IF(iter == last || iter->fd != fd,
-                                  "m_meta and m_pollset out of sync; "
-                                  "no element found for fd (cannot erase)");
-                if (iter != last && iter->fd == fd) {
-                    BOOST_ACTOR_LOG_DEBUG("erased element");
-                    m_pollset.erase(iter);
-                }
-                break;
-            }
-            case fd_meta_event::mod: {
-                BOOST_ACTOR_LOG_ERROR_IF(iter == last || iter->fd != fd,
-                                  "m_meta and m_pollset out of sync; "
-                                  "no element found for fd (cannot erase)");
-                if (iter != last && iter->fd == fd) {
-                    BOOST_ACTOR_LOG_DEBUG("updated bitmask");
-                    iter->events = to_poll_bitmask(new_bitmask);
-                }
-                break;
-            }
-        }
+        m_dirty = true;
     }
 
  private:
 
-    std::vector<pollfd> m_pollset; // always in sync with m_meta
+    std::vector<pollfd> m_pollset; // in sync with m_meta unless m_dirty
+
+    bool m_dirty;
 
 };
 
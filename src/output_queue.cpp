@@ -0,0 +1,113 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <atomic>
+#include <algorithm>
+
+#include "boost/actor/io/output_queue.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+namespace {
+
+std::atomic<size_t> s_coalescing_threshold{16 * 1024};
+
+// maximum number of chunks passed to a single gather write
+constexpr size_t max_gather_chunks = 64;
+
+} // namespace <anonymous>
+
+void coalescing_threshold(size_t num_bytes) {
+    s_coalescing_threshold = num_bytes;
+}
+
+size_t coalescing_threshold() {
+    return s_coalescing_threshold;
+}
+
+buffer& output_queue::push_chunk() {
+    m_chunks.push_back(std::move(m_spare));
+    return m_chunks.back();
+}
+
+buffer& output_queue::next_chunk() {
+    if (m_chunks.empty() || m_chunks.back().size() >= coalescing_threshold()) {
+        return push_chunk();
+    }
+    return m_chunks.back();
+}
+
+void output_queue::write(size_t num_bytes, const void* data) {
+    if (num_bytes > 0) next_chunk().write(num_bytes, data);
+}
+
+void output_queue::write(buffer&& buf) {
+    if (buf.empty()) return;
+    if (   !m_chunks.empty()
+        && m_chunks.back().size() + buf.size() <= coalescing_threshold()) {
+        m_chunks.back().write(buf.size(), buf.data());
+        buf.clear();
+    }
+    else m_chunks.push_back(std::move(buf));
+}
+
+bool output_queue::flush(output_stream* out) {
+    const_buffer bufs[max_gather_chunks];
+    size_t num_bufs = 0;
+    size_t total = 0;
+    for (auto& chunk : m_chunks) {
+        if (num_bufs == max_gather_chunks) break;
+        auto offset = (num_bufs == 0) ? m_offset : 0;
+        auto& cb = bufs[num_bufs++];
+        cb.data = chunk.offset_data(offset);
+        cb.size = chunk.size() - offset;
+        total += cb.size;
+    }
+    if (num_bufs == 0) return true;
+    auto written = out->write_some(bufs, num_bufs);
+    // drop all completely written chunks
+    auto remaining = written + m_offset;
+    while (!m_chunks.empty() && remaining >= m_chunks.front().size()) {
+        remaining -= m_chunks.front().size();
+        auto& chunk = m_chunks.front();
+        // keep one chunk for reuse unless it is significantly larger
+        // than chunks created by coalescing small writes
+        if (chunk.allocated() <= 2 * coalescing_threshold()) {
+            chunk.clear();
+            m_spare = std::move(chunk);
+        }
+        m_chunks.pop_front();
+    }
+    m_offset = m_chunks.empty() ? 0 : remaining;
+    return written == total;
+}
+
+bool output_queue::empty() const {
+    return m_chunks.empty();
+}
+
+void output_queue::clear() {
+    m_chunks.clear();
+    m_offset = 0;
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
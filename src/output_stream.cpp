@@ -24,6 +24,16 @@ namespace io {
 
 output_stream::~output_stream() { }
 
+size_t output_stream::write_some(const const_buffer* bufs, size_t num_bufs) {
+    size_t result = 0;
+    for (size_t i = 0; i < num_bufs; ++i) {
+        auto written = write_some(bufs[i].data, bufs[i].size);
+        result += written;
+        if (written < bufs[i].size) return result;
+    }
+    return result;
+}
+
 } // namespace io
 } // namespace actor
 } // namespace boost
@@ -16,8 +16,10 @@
 \******************************************************************************/
 
 
+#include <atomic>
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 
 #include "boost/actor/on.hpp"
 #include "boost/actor/all.hpp"
@@ -47,21 +49,91 @@ namespace boost {
 namespace actor {
 namespace io {
 
+namespace {
+
+// the highest bit of the size prefix marks messages in wire format v2,
+// which is never set by v1 peers since max_msg_size() is well below 2GB
+constexpr uint32_t v2_frame_flag = 0x80000000;
+
+// the second highest bit marks compressed messages, which start with
+// the algorithm (1 byte) and the uncompressed size (4 bytes)
+constexpr uint32_t compressed_frame_flag = 0x40000000;
+
+constexpr size_t compression_header_size = sizeof(uint8_t) + sizeof(uint32_t);
+
+// the third highest bit marks fragments, which start with the lane (1 byte);
+// the fragments of a lane form a stream of regular frames
+constexpr uint32_t fragment_frame_flag = 0x20000000;
+
+constexpr uint32_t frame_flags =   v2_frame_flag
+                                 | compressed_frame_flag
+                                 | fragment_frame_flag;
+
+std::atomic<size_t> s_fragment_size{16 * 1024};
+
+// maximum number of queued messages serialized before writing them
+constexpr size_t max_write_batch = 64;
+
+} // namespace <anonymous>
+
+void fragment_size(size_t num_bytes) {
+    s_fragment_size = num_bytes;
+}
+
+size_t fragment_size() {
+    return s_fragment_size;
+}
+
 peer::peer(middleman* parent,
            const input_stream_ptr& in,
            const output_stream_ptr& out,
            node_id_ptr peer_ptr)
 : super(parent, out, in->read_handle(), out->write_handle())
-, m_in(in), m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
+, m_in(in), m_state((peer_ptr) ? read_messages : wait_for_process_info)
 , m_node(peer_ptr) {
-    m_rd_buf.final_size( m_state == wait_for_process_info
-                       ? sizeof(uint32_t) + node_id::host_id_size
-                       : sizeof(uint32_t));
-    // state == wait_for_msg_size iff peer was created using remote_peer()
+    // state == read_messages iff peer was created using remote_peer()
     // in this case, this peer must be erased if no proxy of it remains
-    m_stop_on_last_proxy_exited = m_state == wait_for_msg_size;
+    m_stop_on_last_proxy_exited = m_state == read_messages;
+    m_outgoing_format = wire_format::v1;
+    m_outgoing_compression = compression::none;
+    m_outgoing_fragments = false;
+    m_shm_input_pending = false;
+    m_shm_output = false;
+    m_shm_armed = false;
+    auto io = dynamic_cast<stream*>(in.get());
+    if (io && static_cast<output_stream*>(io) == out.get()) m_doorbell = io;
     m_meta_hdr = uniform_typeid<message_header>();
     m_meta_msg = uniform_typeid<message>();
+    m_current_hdr = nullptr;
+    init_content_handler();
+    // announce the highest wire format we can read; peers that do not
+    // know this message ignore it and we keep sending v1 messages
+    auto fmt = max_wire_format();
+    if (fmt != wire_format::v1) {
+        enqueue(make_message(atom("WIRE_FMT"), static_cast<uint32_t>(fmt)));
+    }
+    // announce all compression algorithms we are able to decompress
+    auto algorithms = available_compressions();
+    if (algorithms != 0) {
+        enqueue(make_message(atom("COMPRESS"), algorithms));
+    }
+    // announce the number of lanes we are able to reassemble
+    enqueue(make_message(atom("FRAGMENTS"),
+                         static_cast<uint32_t>(num_message_lanes)));
+    // the connecting side offers shared memory to nodes on the same host;
+    // the remote node answers with SHM_SWITCH or SHM_NACK unless it does
+    // not know this message, in which case we simply keep using m_doorbell
+    if (   m_node && m_doorbell && shm_ring_size() > 0
+        && m_node->host_id() == parent->node()->host_id()) {
+        try {
+            m_shm = shm_io_stream::create(m_doorbell, shm_ring_size());
+            enqueue(make_message(atom("SHM_OPEN"), m_shm->name()));
+        }
+        catch (std::exception& e) {
+            BOOST_ACTOR_LOG_INFO("shared memory not available: " << e.what());
+            static_cast<void>(e); // keep compiler happy
+        }
+    }
 }
 
 void peer::io_failed(event_bitmask mask) {
@@ -70,7 +142,7 @@ void peer::io_failed(event_bitmask mask) {
     // make sure this code is executed only once by filtering for read failure
     if (mask == event::read && m_node) {
         // kill all proxies
-        auto& children = parent()->get_namespace().proxies(*m_node);
+        auto children = parent()->get_namespace().proxies(*m_node);
         for (auto& kvp : children) {
             auto ptr = kvp.second;
             send_as(ptr, ptr, atom("KILL_PROXY"),
@@ -83,23 +155,22 @@ void peer::io_failed(event_bitmask mask) {
 continue_reading_result peer::continue_reading() {
     BOOST_ACTOR_LOG_TRACE("");
     for (;;) {
-        try { m_rd_buf.append_from(m_in.get()); }
+        bool more_data;
+        try { more_data = m_rd_buf.fill(m_in.get()); }
         catch (std::exception&) {
             return continue_reading_result::failure;
         }
-        if (!m_rd_buf.full()) {
-            // try again later
-            return continue_reading_result::continue_later;
-        }
-        switch (m_state) {
-            case wait_for_process_info: {
-                //DEBUG("peer_connection::continue_reading: "
-                //      "wait_for_process_info");
+        // process all complete frames received so far
+        for (;;) {
+            if (m_state == wait_for_process_info) {
+                auto frame_size = sizeof(uint32_t) + node_id::host_id_size;
+                if (m_rd_buf.available() < frame_size) break;
                 uint32_t process_id;
                 node_id::host_id_type host_id;
                 memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(host_id.data(), m_rd_buf.offset_data(sizeof(uint32_t)),
+                memcpy(host_id.data(), m_rd_buf.data() + sizeof(uint32_t),
                        node_id::host_id_size);
+                m_rd_buf.consume(frame_size);
                 m_node.reset(new node_id(process_id, host_id));
                 if (*parent()->node() == *m_node) {
                     std::cerr << "*** middleman warning: "
@@ -114,71 +185,197 @@ continue_reading_result peer::continue_reading() {
                     return continue_reading_result::failure;
                 }
                 // initialization done
-                m_state = wait_for_msg_size;
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                break;
-            }
-            case wait_for_msg_size: {
-                //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
-                uint32_t msg_size;
-                memcpy(&msg_size, m_rd_buf.data(), sizeof(uint32_t));
-                m_rd_buf.clear();
-                m_rd_buf.final_size(msg_size);
-                m_state = read_message;
-                break;
+                m_state = read_messages;
+                // read again even after a partial read, because a remote
+                // node closing the connection right after the handshake
+                // must be unregistered before it connects again
+                more_data = true;
             }
-            case read_message: {
-                //DEBUG("peer_connection::continue_reading: read_message");
-                message_header hdr;
-                message msg;
-                binary_deserializer bd(m_rd_buf.data(), m_rd_buf.size(),
-                                       &(parent()->get_namespace()), &m_incoming_types);
-                try {
-                    m_meta_hdr->deserialize(&hdr, &bd);
-                    m_meta_msg->deserialize(&msg, &bd);
+            else {
+                if (m_rd_buf.available() < sizeof(uint32_t)) break;
+                uint32_t prefix;
+                memcpy(&prefix, m_rd_buf.data(), sizeof(uint32_t));
+                auto msg_size = prefix & ~frame_flags;
+                if (msg_size > max_msg_size()) {
+                    BOOST_ACTOR_LOG_ERROR("incoming message exceeds "
+                                          "max_msg_size(): " << msg_size);
+                    return continue_reading_result::failure;
+                }
+                auto frame_size = sizeof(uint32_t) + msg_size;
+                if (m_rd_buf.available() < frame_size) {
+                    // wait for the remainder of this frame
+                    m_rd_buf.reserve(frame_size);
+                    break;
                 }
-                catch (std::exception& e) {
-                    BOOST_ACTOR_LOG_ERROR("exception during read_message: "
-                                   << detail::demangle(typeid(e))
-                                   << ", what(): " << e.what());
+                // deserialize directly from the receive buffer
+                if (!handle_frame(prefix, m_rd_buf.data() + sizeof(uint32_t),
+                                  msg_size)) {
                     return continue_reading_result::failure;
                 }
-                BOOST_ACTOR_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
-                message_handler pf {
-                    // monitor messages are sent automatically whenever
-                    // actor_proxy_cache creates a new proxy
-                    // note: aid is the *original* actor id
-                    on(atom("MONITOR"), arg_match) >> [&](const node_id_ptr& node, actor_id aid) {
-                        monitor(hdr.sender, node, aid);
-                    },
-                    on(atom("KILL_PROXY"), arg_match) >> [&](const node_id_ptr& node, actor_id aid, std::uint32_t reason) {
-                        kill_proxy(hdr.sender, node, aid, reason);
-                    },
-                    on(atom("LINK"), arg_match) >> [&](const actor_addr& ptr) {
-                        link(hdr.sender, ptr);
-                    },
-                    on(atom("UNLINK"), arg_match) >> [&](const actor_addr& ptr) {
-                        unlink(hdr.sender, ptr);
-                    },
-                    on(atom("ADD_TYPE"), arg_match) >> [&](std::uint32_t id, const std::string& name) {
-                        auto imap = get_uniform_type_info_map();
-                        auto uti = imap->by_uniform_name(name);
-                        m_incoming_types.emplace(id, uti);
-                    },
-                    others() >> [&] {
-                        deliver(hdr, move(msg));
-                    }
-                };
-                pf(msg);
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                m_state = wait_for_msg_size;
-                break;
+                m_rd_buf.consume(frame_size);
+                if (m_shm_input_pending) {
+                    BOOST_ACTOR_LOG_DEBUG("read further data from shared memory");
+                    m_shm_input_pending = false;
+                    // discard doorbell rings received via the old stream
+                    m_rd_buf.consume(m_rd_buf.available());
+                    m_in = m_shm;
+                    more_data = true;
+                }
+            }
+        }
+        // a partial read means we have drained the socket
+        if (!more_data) return continue_reading_result::continue_later;
+    }
+}
+
+bool peer::handle_frame(uint32_t prefix, const char* data, size_t size) {
+    if (prefix & fragment_frame_flag) return handle_fragment(data, size);
+    auto fmt = (prefix & v2_frame_flag) ? wire_format::v2 : wire_format::v1;
+    if (prefix & compressed_frame_flag) {
+        data = decompressed(data, size);
+        if (!data) return false;
+    }
+    return handle_message(fmt, data, size);
+}
+
+bool peer::handle_fragment(const char* data, size_t size) {
+    if (size < sizeof(uint8_t) || static_cast<uint8_t>(*data) >= num_message_lanes) {
+        BOOST_ACTOR_LOG_ERROR("received invalid fragment");
+        return false;
+    }
+    auto& buf = m_lanes[static_cast<uint8_t>(*data)].received;
+    buf.insert(buf.end(), data + sizeof(uint8_t), data + size);
+    // process all frames completed by this fragment
+    size_t pos = 0;
+    while (buf.size() - pos >= sizeof(uint32_t)) {
+        uint32_t prefix;
+        memcpy(&prefix, buf.data() + pos, sizeof(uint32_t));
+        auto msg_size = prefix & ~frame_flags;
+        if ((prefix & fragment_frame_flag) || msg_size > max_msg_size()) {
+            BOOST_ACTOR_LOG_ERROR("received invalid fragmented message");
+            return false;
+        }
+        if (buf.size() - pos - sizeof(uint32_t) < msg_size) break;
+        if (!handle_frame(prefix, buf.data() + pos + sizeof(uint32_t),
+                          msg_size)) {
+            return false;
+        }
+        pos += sizeof(uint32_t) + msg_size;
+    }
+    buf.erase(buf.begin(), buf.begin() + static_cast<ptrdiff_t>(pos));
+    return true;
+}
+
+const char* peer::decompressed(const char* data, size_t& size) {
+    if (size < compression_header_size) {
+        BOOST_ACTOR_LOG_ERROR("received invalid compressed message");
+        return nullptr;
+    }
+    uint8_t algorithm;
+    uint32_t original_size;
+    memcpy(&algorithm, data, sizeof(uint8_t));
+    memcpy(&original_size, data + sizeof(uint8_t), sizeof(uint32_t));
+    if (original_size > max_msg_size()) {
+        BOOST_ACTOR_LOG_ERROR("decompressed message exceeds "
+                              "max_msg_size(): " << original_size);
+        return nullptr;
+    }
+    m_decompress_buf.resize(original_size);
+    if (!decompress(static_cast<compression>(algorithm),
+                    data + compression_header_size,
+                    size - compression_header_size,
+                    m_decompress_buf.data(), original_size)) {
+        BOOST_ACTOR_LOG_ERROR("unable to decompress message");
+        return nullptr;
+    }
+    size = original_size;
+    return m_decompress_buf.data();
+}
+
+void peer::init_content_handler() {
+    m_content_handler = message_handler{
+        // monitor messages are sent automatically whenever
+        // actor_proxy_cache creates a new proxy
+        // note: aid is the *original* actor id
+        on(atom("MONITOR"), arg_match) >> [=](const node_id_ptr& node, actor_id aid) {
+            monitor(m_current_hdr->sender, node, aid);
+        },
+        on(atom("KILL_PROXY"), arg_match) >> [=](const node_id_ptr& node, actor_id aid, std::uint32_t reason) {
+            kill_proxy(m_current_hdr->sender, node, aid, reason);
+        },
+        on(atom("LINK"), arg_match) >> [=](const actor_addr& ptr) {
+            link(m_current_hdr->sender, ptr);
+        },
+        on(atom("UNLINK"), arg_match) >> [=](const actor_addr& ptr) {
+            unlink(m_current_hdr->sender, ptr);
+        },
+        on(atom("ADD_TYPE"), arg_match) >> [=](std::uint32_t id, const std::string& name) {
+            auto imap = get_uniform_type_info_map();
+            auto uti = imap->by_uniform_name(name);
+            m_incoming_types.emplace(id, uti);
+        },
+        on(atom("WIRE_FMT"), arg_match) >> [=](std::uint32_t version) {
+            // use the highest format both sides are able to read
+            auto fmt = static_cast<uint32_t>(max_wire_format());
+            version = std::min(version, fmt);
+            if (version >= static_cast<uint32_t>(wire_format::v2)) {
+                m_outgoing_format = wire_format::v2;
+            }
+        },
+        on(atom("COMPRESS"), arg_match) >> [=](std::uint32_t algorithms) {
+            // compress only if enabled and supported by the remote node
+            auto algorithm = compression_algorithm();
+            if ((algorithms & static_cast<uint32_t>(algorithm)) != 0) {
+                m_outgoing_compression = algorithm;
+            }
+        },
+        on(atom("FRAGMENTS"), arg_match) >> [=](std::uint32_t lanes) {
+            m_outgoing_fragments = lanes >= num_message_lanes;
+        },
+        on(atom("SHM_OPEN"), arg_match) >> [=](const std::string& name) {
+            open_shm(name);
+        },
+        on(atom("SHM_NACK")) >> [=] {
+            BOOST_ACTOR_LOG_INFO("remote node cannot use shared memory");
+            m_shm.reset();
+        },
+        on(atom("SHM_SWITCH")) >> [=] {
+            if (!m_shm || m_shm_input_pending) {
+                BOOST_ACTOR_LOG_ERROR("received invalid SHM_SWITCH");
+                return;
             }
+            m_shm_input_pending = true;
+            // the remote node has mapped our segment
+            m_shm->unlink();
+            if (!m_shm_output) switch_to_shm_output();
         }
-        // try to read more (next iteration)
+    };
+}
+
+bool peer::handle_message(wire_format fmt, const char* data, size_t size) {
+    message_header hdr;
+    message msg;
+    binary_deserializer bd(data, size,
+                           &(parent()->get_namespace()), &m_incoming_types,
+                           fmt, &m_incoming_nodes);
+    try {
+        m_meta_hdr->deserialize(&hdr, &bd);
+        m_meta_msg->deserialize(&msg, &bd);
     }
+    catch (std::exception& e) {
+        BOOST_ACTOR_LOG_ERROR("exception during handle_message: "
+                       << detail::demangle(typeid(e))
+                       << ", what(): " << e.what());
+        return false;
+    }
+    BOOST_ACTOR_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
+    // system messages start with an atom and are dispatched by
+    // m_content_handler, everything else is delivered to its receiver
+    m_current_hdr = &hdr;
+    auto handled = m_content_handler(msg);
+    m_current_hdr = nullptr;
+    if (!handled) deliver(hdr, move(msg));
+    return true;
 }
 
 void peer::monitor(const actor_addr&,
@@ -197,8 +394,12 @@ void peer::monitor(const actor_addr&,
     }
     else if (entry.first == nullptr) {
         if (entry.second == exit_reason::not_exited) {
-            BOOST_ACTOR_LOG_ERROR("received MONITOR for unknown "
-                           "actor id: " << aid);
+            // the registry forgets the exit reason of actors that
+            // exited long ago; the remote proxy is stale either way
+            BOOST_ACTOR_LOG_WARNING("received MONITOR for unknown "
+                                    "actor id: " << aid);
+            enqueue(make_message(atom("KILL_PROXY"), pself, aid,
+                                 exit_reason::remote_link_unreachable));
         }
         else {
             BOOST_ACTOR_LOG_DEBUG("received MONITOR for an actor "
@@ -214,7 +415,7 @@ void peer::monitor(const actor_addr&,
         BOOST_ACTOR_LOG_DEBUG("attach functor to " << entry.first.get());
         auto mm = parent();
         entry.first->attach_functor([=](uint32_t reason) {
-            mm->run_later([=] {
+            mm->run_later(*node, [=] {
                 BOOST_ACTOR_LOGC_TRACE("cppa::io::peer",
                                 "monitor$kill_proxy_helper",
                                 "reason = " << reason);
@@ -322,14 +523,54 @@ void peer::unlink(const actor_addr& lhs, const actor_addr& rhs) {
     }
 }
 
+void peer::open_shm(const std::string& name) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(name));
+    if (   !m_shm && m_node && m_doorbell && shm_ring_size() > 0
+        && m_node->host_id() == parent()->node()->host_id()) {
+        // the name is chosen by the remote node, i.e., we must
+        // not open (and unlink) anything it did not create itself
+        auto creator = m_node->process_id();
+        if (!shm_io_stream::is_valid_name(name, creator)) {
+            BOOST_ACTOR_LOG_ERROR("received invalid SHM_OPEN: " << name);
+        }
+        else {
+            try { m_shm = shm_io_stream::open(m_doorbell, name, creator); }
+            catch (std::exception& e) {
+                BOOST_ACTOR_LOG_INFO("cannot use shared memory: " << e.what());
+                static_cast<void>(e); // keep compiler happy
+            }
+        }
+    }
+    if (!m_shm) enqueue(make_message(atom("SHM_NACK")));
+    else switch_to_shm_output();
+}
+
+void peer::switch_to_shm_output() {
+    // the remote node reads SHM_SWITCH as last message from m_doorbell
+    write_control_message(make_message(atom("SHM_SWITCH")));
+    switch_output(m_shm);
+    m_shm_output = true;
+}
+
+void peer::write_control_message(const message& msg) {
+    add_type_if_needed(msg);
+    write_frame(write_buffer(), {invalid_actor_addr, nullptr},
+                msg, m_outgoing_format);
+    register_for_writing();
+}
+
 continue_writing_result peer::continue_writing() {
     BOOST_ACTOR_LOG_TRACE("");
     auto result = super::continue_writing();
-    while (result == continue_writing_result::done && !queue().empty()) {
-        auto tmp = queue().pop();
-        enqueue(tmp.first, tmp.second);
+    while (result == continue_writing_result::done && write_next()) {
         result = super::continue_writing();
     }
+    if (m_shm_output && !m_shm_armed && !switching_output()) {
+        // from now on, m_doorbell transfers nothing but doorbell rings
+        m_shm_armed = true;
+        m_shm->arm();
+        parent()->use_doorbell(this);
+    }
     if (result == continue_writing_result::done
             && stop_on_last_proxy_exited()
             && !has_unwritten_data()) {
@@ -340,24 +581,75 @@ continue_writing_result peer::continue_writing() {
     return result;
 }
 
-void peer::add_type_if_needed(const std::string& tname) {
-    if (m_outgoing_types.id_of(tname) == 0) {
+bool peer::write_next() {
+    // m_queue is not set until the peer has been registered, i.e.,
+    // we might write the WIRE_FMT announcement before
+    auto has_queued = [&](message_lane l) {
+        return m_queue != nullptr && !queue().empty(l);
+    };
+    // each lane is strictly FIFO, but a lane is only allowed to
+    // write a single fragment if a lane with higher priority has data
+    for (size_t i = 0; i < num_message_lanes; ++i) {
+        auto& lane = m_lanes[i];
+        if (lane.written < lane.pending.size()) {
+            auto num_bytes = std::min(std::max(fragment_size(), size_t{1}),
+                                      lane.pending.size() - lane.written);
+            auto prefix =   static_cast<uint32_t>(num_bytes + sizeof(uint8_t))
+                          | fragment_frame_flag;
+            auto id = static_cast<uint8_t>(i);
+            auto& wbuf = write_buffer();
+            wbuf.write(sizeof(uint32_t), &prefix);
+            wbuf.write(sizeof(uint8_t), &id);
+            wbuf.write(num_bytes, lane.pending.data() + lane.written);
+            lane.written += num_bytes;
+            if (lane.written == lane.pending.size()) {
+                lane.pending.clear();
+                lane.written = 0;
+            }
+            register_for_writing();
+            return true;
+        }
+        auto l = static_cast<message_lane>(i);
+        if (has_queued(l)) {
+            // write a batch of messages with a single system call;
+            // pop() always returns a message of the highest priority lane
+            size_t num = 0;
+            do {
+                auto tmp = queue().pop();
+                enqueue_impl(tmp.first, tmp.second);
+            }
+            while (++num < max_write_batch && has_queued(l));
+            register_for_writing();
+            return true;
+        }
+    }
+    return false;
+}
+
+void peer::add_type_if_needed(const message& msg) {
+    auto tname = msg.tuple_type_names();
+    auto name = (tname) ? *tname : detail::get_tuple_type_names(*msg.vals());
+    if (m_outgoing_types.id_of(name) == 0) {
         auto id = m_outgoing_types.max_id() + 1;
         auto imap = get_uniform_type_info_map();
-        auto uti = imap->by_uniform_name(tname);
+        auto uti = imap->by_uniform_name(name);
         m_outgoing_types.emplace(id, uti);
-        enqueue_impl({invalid_actor_addr, nullptr}, make_message(atom("ADD_TYPE"), id, tname));
+        // type announcements never wait in a lane, because they must
+        // arrive before any message using the type
+        auto add_msg = make_message(atom("ADD_TYPE"), id, name);
+        add_type_if_needed(add_msg);
+        write_frame(write_buffer(), {invalid_actor_addr, nullptr},
+                    add_msg, m_outgoing_format);
     }
 }
 
-void peer::enqueue_impl(msg_hdr_cref hdr, const message& msg) {
-    BOOST_ACTOR_LOG_TRACE("");
-    auto tname = msg.tuple_type_names();
-    add_type_if_needed((tname) ? *tname : detail::get_tuple_type_names(*msg.vals()));
+bool peer::write_frame(buffer& wbuf, msg_hdr_cref hdr,
+                       const message& msg, wire_format fmt) {
     uint32_t size = 0;
-    auto& wbuf = write_buffer();
     auto before = static_cast<uint32_t>(wbuf.size());
-    binary_serializer bs(&wbuf, &(parent()->get_namespace()), &m_outgoing_types);
+    auto known_nodes = m_outgoing_nodes.size();
+    binary_serializer bs(&wbuf, &(parent()->get_namespace()), &m_outgoing_types,
+                         fmt, &m_outgoing_nodes);
     wbuf.write(sizeof(uint32_t), &size);
     try { bs << hdr << msg; }
     catch (std::exception& e) {
@@ -365,13 +657,67 @@ void peer::enqueue_impl(msg_hdr_cref hdr, const message& msg) {
         cerr << "*** exception in peer::enqueue; "
              << to_verbose_string(e)
              << endl;
-        return;
+        // discard the partially serialized message
+        wbuf.erase_trailing(wbuf.size() - before);
+        // the peer never sees node IDs added by this message
+        m_outgoing_nodes.shrink(known_nodes);
+        return false;
     }
     BOOST_ACTOR_LOG_DEBUG("serialized: " << to_string(hdr) << " " << to_string(msg));
     size =   static_cast<std::uint32_t>((wbuf.size() - before))
            - static_cast<std::uint32_t>(sizeof(std::uint32_t));
+    if (   m_outgoing_compression != compression::none
+        && size >= compression_threshold()
+        && compress(m_outgoing_compression,
+                    wbuf.offset_data(before + sizeof(uint32_t)), size,
+                    m_compress_buf)) {
+        // replace serialized message with its compressed representation
+        wbuf.erase_trailing(size);
+        auto algorithm = static_cast<uint8_t>(m_outgoing_compression);
+        wbuf.write(sizeof(uint8_t), &algorithm);
+        wbuf.write(sizeof(uint32_t), &size);
+        wbuf.write(m_compress_buf.size(), m_compress_buf.data());
+        size =   static_cast<uint32_t>(m_compress_buf.size()
+                                       + compression_header_size)
+               | compressed_frame_flag;
+    }
+    if (fmt == wire_format::v2) size |= v2_frame_flag;
     // update size in buffer
     memcpy(wbuf.offset_data(before), &size, sizeof(std::uint32_t));
+    return true;
+}
+
+void peer::enqueue_impl(msg_hdr_cref hdr, const message& msg) {
+    BOOST_ACTOR_LOG_TRACE("");
+    add_type_if_needed(msg);
+    auto& wbuf = write_buffer();
+    auto before = wbuf.size();
+    auto known_nodes = m_outgoing_nodes.size();
+    if (!write_frame(wbuf, hdr, msg, m_outgoing_format)) return;
+    auto& lane = m_lanes[static_cast<size_t>(lane_of(hdr))];
+    auto frame_size = wbuf.size() - before;
+    if (   lane.pending.empty()
+        && (!m_outgoing_fragments || frame_size <= fragment_size())) {
+        return;
+    }
+    // move the frame to its lane to send it in fragments later on
+    if (m_outgoing_nodes.size() != known_nodes) {
+        // messages of other lanes can overtake this frame and therefore
+        // must not refer to node IDs introduced by it
+        wbuf.erase_trailing(frame_size);
+        m_outgoing_nodes.shrink(known_nodes);
+        if (!write_frame(wbuf, hdr, msg, wire_format::v1)) return;
+        frame_size = wbuf.size() - before;
+    }
+    if (lane.written > 0 && lane.written >= lane.pending.size() / 2) {
+        lane.pending.erase(lane.pending.begin(),
+                           lane.pending.begin()
+                           + static_cast<ptrdiff_t>(lane.written));
+        lane.written = 0;
+    }
+    auto first = static_cast<const char*>(wbuf.offset_data(before));
+    lane.pending.insert(lane.pending.end(), first, first + frame_size);
+    wbuf.erase_trailing(frame_size);
 }
 
 void peer::enqueue(msg_hdr_cref hdr, const message& msg) {
@@ -381,8 +727,11 @@ void peer::enqueue(msg_hdr_cref hdr, const message& msg) {
 
 void peer::dispose() {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(this));
-    parent()->get_namespace().erase(*m_node);
-    parent()->del_peer(this);
+    // m_node is not set if the connection was closed during the handshake
+    if (m_node) {
+        parent()->get_namespace().erase(*m_node);
+        parent()->del_peer(this);
+    }
     delete this;
 }
 
@@ -0,0 +1,85 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+
+#include "boost/actor/io/receive_buffer.hpp"
+
+namespace boost {
+namespace actor {
+namespace io {
+
+namespace { std::atomic<size_t> s_receive_chunk_size{64 * 1024}; }
+
+void receive_chunk_size(size_t num_bytes) {
+    // fill() would read nothing and claim to have filled
+    // the buffer with a chunk size of 0, i.e., spin forever
+    s_receive_chunk_size = std::max(num_bytes, size_t{1});
+}
+
+size_t receive_chunk_size() {
+    return s_receive_chunk_size;
+}
+
+receive_buffer::receive_buffer() : m_rd(0), m_wr(0) { }
+
+void receive_buffer::compact() {
+    if (m_rd == 0) return;
+    auto num_bytes = available();
+    if (num_bytes > 0) memmove(m_data.data(), data(), num_bytes);
+    m_rd = 0;
+    m_wr = num_bytes;
+}
+
+bool receive_buffer::fill(input_stream* in) {
+    auto chunk_size = receive_chunk_size();
+    if (m_data.size() < chunk_size && available() == 0) {
+        m_data.resize(chunk_size);
+    }
+    if (m_wr == m_data.size()) compact();
+    if (m_wr == m_data.size()) m_data.resize(m_data.size() + chunk_size);
+    auto free_space = m_data.size() - m_wr;
+    auto num_bytes = in->read_some(m_data.data() + m_wr, free_space);
+    m_wr += num_bytes;
+    return num_bytes == free_space;
+}
+
+void receive_buffer::reserve(size_t num_bytes) {
+    if (m_data.size() - m_rd >= num_bytes) return;
+    compact();
+    if (m_data.size() < num_bytes) m_data.resize(num_bytes);
+}
+
+void receive_buffer::consume(size_t num_bytes) {
+    m_rd += num_bytes;
+    if (m_rd >= m_wr) {
+        // all bytes processed; start over at the front of the buffer
+        m_rd = m_wr = 0;
+        // release memory acquired for a single large frame
+        auto chunk_size = receive_chunk_size();
+        if (m_data.size() > 2 * chunk_size) {
+            std::vector<char> tmp(chunk_size);
+            m_data.swap(tmp);
+        }
+    }
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
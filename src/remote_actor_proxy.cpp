@@ -59,7 +59,7 @@ remote_actor_proxy::~remote_actor_proxy() {
     auto mm = m_parent;
     BOOST_ACTOR_LOG_INFO(BOOST_ACTOR_ARG(m_id) << ", " << BOOST_ACTOR_TSARG(*m_node)
                    << ", protocol = " << detail::demangle(typeid(*m_parent)));
-    mm->run_later([aid, node, mm] {
+    mm->run_later(*node, [aid, node, mm] {
         BOOST_ACTOR_LOGC_TRACE("cppa::io::remote_actor_proxy",
                         "~remote_actor_proxy$run_later",
                         "node = " << to_string(*node) << ", aid " << aid);
@@ -75,7 +75,7 @@ remote_actor_proxy::~remote_actor_proxy() {
 
 void remote_actor_proxy::deliver(msg_hdr_cref hdr, message msg) {
     // this member function is exclusively called from default_peer from inside
-    // the middleman's thread, therefore we can safely access
+    // the event loop responsible for m_node, therefore we can safely access
     // m_pending_requests here
     if (hdr.id.is_response()) {
         // remove this request from list of pending requests
@@ -119,9 +119,10 @@ void remote_actor_proxy::forward_msg(msg_hdr_cref hdr, message msg) {
             }
         }
     }
+    // route directly to the event loop responsible for the peer
     auto node = m_node;
     auto mm = m_parent;
-    m_parent->run_later([hdr, msg, node, mm] {
+    m_parent->run_later(*node, [hdr, msg, node, mm] {
         BOOST_ACTOR_LOGC_TRACE("cppa::io::remote_actor_proxy",
                         "forward_msg$forwarder",
                         "");
@@ -141,7 +142,7 @@ void remote_actor_proxy::enqueue(msg_hdr_cref hdr, message msg,
         BOOST_ACTOR_LOG_DEBUG("received KILL_PROXY message");
         intrusive_ptr<remote_actor_proxy> _this{this};
         auto reason = msg.get_as<uint32_t>(1);
-        m_parent->run_later([_this, reason] {
+        m_parent->run_later(*m_node, [_this, reason] {
             BOOST_ACTOR_LOGC_TRACE("cppa::io::remote_actor_proxy",
                             "enqueue$kill_proxy_helper",
                             "KILL_PROXY " << to_string(_this->address())
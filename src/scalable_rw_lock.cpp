@@ -0,0 +1,242 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <new>
+#include <thread>
+#include <cstdint>
+#include <climits>
+#include <functional>
+
+#include "boost/actor/config.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
+
+#ifdef BOOST_ACTOR_LINUX
+#   include <unistd.h>
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#endif
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+namespace {
+
+inline void cpu_relax() {
+#   if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#   endif
+}
+
+// spins 1, 2, 4, ... times before giving up
+class backoff {
+
+ public:
+
+    backoff() : m_round(0) { }
+
+    // returns false once the caller should block instead
+    bool spin() {
+        if (m_round == max_rounds) return false;
+        for (size_t i = 0; i < (size_t{1} << m_round); ++i) cpu_relax();
+        ++m_round;
+        return true;
+    }
+
+ private:
+
+    static constexpr size_t max_rounds = 10;
+
+    size_t m_round;
+
+};
+
+void park(std::atomic<int>& word, int expected) {
+#   ifdef BOOST_ACTOR_LINUX
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+#   else
+    static_cast<void>(word);
+    static_cast<void>(expected);
+    std::this_thread::yield();
+#   endif
+}
+
+void unpark_all(std::atomic<int>& word) {
+#   ifdef BOOST_ACTOR_LINUX
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#   else
+    static_cast<void>(word);
+#   endif
+}
+
+} // namespace <anonymous>
+
+size_t scalable_rw_lock::num_slots() {
+    static size_t result = [] {
+        // fall back to 16 slots if the number of cores is unknown
+        size_t num_cores = std::thread::hardware_concurrency();
+        if (num_cores == 0) num_cores = 16;
+        size_t n = 1;
+        while (n < num_cores) n <<= 1;
+        return n;
+    }();
+    return result;
+}
+
+scalable_rw_lock::scalable_rw_lock() : m_state(0) {
+    // new does not guarantee an alignment of BOOST_ACTOR_CACHE_LINE_SIZE,
+    // hence we allocate an additional cache line and align manually
+    auto n = num_slots();
+    m_slot_mask = n - 1;
+    m_storage.reset(new char[(n + 1) * BOOST_ACTOR_CACHE_LINE_SIZE]);
+    auto addr = reinterpret_cast<std::uintptr_t>(m_storage.get());
+    auto offset = BOOST_ACTOR_CACHE_LINE_SIZE
+                  - addr % BOOST_ACTOR_CACHE_LINE_SIZE;
+    m_slots = reinterpret_cast<slot*>(m_storage.get() + offset);
+    for (size_t i = 0; i < n; ++i) new (m_slots + i) slot;
+}
+
+void scalable_rw_lock::lock() {
+    acquire(writer_flag);
+    await_readers();
+}
+
+void scalable_rw_lock::unlock() {
+    release(writer_flag);
+}
+
+bool scalable_rw_lock::try_lock() {
+    auto v = m_state.load();
+    if (   (v & (writer_flag | upgrader_flag)) != 0
+        || !m_state.compare_exchange_strong(v, v | writer_flag)) {
+        return false;
+    }
+    for (size_t i = 0; i <= m_slot_mask; ++i) {
+        if (m_slots[i].readers.load() != 0) {
+            release(writer_flag);
+            return false;
+        }
+    }
+    return true;
+}
+
+void scalable_rw_lock::lock_shared() {
+    auto& s = my_slot();
+    for (;;) {
+        // announce ourselves before checking for a writer, a writer
+        // sets its flag before checking the slots (Dekker-style)
+        s.readers.fetch_add(1);
+        if ((m_state.load() & writer_flag) == 0) return;
+        s.readers.fetch_sub(1);
+        await_state(writer_flag);
+    }
+}
+
+void scalable_rw_lock::unlock_shared() {
+    my_slot().readers.fetch_sub(1);
+}
+
+bool scalable_rw_lock::try_lock_shared() {
+    auto& s = my_slot();
+    s.readers.fetch_add(1);
+    if ((m_state.load() & writer_flag) == 0) return true;
+    s.readers.fetch_sub(1);
+    return false;
+}
+
+void scalable_rw_lock::lock_upgrade() {
+    acquire(upgrader_flag);
+}
+
+void scalable_rw_lock::unlock_upgrade() {
+    release(upgrader_flag);
+}
+
+void scalable_rw_lock::unlock_upgrade_and_lock() {
+    // no writer or upgrader can interfere while we hold upgrader_flag,
+    // hence it is safe to swap both flags in one step
+    m_state.fetch_xor(upgrader_flag | writer_flag);
+    await_readers();
+}
+
+void scalable_rw_lock::unlock_and_lock_upgrade() {
+    auto v = m_state.load();
+    while (!m_state.compare_exchange_weak(v, (v & ~(writer_flag | waiters_flag))
+                                             | upgrader_flag)) {
+        // next iteration
+    }
+    if (v & waiters_flag) unpark_all(m_state);
+}
+
+void scalable_rw_lock::unlock_upgrade_and_lock_shared() {
+    my_slot().readers.fetch_add(1);
+    release(upgrader_flag);
+}
+
+scalable_rw_lock::slot& scalable_rw_lock::my_slot() {
+    // thread IDs are usually aligned addresses, i.e., their low
+    // bits are zero and need to be mixed with the high bits
+    std::uint64_t h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    h *= 0x9E3779B97F4A7C15ull;
+    return m_slots[(h >> 32) & m_slot_mask];
+}
+
+void scalable_rw_lock::acquire(int flag) {
+    for (;;) {
+        auto v = m_state.load();
+        if ((v & (writer_flag | upgrader_flag)) == 0) {
+            if (m_state.compare_exchange_weak(v, v | flag)) return;
+        }
+        else await_state(writer_flag | upgrader_flag);
+    }
+}
+
+void scalable_rw_lock::release(int flag) {
+    auto prev = m_state.fetch_and(~(flag | waiters_flag));
+    if (prev & waiters_flag) unpark_all(m_state);
+}
+
+void scalable_rw_lock::await_readers() {
+    for (size_t i = 0; i <= m_slot_mask; ++i) {
+        backoff bo;
+        while (m_slots[i].readers.load() != 0) {
+            if (!bo.spin()) std::this_thread::yield();
+        }
+    }
+}
+
+void scalable_rw_lock::await_state(int mask) {
+    backoff bo;
+    for (;;) {
+        auto v = m_state.load();
+        if ((v & mask) == 0) return;
+        if (bo.spin()) continue;
+        // tell the owner to wake us up before parking
+        if (   (v & waiters_flag) == 0
+            && !m_state.compare_exchange_weak(v, v | waiters_flag)) {
+            continue;
+        }
+        park(m_state, v | waiters_flag);
+    }
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
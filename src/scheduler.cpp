@@ -19,7 +19,10 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <algorithm>
+#include <limits>
 #include <iostream>
+#include <stdexcept>
 #include <condition_variable>
 
 #include "boost/actor/on.hpp"
@@ -32,9 +35,12 @@
 #include "boost/actor/scoped_actor.hpp"
 #include "boost/actor/system_messages.hpp"
 
+#include "boost/actor/detail/timer_wheel.hpp"
+#include "boost/actor/detail/cpu_affinity.hpp"
 #include "boost/actor/detail/proper_actor.hpp"
 #include "boost/actor/detail/actor_registry.hpp"
 #include "boost/actor/detail/singleton_manager.hpp"
+#include "boost/actor/detail/single_reader_queue.hpp"
 
 namespace boost {
 namespace actor {
@@ -52,110 +58,24 @@ typedef std::chrono::high_resolution_clock hrc;
 
 typedef hrc::time_point time_point;
 
-typedef policy::policies<policy::no_scheduling, policy::not_prioritizing,
-                         policy::no_resume, policy::nestable_invoke>
-        timer_actor_policies;
+std::atomic<size_t> default_spin_attempts{100};
 
-class delayed_msg {
+std::atomic<size_t> default_max_throughput{std::numeric_limits<size_t>::max()};
 
- public:
+// guards s_config and s_running
+std::mutex s_config_mtx;
 
-    delayed_msg(message_header&& arg1,
-                message&&      arg2)
-    : hdr(std::move(arg1)), msg(std::move(arg2)) { }
+configuration s_config;
 
-    delayed_msg(delayed_msg&&) = default;
-    delayed_msg(const delayed_msg&) = default;
-    delayed_msg& operator=(delayed_msg&&) = default;
-    delayed_msg& operator=(const delayed_msg&) = default;
+// set by the coordinator during its lifetime
+bool s_running = false;
 
-    inline void eval() {
-        hdr.deliver(std::move(msg));
+void pin_to(const cpu_list& cpus) {
+    if (!cpus.empty() && !detail::set_thread_affinity(cpus)) {
+        BOOST_ACTOR_LOGF_WARNING("unable to set CPU affinity");
     }
-
- private:
-
-    message_header hdr;
-    message      msg;
-
-};
-
-template<class Map>
-inline void insert_dmsg(Map& storage, const duration& d,
-                        message_header&& hdr, message&& tup) {
-    auto tout = hrc::now();
-    tout += d;
-    delayed_msg dmsg{std::move(hdr), std::move(tup)};
-    storage.insert(std::make_pair(std::move(tout), std::move(dmsg)));
 }
 
-class timer_actor final : public detail::proper_actor<blocking_actor,
-                                                      timer_actor_policies> {
-
- public:
-
-    inline unique_mailbox_element_pointer dequeue() {
-        await_data();
-        return next_message();
-    }
-
-    inline unique_mailbox_element_pointer try_dequeue(const time_point& tp) {
-        if (scheduling_policy().await_data(this, tp)) {
-            return next_message();
-        }
-        return unique_mailbox_element_pointer{};
-    }
-
-    void act() override {
-        // setup & local variables
-        bool done = false;
-        unique_mailbox_element_pointer msg_ptr;
-        auto tout = hrc::now();
-        std::multimap<decltype(tout), delayed_msg> messages;
-        // message handling rules
-        auto mfun = (
-            on(atom("SEND"), arg_match) >> [&](const duration& d,
-                                               message_header& hdr,
-                                               message& tup) {
-                insert_dmsg(messages, d, std::move(hdr), std::move(tup));
-            },
-            on(atom("DIE")) >> [&] {
-                done = true;
-            },
-            others() >> [&]() {
-#               ifdef BOOST_ACTOR_DEBUG_MODE
-                    std::cerr << "coordinator::timer_loop: UNKNOWN MESSAGE: "
-                              << to_string(msg_ptr->msg)
-                              << std::endl;
-#               endif
-            }
-        );
-        // loop
-        while (!done) {
-            while (!msg_ptr) {
-                if (messages.empty()) msg_ptr = dequeue();
-                else {
-                    tout = hrc::now();
-                    // handle timeouts (send messages)
-                    auto it = messages.begin();
-                    while (it != messages.end() && (it->first) <= tout) {
-                        it->second.eval();
-                        messages.erase(it);
-                        it = messages.begin();
-                    }
-                    // wait for next message or next timeout
-                    if (it != messages.end()) {
-                        msg_ptr = try_dequeue(it->first);
-                    }
-                }
-            }
-            mfun(msg_ptr->msg);
-            msg_ptr.reset();
-        }
-    }
-
-};
-
 void printer_loop(blocking_actor* self) {
     std::map<actor_addr, std::string> out;
     auto flush_output = [&out](const actor_addr& s) {
@@ -213,10 +133,171 @@ void printer_loop(blocking_actor* self) {
 
 } // namespace <anonymous>
 
+configuration::configuration()
+: num_workers(0), num_middleman_loops(1), num_resolver_threads(2)
+, edge_triggered_io(false), shard_acceptors(false) { }
+
+void set_configuration(const configuration& cfg) {
+    std::lock_guard<std::mutex> guard(s_config_mtx);
+    if (s_running) {
+        throw std::logic_error("cannot configure a running scheduler");
+    }
+    s_config = cfg;
+}
+
+configuration get_configuration() {
+    std::lock_guard<std::mutex> guard(s_config_mtx);
+    return s_config;
+}
+
+void spin_attempts(size_t attempts) {
+    default_spin_attempts = attempts;
+}
+
+size_t spin_attempts() {
+    return default_spin_attempts;
+}
+
+void max_throughput(size_t num_messages) {
+    // an actor must handle at least one message per resume
+    default_max_throughput = num_messages == 0
+                           ? std::numeric_limits<size_t>::max()
+                           : num_messages;
+}
+
+size_t max_throughput() {
+    return default_max_throughput.load(std::memory_order_relaxed);
+}
+
 /******************************************************************************
  *                      implementation of coordinator                         *
  ******************************************************************************/
 
+/******************************************************************************
+ *                                   timer                                    *
+ ******************************************************************************/
+
+class coordinator::timer {
+
+ public:
+
+    timer() : m_wheel(hrc::now()), m_cancelled(nullptr), m_done(false) { }
+
+    ~timer() {
+        auto e = m_cancelled.exchange(nullptr);
+        while (e) {
+            auto next = e->next_cancelled;
+            e->deref();
+            e = next;
+        }
+    }
+
+    // takes over a reference of the caller
+    void add(detail::timer_entry* e) {
+        m_requests.synchronized_enqueue(m_mtx, m_cv, e);
+    }
+
+    // called after e has been disarmed by the caller
+    void cancel(detail::timer_entry* e) {
+        // the list of cancelled entries keeps e alive until
+        // the timer removed it from the wheel
+        e->ref();
+        auto head = m_cancelled.load();
+        do {
+            e->next_cancelled = head;
+        } while (!m_cancelled.compare_exchange_weak(head, e));
+    }
+
+    void stop() {
+        m_done = true;
+        // wake up the timer thread using a disarmed dummy entry
+        auto e = new detail::timer_entry(hrc::now(), message_header{},
+                                         message{});
+        e->ref();
+        e->disarm();
+        add(e);
+    }
+
+    void run() {
+        auto deliver = [](detail::timer_entry& e) {
+            e.hdr.deliver(std::move(e.msg));
+        };
+        while (!m_done) {
+            // move new entries to the wheel
+            for (auto e = m_requests.try_pop(); e; e = m_requests.try_pop()) {
+                if (e->armed()) m_wheel.insert(e);
+                else e->release();
+            }
+            // remove cancelled entries from the wheel
+            auto e = m_cancelled.exchange(nullptr);
+            while (e) {
+                auto next = e->next_cancelled;
+                m_wheel.erase(e);
+                e->deref();
+                e = next;
+            }
+            m_wheel.advance(hrc::now(), deliver);
+            // wait for new entries or for the next timeout
+            detail::timer_entry* ptr;
+            if (m_wheel.empty()) ptr = m_requests.synchronized_pop(m_mtx, m_cv);
+            else {
+                ptr = m_requests.synchronized_try_pop(m_mtx, m_cv,
+                                                      m_wheel.next_timeout());
+            }
+            if (ptr) {
+                if (ptr->armed()) m_wheel.insert(ptr);
+                else ptr->release();
+            }
+        }
+    }
+
+ private:
+
+    struct disposer {
+        inline void operator()(detail::timer_entry* e) const {
+            e->disarm();
+            e->release();
+        }
+    };
+
+    detail::timer_wheel m_wheel;
+
+    detail::single_reader_queue<detail::timer_entry, disposer> m_requests;
+
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+
+    // lock-free stack of cancelled entries, linked via next_cancelled
+    std::atomic<detail::timer_entry*> m_cancelled;
+
+    std::atomic<bool> m_done;
+
+};
+
+detail::timer_handle coordinator::delayed_send(message_header hdr,
+                                               const duration& rel_time,
+                                               message data) {
+    auto due = hrc::now();
+    due += rel_time;
+    detail::timer_handle result{new detail::timer_entry(due, std::move(hdr),
+                                                        std::move(data))};
+    // the timer holds its own reference until the entry was delivered
+    result->ref();
+    m_timer->add(result.get());
+    return result;
+}
+
+detail::timer_handle coordinator::delayed_reply(message_header hdr,
+                                                const duration& rel_time,
+                                                message data) {
+    BOOST_ACTOR_REQUIRE(hdr.id.valid() && hdr.id.is_response());
+    return delayed_send(std::move(hdr), rel_time, std::move(data));
+}
+
+void coordinator::cancel_timeout(const detail::timer_handle& handle) {
+    if (handle && handle->disarm()) m_timer->cancel(handle.get());
+}
+
 class coordinator::shutdown_helper : public resumable {
 
  public:
@@ -249,18 +330,81 @@ class coordinator::shutdown_helper : public resumable {
 coordinator::shutdown_helper::~shutdown_helper() { }
 
 void coordinator::initialize() {
+    configuration cfg;
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard(s_config_mtx);
+        s_running = true;
+        cfg = s_config;
+    }
     // launch threads of utility actors
-    auto ptr = m_timer.get();
-    m_timer_thread = std::thread{[ptr] {
-        ptr->act();
+    auto ptr = m_timer;
+    auto tcpus = cfg.timer_affinity;
+    m_timer_thread = std::thread{[ptr, tcpus] {
+        pin_to(tcpus);
+        ptr->run();
+    }};
+    auto pptr = m_printer.get();
+    m_printer_thread = std::thread{[pptr, tcpus] {
+        pin_to(tcpus);
+        printer_loop(pptr);
     }};
-    m_printer_thread = std::thread{printer_loop, m_printer.get()};
-    // create & start workers
-    auto hwc = static_cast<size_t>(std::thread::hardware_concurrency());
-    m_workers.resize(hwc);
-    for (size_t i = 0; i < hwc; ++i) {
-        m_workers[i].start(i, this);
+    // workers without explicit affinity avoid reserved CPUs
+    cpu_list unreserved;
+    if (!cfg.middleman_affinity.empty() || !cfg.timer_affinity.empty()) {
+        auto reserved = [&](size_t cpu) {
+            auto is_cpu = [=](size_t x) { return x == cpu; };
+            return std::any_of(cfg.middleman_affinity.begin(),
+                               cfg.middleman_affinity.end(), is_cpu)
+                || std::any_of(cfg.timer_affinity.begin(),
+                               cfg.timer_affinity.end(), is_cpu);
+        };
+        auto hwc = std::thread::hardware_concurrency();
+        for (size_t cpu = 0; cpu < hwc; ++cpu) {
+            if (!reserved(cpu)) unreserved.push_back(cpu);
+        }
+    }
+    // create workers
+    auto num = cfg.num_workers;
+    if (num == 0) {
+        num = std::max(static_cast<size_t>(std::thread::hardware_concurrency()),
+                       size_t{1});
+    }
+    m_workers.resize(num);
+    for (size_t i = 0; i < num; ++i) {
+        auto& w = m_workers[i];
+        w.m_id = i;
+        w.m_affinity = i < cfg.worker_affinity.size()
+                       && !cfg.worker_affinity[i].empty()
+                     ? cfg.worker_affinity[i]
+                     : unreserved;
+        if (i < cfg.worker_numa_node.size()) {
+            w.m_numa_node = cfg.worker_numa_node[i];
+        }
+        else if (!w.m_affinity.empty() && w.m_affinity != unreserved) {
+            w.m_numa_node = detail::numa_node_of(w.m_affinity.front());
+        }
+        else w.m_numa_node = 0;
+    }
+    // group victims by NUMA node, i.e., steal locally first
+    for (auto& w : m_workers) {
+        for (auto& other : m_workers) {
+            if (other.m_id == w.m_id) continue;
+            if (other.m_numa_node == w.m_numa_node) {
+                w.m_local_victims.push_back(other.m_id);
+            }
+            else w.m_remote_victims.push_back(other.m_id);
+        }
+        // reduce probability of 'steal collisions' by letting
+        // each worker start at a different victim
+        if (!w.m_local_victims.empty()) {
+            w.m_local_pos = w.m_id % w.m_local_victims.size();
+        }
+        if (!w.m_remote_victims.empty()) {
+            w.m_remote_pos = w.m_id % w.m_remote_victims.size();
+        }
     }
+    // start workers
+    for (auto& w : m_workers) w.start(this);
 }
 
 void coordinator::destroy() {
@@ -285,29 +429,38 @@ void coordinator::destroy() {
         alive_workers.erase(i);
     }
     // shutdown utility actors
-    BOOST_ACTOR_LOG_DEBUG("send 'DIE' messages to timer & printer");
+    BOOST_ACTOR_LOG_DEBUG("stop timer & send 'DIE' message to printer");
+    m_timer->stop();
     auto msg = make_message(atom("DIE"));
-    m_timer->enqueue({invalid_actor_addr, nullptr}, msg, nullptr);
     m_printer->enqueue({invalid_actor_addr, nullptr}, msg, nullptr);
     BOOST_ACTOR_LOG_DEBUG("join threads of utility actors");
     m_timer_thread.join();
     m_printer_thread.join();
+    delete m_timer;
     // join each worker thread for good manners
     BOOST_ACTOR_LOG_DEBUG("join threads of workers");
     for (auto& w : m_workers) w.m_this_thread.join();
     BOOST_ACTOR_LOG_DEBUG("detach all resumables from all workers");
     for (auto& w : m_workers) {
-        auto next = [&] { return w.m_exposed_queue.try_pop(); };
-        for (auto job = next(); job != nullptr; job = next()) {
+        // all worker threads are joined, i.e., we can safely act as owner
+        for (auto job = w.m_job_queue.take(); job; job = w.m_job_queue.take()) {
+            job->detach_from_scheduler();
+        }
+        for (auto job = w.m_inbox.try_pop(); job; job = w.m_inbox.try_pop()) {
             job->detach_from_scheduler();
         }
     }
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard(s_config_mtx);
+        s_running = false;
+    }
     // cleanup
     delete this;
 }
 
 coordinator::coordinator()
-: m_timer(new timer_actor), m_printer(true) , m_next_worker(0) { }
+: m_timer(new timer), m_printer(true) , m_next_worker(0)
+, m_num_idle(0) { }
 
 coordinator* coordinator::create_singleton() {
     return new coordinator;
@@ -322,6 +475,39 @@ void coordinator::enqueue(resumable* what) {
     m_workers[nw % m_workers.size()].external_enqueue(what);
 }
 
+void coordinator::register_idle(worker* w) {
+    std::lock_guard<std::mutex> guard(m_idle_mtx);
+    m_idle.push_back(w);
+    // pairs with the fence in unpark_one: either the publisher
+    // sees this worker as idle or the worker sees the new job
+    m_num_idle.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool coordinator::unregister_idle(worker* w) {
+    std::lock_guard<std::mutex> guard(m_idle_mtx);
+    auto i = std::find(m_idle.begin(), m_idle.end(), w);
+    if (i == m_idle.end()) {
+        // someone has unparked `w` in the meantime
+        w->m_unparked = false;
+        return false;
+    }
+    m_idle.erase(i);
+    m_num_idle.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void coordinator::unpark_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_num_idle.load(std::memory_order_relaxed) == 0) return;
+    std::lock_guard<std::mutex> guard(m_idle_mtx);
+    if (m_idle.empty()) return;
+    auto w = m_idle.back();
+    m_idle.pop_back();
+    m_num_idle.fetch_sub(1, std::memory_order_relaxed);
+    w->m_unparked = true;
+    w->m_park_cv.notify_one();
+}
+
 /******************************************************************************
  *                          implementation of worker                          *
  ******************************************************************************/
@@ -329,7 +515,11 @@ void coordinator::enqueue(resumable* what) {
 #define BOOST_ACTOR_LOG_DEBUG_WORKER(msg)                                             \
     BOOST_ACTOR_LOG_DEBUG("worker " << m_id << ": " << msg)
 
-worker::worker(worker&& other) {
+worker::worker() : m_id(0), m_local_pos(0), m_remote_pos(0), m_numa_node(0)
+                 , m_parent(nullptr), m_unparked(false)
+                 , m_current_job(nullptr), m_num_preemptions(0) { }
+
+worker::worker(worker&& other) : worker() {
     *this = std::move(other); // delegate to move assignment operator
 }
 
@@ -341,20 +531,23 @@ worker& worker::operator=(worker&& other) {
     if (running(m_this_thread) || running(other.m_this_thread)) {
         throw std::runtime_error("running workers cannot be moved");
     }
-    m_job_list = std::move(other.m_job_list);
-    auto next = [&] { return other.m_exposed_queue.try_pop(); };
+    // neither worker is running, i.e., we can safely act as owner of both
+    auto next = [&] { return other.m_job_queue.take(); };
     for (auto j = next(); j != nullptr; j = next()) {
-        m_exposed_queue.push_back(j);
+        m_job_queue.push(j);
+    }
+    auto next_external = [&] { return other.m_inbox.try_pop(); };
+    for (auto j = next_external(); j != nullptr; j = next_external()) {
+        m_inbox.push_back(j);
     }
     return *this;
 }
 
-void worker::start(size_t id, coordinator* parent) {
-    m_id = id;
-    m_last_victim = id;
+void worker::start(coordinator* parent) {
     m_parent = parent;
     auto this_worker = this;
     m_this_thread = std::thread{[this_worker] {
+        pin_to(this_worker->m_affinity);
         this_worker->run();
     }};
 }
@@ -366,26 +559,31 @@ void worker::run() {
     job_ptr job = nullptr;
     // some utility functions
     auto local_poll = [&]() -> bool {
-        if (!m_job_list.empty()) {
-            job = m_job_list.back();
-            m_job_list.pop_back();
-            BOOST_ACTOR_LOG_DEBUG_WORKER("got job from m_job_list");
+        job = m_job_queue.take();
+        if (job) {
+            BOOST_ACTOR_LOG_DEBUG_WORKER("got job from m_job_queue");
+            return true;
+        }
+        job = m_inbox.try_pop();
+        if (job) {
+            BOOST_ACTOR_LOG_DEBUG_WORKER("got job from m_inbox");
             return true;
         }
         return false;
     };
-    auto aggressive_poll = [&]() -> bool {
-        for (int i = 1; i < 101; ++i) {
-            job = m_exposed_queue.try_pop();
+    auto spin_poll = [&]() -> bool {
+        auto attempts = spin_attempts();
+        for (size_t i = 1; i <= attempts; ++i) {
+            job = m_inbox.try_pop();
             if (job) {
-                BOOST_ACTOR_LOG_DEBUG_WORKER("got job with aggressive polling");
+                BOOST_ACTOR_LOG_DEBUG_WORKER("got job with spin polling");
                 return true;
             }
             // try to steal every 10 poll attempts
             if ((i % 10) == 0) {
                 job = raid();
                 if (job) {
-                    BOOST_ACTOR_LOG_DEBUG_WORKER("got job with aggressive polling");
+                    BOOST_ACTOR_LOG_DEBUG_WORKER("got job with spin polling");
                     return true;
                 }
             }
@@ -393,46 +591,40 @@ void worker::run() {
         }
         return false;
     };
-    auto moderate_poll = [&]() -> bool {
-        for (int i = 1; i < 550; ++i) {
-            job =  m_exposed_queue.try_pop();
-            if (job) {
-                BOOST_ACTOR_LOG_DEBUG_WORKER("got job with moderate polling");
-                return true;
-            }
-            // try to steal every 5 poll attempts
-            if ((i % 5) == 0) {
-                job = raid();
-                if (job) {
-                    BOOST_ACTOR_LOG_DEBUG_WORKER("got job with moderate polling");
-                    return true;
-                }
-            }
-            std::this_thread::sleep_for(std::chrono::microseconds(50));
-        }
-        return false;
+    auto try_get_job = [&]() -> bool {
+        job = m_inbox.try_pop();
+        if (!job) job = raid();
+        return job != nullptr;
     };
-    auto relaxed_poll = [&]() -> bool {
+    auto park_poll = [&]() -> bool {
         for (;;) {
-            job =  m_exposed_queue.try_pop();
-            if (job) {
-                BOOST_ACTOR_LOG_DEBUG_WORKER("got job with relaxed polling");
+            m_parent->register_idle(this);
+            // re-check for work published before we became visible as idle
+            if (try_get_job()) {
+                if (!m_parent->unregister_idle(this)) {
+                    // we have consumed a wakeup meant for new work,
+                    // pass it on to another idle worker
+                    m_parent->unpark_one();
+                }
+                BOOST_ACTOR_LOG_DEBUG_WORKER("got job before parking");
                 return true;
             }
-            // always try to steal at this stage
-            job = raid();
-            if (job) {
-                BOOST_ACTOR_LOG_DEBUG_WORKER("got job with relaxed polling");
+            BOOST_ACTOR_LOG_DEBUG_WORKER("park");
+            park();
+            if (try_get_job()) {
+                BOOST_ACTOR_LOG_DEBUG_WORKER("got job after unpark");
                 return true;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     };
     // scheduling loop
     for (;;) {
-        local_poll() || aggressive_poll() || moderate_poll() || relaxed_poll();
+        local_poll() || spin_poll() || park_poll();
         BOOST_ACTOR_PUSH_AID_FROM_PTR(dynamic_cast<abstract_actor*>(job));
-        switch (job->resume(&fself, this)) {
+        m_current_job = job;
+        auto res = job->resume(&fself, this);
+        m_current_job = nullptr;
+        switch (res) {
             case resumable::done: {
                 job->detach_from_scheduler();
                 break;
@@ -441,66 +633,63 @@ void worker::run() {
                 break;
             }
             case resumable::shutdown_execution_unit: {
-                // give others the opportunity to steal unfinished jobs
-                for (auto ptr : m_job_list) m_exposed_queue.push_back(ptr);
-                m_job_list.clear();
+                // unfinished jobs remain in m_job_queue, where
+                // other workers can still steal them
                 return;
             }
         }
         job = nullptr;
-        // give others the opportunity to steal from us
-        if (m_job_list.size() > 1 && m_exposed_queue.empty()) {
-            m_exposed_queue.push_back(m_job_list.front());
-            m_job_list.erase(m_job_list.begin());
-        }
     }
 }
 
 worker::job_ptr worker::try_steal() {
-    return m_exposed_queue.try_pop();
+    auto job = m_job_queue.steal();
+    return job ? job : m_inbox.try_pop();
+}
+
+void worker::park() {
+    std::unique_lock<std::mutex> guard(m_parent->m_idle_mtx);
+    m_park_cv.wait(guard, [&] { return m_unparked; });
+    m_unparked = false;
 }
 
 worker::job_ptr worker::raid() {
-    // try once to steal from anyone
-    auto inc = [](size_t arg) -> size_t { return arg + 1; };
-    auto dec = [](size_t arg) -> size_t { return arg - 1; };
-    // reduce probability of 'steal collisions' by letting
-    // half the workers pick victims by increasing IDs and
-    // the other half by decreasing IDs
-    size_t (*next)(size_t) = (m_id % 2) == 0 ? inc : dec;
-    auto n = m_parent->num_workers();
+    // try once to steal from anyone, prefer victims on our own NUMA node
+    auto job = raid(m_local_victims, m_local_pos);
+    return job ? job : raid(m_remote_victims, m_remote_pos);
+}
+
+worker::job_ptr worker::raid(const std::vector<size_t>& victims, size_t& pos) {
+    auto n = victims.size();
     for (size_t i = 0; i < n; ++i) {
-        m_last_victim = next(m_last_victim) % n;
-        if (m_last_victim != m_id) {
-            auto job = m_parent->worker_by_id(m_last_victim).try_steal();
-            if (job) {
-                BOOST_ACTOR_LOG_DEBUG_WORKER("successfully stolen a job from "
-                                      << m_last_victim);
-                return job;
-            }
+        auto victim = victims[pos];
+        pos = (pos + 1) % n;
+        auto job = m_parent->worker_by_id(victim).try_steal();
+        if (job) {
+            BOOST_ACTOR_LOG_DEBUG_WORKER("successfully stolen a job from "
+                                         << victim);
+            return job;
         }
     }
     return nullptr;
 }
 
 void worker::external_enqueue(job_ptr ptr) {
-    m_exposed_queue.push_back(ptr);
+    m_inbox.push_back(ptr);
+    m_parent->unpark_one();
 }
 
 void worker::exec_later(job_ptr ptr) {
     BOOST_ACTOR_REQUIRE(std::this_thread::get_id() == m_this_thread.get_id());
-    // give others the opportunity to steal from us
-    if (m_exposed_queue.empty()) {
-        if (m_job_list.empty()) {
-            m_exposed_queue.push_back(ptr);
-        }
-        else {
-            m_exposed_queue.push_back(m_job_list.front());
-            m_job_list.erase(m_job_list.begin());
-            m_job_list.push_back(ptr);
-        }
+    if (ptr == m_current_job) {
+        // the current job has been preempted, i.e., has reached its maximum
+        // throughput; the FIFO inbox gives all other jobs a chance to run
+        m_num_preemptions.fetch_add(1, std::memory_order_relaxed);
+        m_inbox.push_back(ptr);
     }
-    else m_job_list.push_back(ptr);
+    else m_job_queue.push(ptr);
+    // wake up an idle worker to steal the job
+    m_parent->unpark_one();
 }
 
 } // namespace scheduler
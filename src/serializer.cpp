@@ -16,6 +16,7 @@
 \******************************************************************************/
 
 
+#include "boost/actor/node_id.hpp"
 #include "boost/actor/serializer.hpp"
 
 namespace boost {
@@ -26,5 +27,15 @@ serializer::serializer(actor_namespace* ns, type_lookup_table* it)
 
 serializer::~serializer() { }
 
+void serializer::write_node_id(const node_id* nid) {
+    if (nid == nullptr) {
+        node_id::serialize_invalid(this);
+    }
+    else {
+        write_value(nid->process_id());
+        write_raw(nid->host_id().size(), nid->host_id().data());
+    }
+}
+
 } // namespace actor
 } // namespace boost
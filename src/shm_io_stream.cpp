@@ -0,0 +1,378 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <ios>
+#include <new>
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include "boost/actor/config.hpp"
+#include "boost/actor/logging.hpp"
+#include "boost/actor/exception.hpp"
+
+#include "boost/actor/io/fd_util.hpp"
+#include "boost/actor/io/shm_io_stream.hpp"
+
+#ifdef BOOST_ACTOR_WINDOWS
+#   include <winsock2.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/select.h>
+#endif
+
+namespace boost {
+namespace actor {
+namespace io {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory rings require lock-free 32 bit atomics");
+
+namespace {
+
+std::atomic<size_t> s_shm_ring_size{1024 * 1024};
+
+std::atomic<size_t> s_segment_id{0};
+
+constexpr std::uint32_t segment_magic = 0x62617368; // "bash"
+
+constexpr size_t min_ring_size = 4096;
+
+constexpr size_t max_ring_size = size_t{1} << 30;
+
+constexpr size_t cache_line_size = 64;
+
+// positions are counted modulo 2^32, hence the ring size
+// has to be a power of two to map them to an offset
+size_t normalized_ring_size(size_t num_bytes) {
+    size_t result = min_ring_size;
+    while (result < num_bytes && result < max_ring_size) result <<= 1;
+    return result;
+}
+
+} // namespace <anonymous>
+
+void shm_ring_size(size_t num_bytes) {
+    s_shm_ring_size = num_bytes;
+}
+
+size_t shm_ring_size() {
+    return s_shm_ring_size;
+}
+
+struct shm_io_stream::ring {
+    // number of bytes consumed so far, written by the consumer only
+    alignas(cache_line_size) std::atomic<std::uint32_t> rd;
+    // number of bytes produced so far, written by the producer only
+    alignas(cache_line_size) std::atomic<std::uint32_t> wr;
+    // set by the consumer before it waits for the doorbell
+    alignas(cache_line_size) std::atomic<std::uint32_t> consumer_waiting;
+    // set by the producer before it waits for the doorbell
+    std::atomic<std::uint32_t> producer_waiting;
+    ring() : rd(0), wr(0), consumer_waiting(0), producer_waiting(0) { }
+};
+
+struct shm_io_stream::segment {
+    std::uint32_t magic;
+    std::uint32_t ring_size;
+    // the first ring transfers data from the creator to the other process,
+    // the data of both rings follows this header
+    ring rings[2];
+    segment(std::uint32_t size) : magic(segment_magic), ring_size(size) { }
+};
+
+shm_io_stream::shm_io_stream(stream_ptr doorbell, std::string name,
+                             segment* seg, size_t seg_size, bool is_creator)
+: m_doorbell(std::move(doorbell)), m_name(std::move(name))
+, m_segment(seg), m_segment_size(seg_size), m_ring_size(seg->ring_size)
+, m_armed(false), m_deferred_ring(false) {
+    auto data = reinterpret_cast<char*>(seg) + sizeof(segment);
+    size_t out_pos = is_creator ? 0 : 1;
+    m_out = &seg->rings[out_pos];
+    m_out_data = data + out_pos * m_ring_size;
+    m_in = &seg->rings[1 - out_pos];
+    m_in_data = data + (1 - out_pos) * m_ring_size;
+    // only the creator is responsible for removing the name
+    if (!is_creator) m_name.clear();
+}
+
+bool shm_io_stream::is_valid_name(const std::string& name,
+                                  std::uint32_t creator) {
+    // names have the form /boost_actor_<pid>_<n>
+    auto prefix = "/boost_actor_" + std::to_string(creator) + "_";
+    auto max_digits = std::to_string(~size_t{0}).size();
+    if (   name.size() <= prefix.size()
+        || name.size() > prefix.size() + max_digits
+        || name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    return std::all_of(name.begin() + prefix.size(), name.end(),
+                       [](char c) { return c >= '0' && c <= '9'; });
+}
+
+#ifdef BOOST_ACTOR_WINDOWS
+
+shm_io_stream::~shm_io_stream() { }
+
+shm_io_stream_ptr shm_io_stream::create(stream_ptr, size_t) {
+    throw network_error("shared memory transport not supported");
+}
+
+shm_io_stream_ptr shm_io_stream::open(stream_ptr, const std::string&,
+                                      std::uint32_t) {
+    throw network_error("shared memory transport not supported");
+}
+
+void shm_io_stream::unlink() { }
+
+#else // BOOST_ACTOR_WINDOWS
+
+shm_io_stream::~shm_io_stream() {
+    unlink();
+    munmap(m_segment, m_segment_size);
+}
+
+shm_io_stream_ptr shm_io_stream::create(stream_ptr doorbell,
+                                        size_t ring_size) {
+    ring_size = normalized_ring_size(ring_size);
+    auto name = "/boost_actor_" + std::to_string(getpid()) + "_"
+              + std::to_string(++s_segment_id);
+    auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throw network_error("cannot create shared memory segment: "
+                            + fd_util::last_socket_error_as_string());
+    }
+    auto seg_size = sizeof(segment) + 2 * ring_size;
+    void* ptr = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(seg_size)) == 0) {
+        ptr = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+    }
+    auto err = fd_util::last_socket_error_as_string();
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw network_error("cannot map shared memory segment: " + err);
+    }
+    auto seg = new (ptr) segment(static_cast<std::uint32_t>(ring_size));
+    return new shm_io_stream(std::move(doorbell), std::move(name),
+                             seg, seg_size, true);
+}
+
+shm_io_stream_ptr shm_io_stream::open(stream_ptr doorbell,
+                                      const std::string& name,
+                                      std::uint32_t creator) {
+    // never touch objects not created by this library
+    if (!is_valid_name(name, creator)) {
+        throw network_error("invalid shared memory segment name");
+    }
+    auto fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw network_error("cannot open shared memory segment: "
+                            + fd_util::last_socket_error_as_string());
+    }
+    struct stat st;
+    void* ptr = MAP_FAILED;
+    size_t seg_size = 0;
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(segment))) {
+        seg_size = static_cast<size_t>(st.st_size);
+        ptr = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        throw network_error("cannot map shared memory segment");
+    }
+    auto seg = reinterpret_cast<segment*>(ptr);
+    size_t ring_size = seg->ring_size;
+    if (   seg->magic != segment_magic
+        || ring_size != normalized_ring_size(ring_size)
+        || seg_size != sizeof(segment) + 2 * ring_size) {
+        munmap(ptr, seg_size);
+        throw network_error("invalid shared memory segment");
+    }
+    // the segment is only used by the two processes that mapped it
+    shm_unlink(name.c_str());
+    return new shm_io_stream(std::move(doorbell), std::string{},
+                             seg, seg_size, false);
+}
+
+void shm_io_stream::unlink() {
+    if (!m_name.empty()) {
+        shm_unlink(m_name.c_str());
+        m_name.clear();
+    }
+}
+
+#endif // BOOST_ACTOR_WINDOWS
+
+void shm_io_stream::arm() {
+    m_armed = true;
+    if (m_deferred_ring) {
+        m_deferred_ring = false;
+        ring_doorbell();
+    }
+}
+
+native_socket_type shm_io_stream::read_handle() const {
+    return m_doorbell->read_handle();
+}
+
+native_socket_type shm_io_stream::write_handle() const {
+    return m_doorbell->write_handle();
+}
+
+void shm_io_stream::ring_doorbell() {
+    char dummy = 0;
+    // a full socket buffer means the remote side has yet to process
+    // previous wakeups, i.e., we can safely ignore the result
+    m_doorbell->write_some(&dummy, sizeof(dummy));
+}
+
+void shm_io_stream::await_doorbell() {
+    auto fd = m_doorbell->read_handle();
+    fd_set rdset;
+    FD_ZERO(&rdset);
+    FD_SET(fd, &rdset);
+    if (select(fd + 1, &rdset, nullptr, nullptr, nullptr) < 0) {
+        throw network_error("select() failed");
+    }
+}
+
+void shm_io_stream::read(void* vbuf, size_t len) {
+    auto buf = reinterpret_cast<char*>(vbuf);
+    size_t rd = 0;
+    while ((rd += read_some(buf + rd, len - rd)) < len) await_doorbell();
+}
+
+size_t shm_io_stream::read_some(void* vbuf, size_t len) {
+    auto buf = reinterpret_cast<char*>(vbuf);
+    auto& r = *m_in;
+    auto rd = r.rd.load(std::memory_order_relaxed);
+    size_t result = 0;
+    for (;;) {
+        size_t available = r.wr.load(std::memory_order_acquire) - rd;
+        if (available > m_ring_size) {
+            throw std::ios_base::failure("corrupted shared memory ring");
+        }
+        auto num_bytes = std::min(available, len - result);
+        if (num_bytes > 0) {
+            auto offset = rd & (m_ring_size - 1);
+            auto first = std::min(num_bytes, m_ring_size - offset);
+            memcpy(buf + result, m_in_data + offset, first);
+            memcpy(buf + result + first, m_in_data, num_bytes - first);
+            rd += static_cast<std::uint32_t>(num_bytes);
+            result += num_bytes;
+            r.rd.store(rd);
+            if (r.producer_waiting.exchange(0) != 0) {
+                if (m_armed) ring_doorbell();
+                else m_deferred_ring = true;
+            }
+        }
+        if (result == len) return result;
+        // the ring is empty; drain the doorbell before asking
+        // the producer to ring it again, because a level-triggered
+        // event loop would wake us up for old rings otherwise
+        try {
+            char tmp[64];
+            while (m_doorbell->read_some(tmp, sizeof(tmp)) == sizeof(tmp)) {
+                // repeat
+            }
+        }
+        catch (std::exception&) {
+            // the remote side might have closed the connection
+            // right after writing its last bytes
+            if (r.wr.load() != rd) continue;
+            if (result > 0) return result;
+            throw;
+        }
+        r.consumer_waiting.store(1);
+        if (r.wr.load() == rd) return result;
+        // new data arrived in the meantime; the producer
+        // might ring the doorbell anyways, which is harmless
+        r.consumer_waiting.store(0);
+    }
+}
+
+void shm_io_stream::write(const void* vbuf, size_t len) {
+    auto buf = reinterpret_cast<const char*>(vbuf);
+    size_t written = 0;
+    while ((written += write_some(buf + written, len - written)) < len) {
+        await_doorbell();
+    }
+}
+
+size_t shm_io_stream::write_some(const void* buf, size_t len) {
+    const_buffer cb{buf, len};
+    return write_some(&cb, 1);
+}
+
+size_t shm_io_stream::write_some(const const_buffer* bufs, size_t num_bufs) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(num_bufs));
+    auto& r = *m_out;
+    auto wr = r.wr.load(std::memory_order_relaxed);
+    size_t total = 0;
+    for (size_t i = 0; i < num_bufs; ++i) total += bufs[i].size;
+    size_t result = 0;
+    // position in bufs
+    size_t i = 0;
+    size_t pos = 0;
+    for (;;) {
+        size_t used = wr - r.rd.load(std::memory_order_acquire);
+        if (used > m_ring_size) {
+            throw std::ios_base::failure("corrupted shared memory ring");
+        }
+        auto free_space = m_ring_size - used;
+        auto before = result;
+        while (free_space > 0 && i < num_bufs) {
+            auto data = reinterpret_cast<const char*>(bufs[i].data) + pos;
+            auto num_bytes = std::min(free_space, bufs[i].size - pos);
+            auto offset = wr & (m_ring_size - 1);
+            auto first = std::min(num_bytes, m_ring_size - offset);
+            memcpy(m_out_data + offset, data, first);
+            memcpy(m_out_data, data + first, num_bytes - first);
+            wr += static_cast<std::uint32_t>(num_bytes);
+            free_space -= num_bytes;
+            result += num_bytes;
+            pos += num_bytes;
+            if (pos == bufs[i].size) {
+                ++i;
+                pos = 0;
+            }
+        }
+        if (result > before) {
+            r.wr.store(wr);
+            if (r.consumer_waiting.exchange(0) != 0) ring_doorbell();
+        }
+        if (result == total) return result;
+        // the ring is full; ask the consumer to ring
+        // the doorbell once it made some progress
+        r.producer_waiting.store(1);
+        if (wr - r.rd.load() == m_ring_size) return result;
+        r.producer_waiting.store(0);
+    }
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
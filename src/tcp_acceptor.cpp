@@ -107,9 +107,11 @@ tcp_acceptor::tcp_acceptor(native_socket_type fd, bool nonblocking)
 : m_fd(fd), m_is_nonblocking(nonblocking) { }
 
 std::unique_ptr<acceptor> tcp_acceptor::create(std::uint16_t port,
-                                                const char* addr) {
+                                                const char* addr,
+                                                bool reuse_port) {
     BOOST_ACTOR_LOGM_TRACE("tcp_acceptor", BOOST_ACTOR_ARG(port) << ", addr = "
-                                     << (addr ? addr : "nullptr"));
+                                     << (addr ? addr : "nullptr")
+                                     << ", " << BOOST_ACTOR_ARG(reuse_port));
 #   ifdef BOOST_ACTOR_WINDOWS
     // ensure that TCP has been initialized via WSAStartup
     cppa::get_middleman();
@@ -125,6 +127,16 @@ std::unique_ptr<acceptor> tcp_acceptor::create(std::uint16_t port,
                    reinterpret_cast<setsockopt_ptr>(&on), sizeof(on)) < 0) {
         throw_io_failure("unable to set SO_REUSEADDR");
     }
+    if (reuse_port) {
+#       ifdef SO_REUSEPORT
+        if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT,
+                       reinterpret_cast<setsockopt_ptr>(&on), sizeof(on)) < 0) {
+            throw_io_failure("unable to set SO_REUSEPORT");
+        }
+#       else
+        throw network_error("SO_REUSEPORT is not supported on this platform");
+#       endif
+    }
     struct sockaddr_in serv_addr;
     memset((char*) &serv_addr, 0, sizeof(serv_addr));
     serv_addr.sin_family = AF_INET;
@@ -157,6 +169,15 @@ native_socket_type tcp_acceptor::file_handle() const {
     return m_fd;
 }
 
+std::uint16_t tcp_acceptor::port() const {
+    sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    if (getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &addrlen) != 0) {
+        throw_io_failure("getsockname() failed");
+    }
+    return ntohs(addr.sin_port);
+}
+
 stream_ptr_pair tcp_acceptor::accept_connection() {
     if (m_is_nonblocking) {
         nonblocking(m_fd, false);
@@ -17,13 +17,16 @@
 
 
 #include <ios>
+#include <string>
 #include <cstring>
 #include <errno.h>
 #include <iostream>
+#include <algorithm>
 
 #include "boost/actor/config.hpp"
 #include "boost/actor/logging.hpp"
 #include "boost/actor/exception.hpp"
+#include "boost/actor/singletons.hpp"
 
 #include "boost/actor/io/fd_util.hpp"
 #include "boost/actor/io/tcp_io_stream.hpp"
@@ -34,6 +37,7 @@
 #else
 #   include <netdb.h>
 #   include <unistd.h>
+#   include <sys/uio.h>
 #   include <sys/types.h>
 #   include <sys/socket.h>
 #   include <netinet/in.h>
@@ -46,7 +50,25 @@ namespace io {
 
 using namespace ::boost::actor::io::fd_util;
 
-tcp_io_stream::tcp_io_stream(native_socket_type fd) : m_fd(fd) { }
+namespace {
+
+// report a connection closed by the remote side as EPIPE
+// instead of raising SIGPIPE, which terminates the process
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+} // namespace <anonymous>
+
+tcp_io_stream::tcp_io_stream(native_socket_type fd) : m_fd(fd) {
+#   ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE,
+               reinterpret_cast<setsockopt_ptr>(&on), sizeof(on));
+#   endif
+}
 
 tcp_io_stream::~tcp_io_stream() {
     closesocket(m_fd);
@@ -90,7 +112,8 @@ void tcp_io_stream::write(const void* vbuf, size_t len) {
     auto buf = reinterpret_cast<const char*>(vbuf);
     size_t written = 0;
     while (written < len) {
-        auto send_result = ::send(m_fd, buf + written, len - written, 0);
+        auto send_result = ::send(m_fd, buf + written, len - written,
+                                  send_flags);
         handle_write_result(send_result, true);
         if (send_result > 0) {
             written += static_cast<size_t>(send_result);
@@ -109,9 +132,32 @@ void tcp_io_stream::write(const void* vbuf, size_t len) {
 
 size_t tcp_io_stream::write_some(const void* buf, size_t len) {
     BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(buf) << ", " << BOOST_ACTOR_ARG(len));
-    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len, 0);
+    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len,
+                              send_flags);
     handle_write_result(send_result, true);
-    return static_cast<size_t>(send_result);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+}
+
+size_t tcp_io_stream::write_some(const const_buffer* bufs, size_t num_bufs) {
+    BOOST_ACTOR_LOG_TRACE(BOOST_ACTOR_ARG(num_bufs));
+#   ifdef BOOST_ACTOR_WINDOWS
+    return stream::write_some(bufs, num_bufs);
+#   else
+    static constexpr size_t max_bufs = 64;
+    iovec vec[max_bufs];
+    auto num = std::min(num_bufs, max_bufs);
+    for (size_t i = 0; i < num; ++i) {
+        vec[i].iov_base = const_cast<void*>(bufs[i].data);
+        vec[i].iov_len = bufs[i].size;
+    }
+    msghdr msg;
+    memset(&msg, 0, sizeof(msghdr));
+    msg.msg_iov = vec;
+    msg.msg_iovlen = num;
+    auto send_result = ::sendmsg(m_fd, &msg, send_flags);
+    handle_write_result(send_result, true);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+#   endif
 }
 
 io::stream_ptr tcp_io_stream::from_native_socket(native_socket_type fd) {
@@ -124,38 +170,80 @@ io::stream_ptr tcp_io_stream::connect_to(const char* host,
                                           std::uint16_t port) {
     BOOST_ACTOR_LOGF_TRACE(BOOST_ACTOR_ARG(host) << ", " << BOOST_ACTOR_ARG(port));
     BOOST_ACTOR_LOGF_INFO("try to connect to " << host << " on port " << port);
+    for (auto& ep : resolve(host, port)) {
+        auto addr = reinterpret_cast<const sockaddr*>(&ep.addr);
+        native_socket_type fd = socket(addr->sa_family, SOCK_STREAM, 0);
+        if (fd == invalid_socket) {
+            throw network_error("socket creation failed");
+        }
+        BOOST_ACTOR_LOGF_DEBUG("call connect()");
+        if (connect(fd, addr, ep.length) != 0) {
+            closesocket(fd);
+            continue;
+        }
+        BOOST_ACTOR_LOGF_DEBUG("enable nodelay + nonblocking for socket");
+        tcp_nodelay(fd, true);
+        nonblocking(fd, true);
+        return new tcp_io_stream(fd);
+    }
+    BOOST_ACTOR_LOGF_ERROR("could not connect to to " << host
+                           << " on port " << port);
+    throw network_error("could not connect to host");
+}
+
+std::vector<tcp_endpoint> tcp_io_stream::resolve(const char* host,
+                                                 std::uint16_t port) {
 #   ifdef BOOST_ACTOR_WINDOWS
     // make sure TCP has been initialized via WSAStartup
-    cppa::get_middleman();
+    get_middleman();
 #   endif
-    sockaddr_in serv_addr;
-    hostent* server;
-    native_socket_type fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (fd == invalid_socket) {
-        throw network_error("socket creation failed");
-    }
-    server = gethostbyname(host);
-    if (!server) {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addrs = nullptr;
+    auto service = std::to_string(port);
+    auto res = getaddrinfo(host, service.c_str(), &hints, &addrs);
+    if (res != 0 || addrs == nullptr) {
         std::string errstr = "no such host: ";
         errstr += host;
         throw network_error(std::move(errstr));
     }
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    memmove(&serv_addr.sin_addr.s_addr,
-            server->h_addr,
-            static_cast<size_t>(server->h_length));
-    serv_addr.sin_port = htons(port);
-    BOOST_ACTOR_LOGF_DEBUG("call connect()");
-    if (connect(fd, (const sockaddr*) &serv_addr, sizeof(serv_addr)) != 0) {
-        BOOST_ACTOR_LOGF_ERROR("could not connect to to " << host
-                        << " on port " << port);
-        throw network_error("could not connect to host");
+    std::vector<tcp_endpoint> result;
+    for (auto i = addrs; i != nullptr; i = i->ai_next) {
+        tcp_endpoint ep;
+        memset(&ep, 0, sizeof(ep));
+        memcpy(&ep.addr, i->ai_addr, i->ai_addrlen);
+        ep.length = static_cast<socklen_t>(i->ai_addrlen);
+        result.push_back(ep);
+    }
+    freeaddrinfo(addrs);
+    return result;
+}
+
+io::stream_ptr tcp_io_stream::connect_nonblocking(const tcp_endpoint& ep) {
+    auto addr = reinterpret_cast<const sockaddr*>(&ep.addr);
+    native_socket_type fd = socket(addr->sa_family, SOCK_STREAM, 0);
+    if (fd == invalid_socket) {
+        throw network_error("socket creation failed");
     }
-    BOOST_ACTOR_LOGF_DEBUG("enable nodelay + nonblocking for socket");
+    // the stream owns fd from now on
+    io::stream_ptr result = new tcp_io_stream(fd);
     tcp_nodelay(fd, true);
     nonblocking(fd, true);
-    return new tcp_io_stream(fd);
+    if (connect(fd, addr, ep.length) != 0) {
+        auto err = last_socket_error();
+#       ifdef BOOST_ACTOR_WINDOWS
+        auto in_progress = would_block_or_temporarily_unavailable(err);
+#       else
+        auto in_progress = err == EINPROGRESS;
+#       endif
+        if (!in_progress) {
+            throw network_error("could not connect to host: "
+                                + last_socket_error_as_string());
+        }
+    }
+    return result;
 }
 
 } } // namespace actor
@@ -0,0 +1,160 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <algorithm>
+
+#include "boost/actor/detail/timer_wheel.hpp"
+
+namespace boost {
+namespace actor {
+namespace detail {
+
+namespace {
+
+constexpr std::uint64_t slot_mask = timer_wheel::num_slots - 1;
+
+// number of ticks covered by all levels
+constexpr std::uint64_t max_delta = std::uint64_t{1}
+                                    << (timer_wheel::slot_bits
+                                        * timer_wheel::num_levels);
+
+} // namespace <anonymous>
+
+timer_entry::timer_entry(time_point due_time, message_header header,
+                         message content)
+: next(nullptr), next_cancelled(nullptr), due(due_time)
+, hdr(std::move(header)), msg(std::move(content)), m_disarmed(false)
+, m_prev(nullptr), m_slot(nullptr) { }
+
+void timer_entry::release() {
+    hdr = message_header{};
+    msg.reset();
+    deref();
+}
+
+timer_wheel::timer_wheel(time_point origin)
+: m_origin(origin), m_next(0), m_size(0) {
+    for (auto& level : m_slots) {
+        for (auto& slot : level) slot.first = slot.second = nullptr;
+    }
+}
+
+timer_wheel::~timer_wheel() {
+    for (auto& level : m_slots) {
+        for (auto& slot : level) {
+            auto e = slot.first;
+            while (e) {
+                auto next = e->next;
+                e->m_slot = nullptr;
+                e->disarm();
+                e->release();
+                e = next;
+            }
+        }
+    }
+}
+
+std::uint64_t timer_wheel::elapsed_ticks(time_point tp) const {
+    if (tp <= m_origin) return 0;
+    auto d = std::chrono::duration_cast<tick_duration>(tp - m_origin);
+    return static_cast<std::uint64_t>(d.count());
+}
+
+std::uint64_t timer_wheel::due_tick(time_point tp) const {
+    if (tp <= m_origin) return 0;
+    auto d = tp - m_origin;
+    auto ticks = std::chrono::duration_cast<tick_duration>(d);
+    // duration_cast truncates, i.e., rounds towards zero
+    if (ticks < d) ++ticks;
+    return static_cast<std::uint64_t>(ticks.count());
+}
+
+void timer_wheel::insert(timer_entry* ptr) {
+    ++m_size;
+    add(ptr);
+}
+
+void timer_wheel::add(timer_entry* ptr) {
+    auto due = std::max(due_tick(ptr->due), m_next);
+    auto delta = due - m_next;
+    slot_type* slot;
+    if (delta >= max_delta) {
+        // store in the top-level slot that is cascaded last,
+        // i.e., recompute the position once we get there
+        auto shift = slot_bits * (num_levels - 1);
+        slot = &m_slots[num_levels - 1][((m_next >> shift) - 1) & slot_mask];
+    }
+    else {
+        size_t level = 0;
+        while (delta >= (std::uint64_t{1} << (slot_bits * (level + 1)))) {
+            ++level;
+        }
+        slot = &m_slots[level][(due >> (slot_bits * level)) & slot_mask];
+    }
+    // append to slot, thus entries with the same due tick are
+    // delivered in the order of insertion
+    ptr->next = nullptr;
+    ptr->m_prev = slot->second;
+    ptr->m_slot = slot;
+    if (slot->second) slot->second->next = ptr;
+    else slot->first = ptr;
+    slot->second = ptr;
+}
+
+bool timer_wheel::erase(timer_entry* ptr) {
+    auto slot = ptr->m_slot;
+    if (!slot) return false;
+    if (ptr->m_prev) ptr->m_prev->next = ptr->next;
+    else slot->first = ptr->next;
+    if (ptr->next) ptr->next->m_prev = ptr->m_prev;
+    else slot->second = ptr->m_prev;
+    ptr->next = ptr->m_prev = nullptr;
+    ptr->m_slot = nullptr;
+    --m_size;
+    ptr->release();
+    return true;
+}
+
+void timer_wheel::cascade() {
+    for (size_t level = 1; level < num_levels; ++level) {
+        auto index = (m_next >> (slot_bits * level)) & slot_mask;
+        auto& slot = m_slots[level][index];
+        auto e = slot.first;
+        slot.first = slot.second = nullptr;
+        while (e) {
+            auto next = e->next;
+            add(e);
+            e = next;
+        }
+        // higher levels only need to cascade if this level did a full turn
+        if (index != 0) return;
+    }
+}
+
+timer_wheel::time_point timer_wheel::next_timeout() const {
+    // entries stored at higher levels cannot become due before
+    // the first level did a full turn, i.e., before the next cascade
+    auto boundary = (m_next | slot_mask) + 1;
+    auto tick = m_next;
+    while (tick < boundary && !m_slots[0][tick & slot_mask].first) ++tick;
+    return m_origin + tick_duration{tick};
+}
+
+} // namespace detail
+} // namespace actor
+} // namespace boost
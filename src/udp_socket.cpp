@@ -0,0 +1,315 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <ios>
+#include <cstring>
+#include <algorithm>
+
+#include "boost/actor/config.hpp"
+#include "boost/actor/logging.hpp"
+#include "boost/actor/exception.hpp"
+
+#include "boost/actor/io/fd_util.hpp"
+#include "boost/actor/io/udp_socket.hpp"
+
+#ifdef BOOST_ACTOR_WINDOWS
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <unistd.h>
+#   include <arpa/inet.h>
+#   include <sys/types.h>
+#   include <sys/socket.h>
+#   include <netinet/in.h>
+#endif
+
+namespace boost {
+namespace actor {
+namespace io {
+
+using namespace ::boost::actor::io::fd_util;
+
+namespace {
+
+constexpr size_t default_max_datagram_size = 65535;
+
+#ifndef BOOST_ACTOR_WINDOWS
+
+// returns whether the failed send operation should drop
+// the datagram rather than waiting for the socket to become writable
+bool drop_on_send_error(int errcode) {
+    if (would_block_or_temporarily_unavailable(errcode) || errcode == EINTR) {
+        return false;
+    }
+    if (errcode == EBADF || errcode == ENOTSOCK) {
+        throw_io_failure("cannot send datagram");
+    }
+    return true;
+}
+
+#endif // BOOST_ACTOR_WINDOWS
+
+} // namespace <anonymous>
+
+constexpr size_t udp_socket::max_batch_size;
+
+udp_socket::udp_socket(native_socket_type fd)
+: m_fd(fd), m_family(AF_INET)
+, m_max_datagram_size(default_max_datagram_size) {
+    sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    if (getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &addrlen) == 0) {
+        m_family = addr.ss_family;
+    }
+}
+
+udp_socket_uptr udp_socket::create(std::uint16_t port,
+                                   const char* addr,
+                                   bool reuse_port) {
+    BOOST_ACTOR_LOGM_TRACE("udp_socket", BOOST_ACTOR_ARG(port) << ", addr = "
+                                   << (addr ? addr : "nullptr")
+                                   << ", " << BOOST_ACTOR_ARG(reuse_port));
+#   ifdef BOOST_ACTOR_WINDOWS
+    throw network_error("UDP sockets are not supported on this platform");
+#   else
+    ip_endpoint ep{addr ? addr : "0.0.0.0", port};
+    int family = ep.is_v4() ? AF_INET : AF_INET6;
+    native_socket_type sockfd = socket(family, SOCK_DGRAM, 0);
+    if (sockfd == invalid_socket) {
+        throw network_error("could not create UDP socket");
+    }
+    // takes ownership of sockfd
+    udp_socket_uptr result{new udp_socket(sockfd)};
+    result->m_family = family;
+    int on = 1;
+    if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR,
+                   reinterpret_cast<setsockopt_ptr>(&on), sizeof(on)) < 0) {
+        throw_io_failure("unable to set SO_REUSEADDR");
+    }
+    if (reuse_port) {
+#       ifdef SO_REUSEPORT
+        if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT,
+                       reinterpret_cast<setsockopt_ptr>(&on), sizeof(on)) < 0) {
+            throw_io_failure("unable to set SO_REUSEPORT");
+        }
+#       else
+        throw network_error("SO_REUSEPORT is not supported on this platform");
+#       endif
+    }
+    sockaddr_storage bind_addr;
+    auto addrlen = ep.to_sockaddr(&bind_addr, family);
+    if (bind(sockfd, reinterpret_cast<sockaddr*>(&bind_addr),
+             static_cast<socklen_t>(addrlen)) < 0) {
+        throw bind_failure(errno);
+    }
+    nonblocking(sockfd, true);
+    BOOST_ACTOR_LOGM_DEBUG("udp_socket", "sockfd = " << sockfd);
+    return result;
+#   endif
+}
+
+udp_socket_uptr udp_socket::from_sockfd(native_socket_type fd) {
+    nonblocking(fd, true);
+    return udp_socket_uptr{new udp_socket(fd)};
+}
+
+udp_socket::~udp_socket() {
+    closesocket(m_fd);
+}
+
+native_socket_type udp_socket::file_handle() const {
+    return m_fd;
+}
+
+std::uint16_t udp_socket::port() const {
+    sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    if (getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &addrlen) != 0) {
+        throw_io_failure("getsockname() failed");
+    }
+    return ip_endpoint::from_sockaddr(&addr).port();
+}
+
+void udp_socket::max_datagram_size(size_t num_bytes) {
+    m_max_datagram_size = std::max<size_t>(num_bytes, 1);
+    m_area.reset();
+}
+
+size_t udp_socket::receive() {
+#   ifdef BOOST_ACTOR_WINDOWS
+    throw network_error("UDP sockets are not supported on this platform");
+#   else
+    auto dgram_size = m_max_datagram_size;
+    auto batch = max_batch_size;
+    if (!m_area) {
+        // one slot per datagram of a full batch; the memory is not
+        // initialized, i.e., the OS commits only pages that
+        // actually received data
+        m_area.reset(new char[batch * dgram_size]);
+        m_received.resize(batch);
+    }
+    iovec iovs[max_batch_size];
+    sockaddr_storage addrs[max_batch_size];
+#   ifdef BOOST_ACTOR_LINUX
+    mmsghdr msgs[max_batch_size];
+    // a batch consisting of dropped datagrams only does
+    // not indicate that no more datagrams are pending
+    for (;;) {
+        memset(msgs, 0, sizeof(mmsghdr) * batch);
+        for (size_t i = 0; i < batch; ++i) {
+            iovs[i].iov_base = m_area.get() + i * dgram_size;
+            iovs[i].iov_len = dgram_size;
+            auto& hdr = msgs[i].msg_hdr;
+            hdr.msg_name = &addrs[i];
+            hdr.msg_namelen = sizeof(sockaddr_storage);
+            hdr.msg_iov = &iovs[i];
+            hdr.msg_iovlen = 1;
+        }
+        auto res = recvmmsg(m_fd, msgs, static_cast<unsigned>(batch), 0,
+                            nullptr);
+        if (res < 0) {
+            auto err = last_socket_error();
+            if (err == EINTR) continue;
+            if (would_block_or_temporarily_unavailable(err)) return 0;
+            throw_io_failure("recvmmsg() failed");
+        }
+        size_t result = 0;
+        for (size_t i = 0; i < static_cast<size_t>(res); ++i) {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                BOOST_ACTOR_LOG_WARNING("dropped datagram exceeding "
+                                        << dgram_size << " bytes");
+                continue;
+            }
+            auto& r = m_received[result++];
+            r.remote = ip_endpoint::from_sockaddr(&addrs[i]);
+            r.data = static_cast<const char*>(iovs[i].iov_base);
+            r.size = msgs[i].msg_len;
+        }
+        if (result > 0) return result;
+    }
+#   else // no recvmmsg, receive one datagram per system call
+    size_t result = 0;
+    while (result < batch) {
+        msghdr hdr;
+        memset(&hdr, 0, sizeof(msghdr));
+        iovs[0].iov_base = m_area.get() + result * dgram_size;
+        iovs[0].iov_len = dgram_size;
+        hdr.msg_name = &addrs[0];
+        hdr.msg_namelen = sizeof(sockaddr_storage);
+        hdr.msg_iov = &iovs[0];
+        hdr.msg_iovlen = 1;
+        auto res = recvmsg(m_fd, &hdr, 0);
+        if (res < 0) {
+            auto err = last_socket_error();
+            if (err == EINTR) continue;
+            if (would_block_or_temporarily_unavailable(err)) break;
+            throw_io_failure("recvmsg() failed");
+        }
+        if (hdr.msg_flags & MSG_TRUNC) {
+            BOOST_ACTOR_LOG_WARNING("dropped datagram exceeding "
+                                    << dgram_size << " bytes");
+            continue;
+        }
+        auto& r = m_received[result++];
+        r.remote = ip_endpoint::from_sockaddr(&addrs[0]);
+        r.data = static_cast<const char*>(iovs[0].iov_base);
+        r.size = static_cast<size_t>(res);
+    }
+    return result;
+#   endif
+#   endif // BOOST_ACTOR_WINDOWS
+}
+
+size_t udp_socket::send(const datagram* first, size_t num) {
+#   ifdef BOOST_ACTOR_WINDOWS
+    static_cast<void>(first);
+    static_cast<void>(num);
+    throw network_error("UDP sockets are not supported on this platform");
+#   else
+    iovec iovs[max_batch_size];
+    sockaddr_storage addrs[max_batch_size];
+    // maps prepared messages to their index in the current batch
+    size_t indices[max_batch_size];
+    size_t done = 0;
+    while (done < num) {
+        auto batch = std::min(num - done, max_batch_size);
+        size_t prepared = 0;
+#       ifdef BOOST_ACTOR_LINUX
+        mmsghdr msgs[max_batch_size];
+        memset(msgs, 0, sizeof(mmsghdr) * batch);
+#       else
+        msghdr msgs[max_batch_size];
+        memset(msgs, 0, sizeof(msghdr) * batch);
+#       endif
+        for (size_t i = 0; i < batch; ++i) {
+            auto& dg = first[done + i];
+            auto addrlen = dg.remote.to_sockaddr(&addrs[prepared], m_family);
+            if (addrlen == 0) {
+                BOOST_ACTOR_LOG_WARNING("dropped datagram to "
+                                        << dg.remote.host()
+                                        << ": address family not supported");
+                continue;
+            }
+            iovs[prepared].iov_base = const_cast<void*>(dg.buf.data());
+            iovs[prepared].iov_len = dg.buf.size();
+#           ifdef BOOST_ACTOR_LINUX
+            auto& hdr = msgs[prepared].msg_hdr;
+#           else
+            auto& hdr = msgs[prepared];
+#           endif
+            hdr.msg_name = &addrs[prepared];
+            hdr.msg_namelen = static_cast<socklen_t>(addrlen);
+            hdr.msg_iov = &iovs[prepared];
+            hdr.msg_iovlen = 1;
+            indices[prepared++] = i;
+        }
+        if (prepared == 0) {
+            done += batch;
+            continue;
+        }
+#       ifdef BOOST_ACTOR_LINUX
+        auto res = sendmmsg(m_fd, msgs, static_cast<unsigned>(prepared), 0);
+#       else
+        size_t sent = 0;
+        while (sent < prepared && sendmsg(m_fd, &msgs[sent], 0) >= 0) ++sent;
+        auto res = sent == 0 ? -1 : static_cast<int>(sent);
+#       endif
+        if (res < 0) {
+            auto err = last_socket_error();
+            if (!drop_on_send_error(err)) {
+                if (err == EINTR) continue;
+                // send buffer is full, datagrams prior to the first
+                // prepared one were dropped and thus are done as well
+                return done + indices[0];
+            }
+            BOOST_ACTOR_LOG_WARNING("dropped datagram to "
+                                    << first[done + indices[0]].remote.host()
+                                    << ": " << last_socket_error_as_string());
+            done += indices[0] + 1;
+        }
+        else if (static_cast<size_t>(res) == prepared) done += batch;
+        // retry starting at the first unsent datagram to read its error
+        else done += indices[res];
+    }
+    return done;
+#   endif // BOOST_ACTOR_WINDOWS
+}
+
+} // namespace io
+} // namespace actor
+} // namespace boost
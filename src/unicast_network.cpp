@@ -20,7 +20,9 @@
 
 #include <ios> // ios_base::failure
 #include <list>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include <cstring>    // memset
 #include <cstdint>
 #include <iostream>
@@ -43,8 +45,10 @@
 #include "boost/actor/detail/raw_access.hpp"
 #include "boost/actor/detail/single_reader_queue.hpp"
 
+#include "boost/actor/io/fd_util.hpp"
 #include "boost/actor/io/acceptor.hpp"
 #include "boost/actor/io/middleman.hpp"
+#include "boost/actor/io/continuable.hpp"
 #include "boost/actor/io/tcp_acceptor.hpp"
 #include "boost/actor/io/tcp_io_stream.hpp"
 #include "boost/actor/io/peer_acceptor.hpp"
@@ -66,6 +70,44 @@ namespace detail {
 
 using namespace io;
 
+namespace {
+
+void check_interface(const string_set& iface, const string_set& expected) {
+    if (iface == expected) return;
+    auto tostr = [](const std::set<std::string>& what) -> std::string {
+        if (what.empty()) return "actor";
+        std::string tmp;
+        tmp = "typed_actor<";
+        auto i = what.begin();
+        auto e = what.end();
+        tmp += *i++;
+        while (i != e) tmp += *i++;
+        tmp += ">";
+        return tmp;
+    };
+    auto iface_str = tostr(iface);
+    auto expected_str = tostr(expected);
+    if (expected.empty()) {
+        throw std::invalid_argument("expected remote actor to be a "
+                                    "dynamically typed actor but found "
+                                    "a strongly typed actor of type "
+                                    + iface_str);
+    }
+    if (iface.empty()) {
+        throw std::invalid_argument("expected remote actor to be a "
+                                    "strongly typed actor of type "
+                                    + expected_str +
+                                    " but found a dynamically typed actor");
+    }
+    throw std::invalid_argument("expected remote actor to be a "
+                                "strongly typed actor of type "
+                                + expected_str +
+                                " but found a strongly typed actor of type "
+                                + iface_str);
+}
+
+} // namespace <anonymous>
+
 void publish_impl(abstract_actor_ptr ptr, std::unique_ptr<acceptor> aptr) {
     // begin the scenes, we serialze/deserialize as actor
     actor whom{raw_access::unsafe_cast(ptr.get())};
@@ -80,6 +122,33 @@ void publish_impl(abstract_actor_ptr ptr, std::unique_ptr<acceptor> aptr) {
                                                   addr, std::move(sigs)));
 }
 
+void publish_impl(abstract_actor_ptr ptr, std::uint16_t port,
+                  const char* addr) {
+    size_t num_shards = 1;
+#   ifdef SO_REUSEPORT
+    auto cfg = scheduler::get_configuration();
+    if (cfg.shard_acceptors) {
+        num_shards = std::max(cfg.num_middleman_loops, size_t{1});
+    }
+#   endif
+    if (num_shards == 1) {
+        publish_impl(std::move(ptr), tcp_acceptor::create(port, addr));
+        return;
+    }
+    // create all sockets before publishing any of them; the first
+    // socket determines the port if the OS picks one for us
+    std::vector<acceptor_uptr> shards;
+    shards.push_back(tcp_acceptor::create(port, addr, true));
+    if (port == 0) {
+        port = static_cast<tcp_acceptor*>(shards.front().get())->port();
+    }
+    while (shards.size() < num_shards) {
+        shards.push_back(tcp_acceptor::create(port, addr, true));
+    }
+    // the middleman assigns acceptors round-robin to its event loops
+    for (auto& aptr : shards) publish_impl(ptr, std::move(aptr));
+}
+
 abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
     BOOST_ACTOR_LOGF_TRACE("io{" << io.first.get() << ", "
                            << io.second.get() << "}");
@@ -129,38 +198,7 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
         iface.insert(std::string{strbuf.data()});
     }
     // deserialization done, check interface
-    if (iface != expected) {
-        auto tostr = [](const std::set<std::string>& what) -> std::string {
-            if (what.empty()) return "actor";
-            std::string tmp;
-            tmp = "typed_actor<";
-            auto i = what.begin();
-            auto e = what.end();
-            tmp += *i++;
-            while (i != e) tmp += *i++;
-            tmp += ">";
-            return tmp;
-        };
-        auto iface_str = tostr(iface);
-        auto expected_str = tostr(expected);
-        if (expected.empty()) {
-            throw std::invalid_argument("expected remote actor to be a "
-                                        "dynamically typed actor but found "
-                                        "a strongly typed actor of type "
-                                        + iface_str);
-        }
-        if (iface.empty()) {
-            throw std::invalid_argument("expected remote actor to be a "
-                                        "strongly typed actor of type "
-                                        + expected_str +
-                                        " but found a dynamically typed actor");
-        }
-        throw std::invalid_argument("expected remote actor to be a "
-                                    "strongly typed actor of type "
-                                    + expected_str +
-                                    " but found a strongly typed actor of type "
-                                    + iface_str);
-    }
+    check_interface(iface, expected);
     auto pinfptr = make_counted<node_id>(peer_pid, peer_node_id);
     if (*pinf == *pinfptr) {
         // this is a local actor, not a remote actor
@@ -173,7 +211,7 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
     std::mutex qmtx;
     std::condition_variable qcv;
     detail::single_reader_queue<remote_actor_result> q;
-    mm->run_later([mm, io, pinfptr, remote_aid, &q, &qmtx, &qcv] {
+    mm->run_later(*pinfptr, [mm, io, pinfptr, remote_aid, &q, &qmtx, &qcv] {
         BOOST_ACTOR_LOGC_TRACE("cppa",
                         "remote_actor$create_connection", "");
         auto pp = mm->get_peer(*pinfptr);
@@ -188,6 +226,298 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
     return raw_access::get(result->value);
 }
 
+namespace {
+
+// creates a proxy for the actor aid on node using the connection io
+// and sends it to helper; must run in the event loop responsible for node
+void connect_proxy(middleman* mm, stream_ptr io, node_id_ptr node,
+                   actor_id aid, actor helper) {
+    mm->run_later(*node, [=] {
+        auto pp = mm->get_peer(*node);
+        BOOST_ACTOR_LOGF_INFO_IF(pp, "connection already exists "
+                                     "(re-use old one)");
+        if (!pp) mm->new_peer(io, io, node);
+        auto res = mm->get_namespace().get_or_put(node, aid);
+        anon_send(helper, atom("CONNECTED"), raw_access::unsafe_cast(res));
+    });
+}
+
+class async_connector;
+
+// state of an asynchronous connection attempt, which is
+// accessed only from the first event loop of the middleman
+struct connect_state {
+    // receives either the proxy or an error message
+    actor helper;
+    // addresses of the remote host not tried yet
+    std::vector<tcp_endpoint> endpoints;
+    // pending connector if any
+    async_connector* pending;
+    // set on timeout
+    bool aborted;
+    // set once the helper is going to receive the outcome, i.e., once
+    // the handshake succeeded or all endpoints failed; late timeouts
+    // are ignored afterwards
+    bool done;
+    // last error reported by a connector
+    std::string last_error;
+};
+
+typedef std::shared_ptr<connect_state> connect_state_ptr;
+
+void try_next_endpoint(middleman* mm, const connect_state_ptr& st);
+
+/*
+ * Connects to a single address of the remote host and reads the
+ * handshake of its peer_acceptor without blocking the event loop.
+ */
+class async_connector : public continuable {
+
+    typedef continuable super;
+
+ public:
+
+    async_connector(middleman* mm, connect_state_ptr st, stream_ptr io)
+    : super(io->read_handle(), io->write_handle()), m_parent(mm)
+    , m_state(std::move(st)), m_io(std::move(io)), m_connected(false)
+    , m_done(false), m_stage(read_header), m_rd(0), m_iface_size(0) {
+        m_buf.resize(sizeof(actor_id) + sizeof(std::uint32_t)
+                     + node_id::host_id_size + sizeof(std::uint32_t));
+    }
+
+    ~async_connector();
+
+    continue_writing_result continue_writing() override {
+        // the socket becomes writable once connect() completed
+        auto err = fd_util::socket_error(write_handle());
+        if (err != 0) {
+            m_state->last_error = "could not connect to host: "
+                                + std::string(strerror(err));
+            return continue_writing_result::failure;
+        }
+        try {
+            auto pinf = m_parent->node();
+            auto process_id = pinf->process_id();
+            m_io->write(&process_id, sizeof(std::uint32_t));
+            m_io->write(pinf->host_id().data(), pinf->host_id().size());
+        }
+        catch (std::exception& e) {
+            m_state->last_error = e.what();
+            return continue_writing_result::failure;
+        }
+        m_connected = true;
+        m_parent->continue_reader(this);
+        return continue_writing_result::done;
+    }
+
+    continue_reading_result continue_reading() override {
+        // a refused connection signals event::both, but
+        // continue_writing() has already reported the error
+        if (!m_connected) return continue_reading_result::continue_later;
+        try {
+            for (;;) {
+                // read only the handshake, because the peer
+                // reads all following messages
+                while (m_rd < m_buf.size()) {
+                    auto rd = m_io->read_some(m_buf.data() + m_rd,
+                                              m_buf.size() - m_rd);
+                    if (rd == 0) return continue_reading_result::continue_later;
+                    m_rd += rd;
+                }
+                if (handle_stage()) {
+                    return continue_reading_result::closed;
+                }
+            }
+        }
+        catch (std::exception& e) {
+            m_state->last_error = e.what();
+            // a remote node speaking our protocol will not accept us
+            // on any of its other addresses either
+            m_state->endpoints.clear();
+            return continue_reading_result::failure;
+        }
+    }
+
+    void io_failed(event_bitmask) override {
+        // nop
+    }
+
+    void dispose() override {
+        if (m_state->pending == this) {
+            m_state->pending = nullptr;
+            if (!m_done && !m_state->aborted) {
+                try_next_endpoint(m_parent, m_state);
+            }
+        }
+        delete this;
+    }
+
+ private:
+
+    enum stage {
+        read_header,
+        read_signature_size,
+        read_signature
+    };
+
+    template<typename T>
+    T read_at(size_t offset) {
+        T result;
+        memcpy(&result, m_buf.data() + offset, sizeof(T));
+        return result;
+    }
+
+    void expect(stage next, size_t num_bytes) {
+        m_stage = next;
+        m_rd = 0;
+        m_buf.resize(num_bytes);
+    }
+
+    // returns true once the handshake has been completed
+    bool handle_stage() {
+        switch (m_stage) {
+            case read_header: {
+                m_aid = read_at<actor_id>(0);
+                auto pid = read_at<std::uint32_t>(sizeof(actor_id));
+                node_id::host_id_type host_id;
+                memcpy(host_id.data(),
+                       m_buf.data() + sizeof(actor_id) + sizeof(std::uint32_t),
+                       node_id::host_id_size);
+                m_node = make_counted<node_id>(pid, host_id);
+                m_iface_size = read_at<std::uint32_t>(m_buf.size()
+                                                      - sizeof(std::uint32_t));
+                if (m_iface_size > max_iface_size) {
+                    throw std::invalid_argument("remote actor claims to have "
+                                                "too many message types");
+                }
+                break;
+            }
+            case read_signature_size: {
+                auto str_size = read_at<std::uint32_t>(0);
+                if (str_size > max_iface_clause_size) {
+                    throw std::invalid_argument("remote actor claims to have "
+                                                "a too long signature");
+                }
+                expect(read_signature, str_size);
+                return false;
+            }
+            case read_signature:
+                m_iface.insert(std::string(m_buf.begin(), m_buf.end()));
+                break;
+        }
+        if (m_iface.size() < m_iface_size) {
+            expect(read_signature_size, sizeof(std::uint32_t));
+            return false;
+        }
+        check_interface(m_iface, string_set{});
+        m_done = true;
+        m_state->done = true;
+        auto pinf = m_parent->node();
+        if (*pinf == *m_node) {
+            BOOST_ACTOR_LOGF_WARNING("remote_actor() called to "
+                                     "access a local actor");
+            auto ptr = get_actor_registry()->get(m_aid);
+            anon_send(m_state->helper, atom("CONNECTED"),
+                      raw_access::unsafe_cast(ptr));
+        }
+        else {
+            connect_proxy(m_parent, m_io, m_node, m_aid, m_state->helper);
+        }
+        return true;
+    }
+
+    middleman* m_parent;
+    connect_state_ptr m_state;
+    stream_ptr m_io;
+    bool m_connected;
+    bool m_done;
+    stage m_stage;
+    std::vector<char> m_buf;
+    size_t m_rd;
+    actor_id m_aid;
+    node_id_ptr m_node;
+    std::uint32_t m_iface_size;
+    string_set m_iface;
+
+};
+
+// avoid weak-vtables warning by providing dtor out-of-line
+async_connector::~async_connector() { }
+
+void try_next_endpoint(middleman* mm, const connect_state_ptr& st) {
+    while (!st->endpoints.empty()) {
+        auto ep = st->endpoints.front();
+        st->endpoints.erase(st->endpoints.begin());
+        try {
+            auto io = tcp_io_stream::connect_nonblocking(ep);
+            st->pending = new async_connector(mm, st, io);
+            mm->continue_writer(st->pending);
+            return;
+        }
+        catch (std::exception& e) {
+            st->last_error = e.what();
+        }
+    }
+    st->done = true;
+    anon_send(st->helper, atom("CONN_ERROR"), st->last_error);
+}
+
+} // namespace <anonymous>
+
+void remote_actor_impl(actor listener, std::string host, std::uint16_t port,
+                       std::chrono::milliseconds timeout) {
+    auto mm = get_middleman();
+    spawn<hidden>([=](event_based_actor* self) -> behavior {
+        auto st = std::make_shared<connect_state>();
+        st->helper = raw_access::unsafe_cast(self);
+        st->pending = nullptr;
+        st->aborted = false;
+        st->done = false;
+        // resolve host outside of the event loops and
+        // connect to all of its addresses one after another
+        mm->run_blocking([=] {
+            std::vector<tcp_endpoint> endpoints;
+            try { endpoints = tcp_io_stream::resolve(host.c_str(), port); }
+            catch (std::exception& e) {
+                anon_send(st->helper, atom("CONN_ERROR"),
+                          std::string(e.what()));
+                return;
+            }
+            mm->run_later([=] {
+                if (st->aborted) return;
+                st->endpoints = std::move(endpoints);
+                st->last_error = "no such host: " + host;
+                try_next_endpoint(mm, st);
+            });
+        });
+        return (
+            on(atom("CONNECTED"), arg_match) >> [=](const actor& proxy) {
+                self->send(listener, atom("CONNECTED"), host, port, proxy);
+                self->quit();
+            },
+            on(atom("CONN_ERROR"), arg_match) >> [=](const std::string& what) {
+                self->send(listener, atom("CONN_ERROR"), host, port, what);
+                self->quit();
+            },
+            after(timeout) >> [=] {
+                // the event loop decides whether the timeout is still
+                // relevant, because it might have completed the
+                // handshake already, i.e., CONNECTED is on its way
+                mm->run_later([=] {
+                    if (st->done || st->aborted) return;
+                    st->aborted = true;
+                    if (st->pending) {
+                        mm->stop_writer(st->pending);
+                        mm->stop_reader(st->pending);
+                    }
+                    anon_send(st->helper, atom("CONN_ERROR"),
+                              std::string("connection timed out"));
+                });
+            }
+        );
+    });
+}
+
 } // namespace detail
 } // namespace actor
 } // namespace boost
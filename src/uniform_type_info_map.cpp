@@ -40,7 +40,7 @@
 #include "boost/actor/message_builder.hpp"
 
 #include "boost/actor/detail/scope_guard.hpp"
-#include "boost/actor/detail/shared_spinlock.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
 
 #include "boost/actor/detail/raw_access.hpp"
 #include "boost/actor/detail/safe_equal.hpp"
@@ -61,6 +61,7 @@ namespace detail {
     { "boost::actor::atom_value",                       "@atom"               },
     { "boost::actor::channel",                          "@channel"            },
     { "boost::actor::connection_closed_msg",            "@conn_closed"        },
+    { "boost::actor::datagram_closed_msg",              "@dgram_closed"       },
     { "boost::actor::down_msg",                         "@down"               },
     { "boost::actor::duration",                         "@duration"           },
     { "boost::actor::exit_msg",                         "@exit"               },
@@ -69,10 +70,12 @@ namespace detail {
     { "boost::actor::io::accept_handle",                "@ac_hdl"             },
     { "boost::actor::io::buffer",                       "@buffer"             },
     { "boost::actor::io::connection_handle",            "@cn_hdl"             },
+    { "boost::actor::io::datagram_handle",              "@dg_hdl"             },
     { "boost::actor::message",                          "@message"            },
     { "boost::actor::message_header",                   "@header"             },
     { "boost::actor::new_connection_msg",               "@new_conn"           },
     { "boost::actor::new_data_msg",                     "@new_data"           },
+    { "boost::actor::new_datagram_msg",                 "@new_dgram"          },
     { "boost::actor::sync_exited_msg",                  "@sync_exited"        },
     { "boost::actor::sync_timeout_msg",                 "@sync_timeout"       },
     { "boost::actor::timeout_msg",                      "@timeout"            },
@@ -326,25 +329,11 @@ void deserialize_impl(message_header& hdr, deserializer* source) {
 }
 
 void serialize_impl(const node_id_ptr& ptr, serializer* sink) {
-    if (ptr == nullptr) {
-        node_id::serialize_invalid(sink);
-    }
-    else {
-        sink->write_value(ptr->process_id());
-        sink->write_raw(ptr->host_id().size(), ptr->host_id().data());
-    }
+    sink->write_node_id(ptr.get());
 }
 
 void deserialize_impl(node_id_ptr& ptr, deserializer* source) {
-    node_id::host_id_type nid;
-    auto pid = source->read<uint32_t>();
-    source->read_raw(node_id::host_id_size, nid.data());
-    auto is_zero = [](uint8_t value) { return value == 0; };
-    if (pid == 0 && std::all_of(nid.begin(), nid.end(), is_zero)) {
-        // invalid process information (nullptr)
-        ptr.reset();
-    }
-    else ptr.reset(new node_id{pid, nid});
+    ptr = source->read_node_id();
 }
 
 inline void serialize_impl(const atom_value& val, serializer* sink) {
@@ -449,11 +438,14 @@ inline void deserialize_impl(new_connection_msg& ncm, deserializer* source) {
 // buffer_type_info_impl and are thus implemented below that class
 void serialize_impl(const new_data_msg& ndm, serializer* sink);
 void deserialize_impl(new_data_msg& ndm, deserializer* source);
+void serialize_impl(const new_datagram_msg& ndm, serializer* sink);
+void deserialize_impl(new_datagram_msg& ndm, deserializer* source);
 
 template<typename T>
 typename std::enable_if<
        std::is_same<T, connection_closed_msg>::value
     || std::is_same<T, acceptor_closed_msg>::value
+    || std::is_same<T, datagram_closed_msg>::value
 >::type
 serialize_impl(const T& cm, serializer* sink) {
     serialize_impl(cm.handle, sink);
@@ -464,6 +456,7 @@ template<typename T>
 typename std::enable_if<
        std::is_same<T, connection_closed_msg>::value
     || std::is_same<T, acceptor_closed_msg>::value
+    || std::is_same<T, datagram_closed_msg>::value
 >::type
 deserialize_impl(T& cm, deserializer* source) {
     deserialize_impl(cm.handle, source);
@@ -771,6 +764,23 @@ void deserialize_impl(new_data_msg& ndm, deserializer* source) {
     bti.deserialize(&(ndm.buf), source);
 }
 
+void serialize_impl(const new_datagram_msg& ndm, serializer* sink) {
+    buffer_type_info_impl bti;
+    serialize_impl(ndm.handle, sink);
+    sink->write_value(ndm.remote.host());
+    sink->write_value(ndm.remote.port());
+    bti.serialize(&(ndm.buf), sink);
+}
+
+void deserialize_impl(new_datagram_msg& ndm, deserializer* source) {
+    buffer_type_info_impl bti;
+    deserialize_impl(ndm.handle, source);
+    auto host = source->read<std::string>();
+    auto port = source->read<std::uint16_t>();
+    ndm.remote = io::ip_endpoint{host, port};
+    bti.deserialize(&(ndm.buf), source);
+}
+
 template<typename T>
 void push_native_type(abstract_int_tinfo* m [][2]) {
     m[sizeof(T)][std::is_signed<T>::value ? 1 : 0]->add_native_type(typeid(T));
@@ -829,6 +839,8 @@ class utim_impl : public uniform_type_info_map {
         *i++ = &m_type_channel;             // @channel
         *i++ = &m_cn_hdl;                   // @cn_hdl
         *i++ = &m_connection_closed_msg;    // @conn_closed
+        *i++ = &m_dg_hdl;                   // @dg_hdl
+        *i++ = &m_datagram_closed_msg;      // @dgram_closed
         *i++ = &m_type_down_msg;            // @down
         *i++ = &m_type_duration;            // @duration
         *i++ = &m_type_exit_msg;            // @exit
@@ -843,6 +855,7 @@ class utim_impl : public uniform_type_info_map {
         *i++ = &m_type_message;             // @message
         *i++ = &m_new_connection_msg;       // @new_conn
         *i++ = &m_new_data_msg;             // @new_data
+        *i++ = &m_new_datagram_msg;         // @new_dgram
         *i++ = &m_type_proc;                // @proc
         *i++ = &m_type_str;                 // @str
         *i++ = &m_type_strmap;              // @strmap
@@ -893,7 +906,7 @@ class utim_impl : public uniform_type_info_map {
     }
 
     pointer by_rtti(const std::type_info& ti) const {
-        shared_lock<detail::shared_spinlock> guard(m_lock);
+        shared_lock<detail::scalable_rw_lock> guard(m_lock);
         auto res = find_rtti(m_builtin_types, ti);
         return (res) ? res : find_rtti(m_user_types, ti);
     }
@@ -901,7 +914,7 @@ class utim_impl : public uniform_type_info_map {
     pointer by_uniform_name(const std::string& name) {
         pointer result = nullptr;
         /* lifetime scope of guard */ {
-            shared_lock<detail::shared_spinlock> guard(m_lock);
+            shared_lock<detail::scalable_rw_lock> guard(m_lock);
             result = find_name(m_builtin_types, name);
             result = (result) ? result : find_name(m_user_types, name);
         }
@@ -913,7 +926,7 @@ class utim_impl : public uniform_type_info_map {
     }
 
     std::vector<pointer> get_all() const {
-        shared_lock<detail::shared_spinlock> guard(m_lock);
+        shared_lock<detail::scalable_rw_lock> guard(m_lock);
         std::vector<pointer> res;
         res.reserve(m_builtin_types.size() + m_user_types.size());
         res.insert(res.end(), m_builtin_types.begin(), m_builtin_types.end());
@@ -922,7 +935,7 @@ class utim_impl : public uniform_type_info_map {
     }
 
     pointer insert(uniform_type_info_ptr uti) {
-        unique_lock<detail::shared_spinlock> guard(m_lock);
+        unique_lock<detail::scalable_rw_lock> guard(m_lock);
         auto e = m_user_types.end();
         auto i = std::lower_bound(m_user_types.begin(), e, uti.get(),
                                   [](uniform_type_info* lhs, pointer rhs) {
@@ -1000,10 +1013,15 @@ class utim_impl : public uniform_type_info_map {
     uti_impl<connection_closed_msg>         m_connection_closed_msg;
     uti_impl<acceptor_closed_msg>           m_acceptor_closed_msg;
 
+    // 39-41
+    uti_impl<io::datagram_handle>           m_dg_hdl;
+    uti_impl<new_datagram_msg>              m_new_datagram_msg;
+    uti_impl<datagram_closed_msg>           m_datagram_closed_msg;
+
     // both containers are sorted by uniform name
-    std::array<pointer, 39> m_builtin_types;
+    std::array<pointer, 42> m_builtin_types;
     std::vector<uniform_type_info*> m_user_types;
-    mutable detail::shared_spinlock m_lock;
+    mutable detail::scalable_rw_lock m_lock;
 
     template<typename Container>
     pointer find_rtti(const Container& c, const std::type_info& ti) const {
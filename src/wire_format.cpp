@@ -0,0 +1,77 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+#include <atomic>
+
+#include "boost/actor/wire_format.hpp"
+
+namespace boost {
+namespace actor {
+
+namespace { std::atomic<wire_format> s_max_wire_format{wire_format::v2}; }
+
+void max_wire_format(wire_format value) {
+    s_max_wire_format = value;
+}
+
+wire_format max_wire_format() {
+    return s_max_wire_format;
+}
+
+constexpr size_t node_id_table::max_size;
+
+size_t node_id_table::hash::operator()(const node_id* ptr) const {
+    // FNV-1a over process ID and host ID
+    size_t result = 2166136261u;
+    auto add = [&](std::uint8_t byte) {
+        result ^= byte;
+        result *= 16777619u;
+    };
+    auto pid = ptr->process_id();
+    for (int i = 0; i < 4; ++i) add(static_cast<std::uint8_t>(pid >> (i * 8)));
+    for (auto byte : ptr->host_id()) add(byte);
+    return result;
+}
+
+std::uint32_t node_id_table::id_of(const node_id& nid) const {
+    auto i = m_ids.find(&nid);
+    return i != m_ids.end() ? i->second : 0;
+}
+
+node_id_ptr node_id_table::by_id(std::uint32_t id) const {
+    if (id == 0 || id > m_data.size()) return nullptr;
+    return m_data[id - 1];
+}
+
+std::uint32_t node_id_table::add(node_id_ptr nid) {
+    auto id = static_cast<std::uint32_t>(m_data.size() + 1);
+    if (m_data.size() < max_size) {
+        m_ids.emplace(nid.get(), id);
+        m_data.push_back(std::move(nid));
+    }
+    return id;
+}
+
+void node_id_table::shrink(size_t new_size) {
+    while (m_data.size() > new_size) {
+        m_ids.erase(m_data.back().get());
+        m_data.pop_back();
+    }
+}
+
+} // namespace actor
+} // namespace boost
@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "boost/actor/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace boost::actor;
+
+namespace {
+
+behavior pong(event_based_actor* self) {
+    return (
+        on(atom("ping"), arg_match) >> [](int value) {
+            return make_message(atom("pong"), value);
+        },
+        on(atom("done")) >> [=] {
+            self->quit();
+        }
+    );
+}
+
+void ping(event_based_actor* self, actor buddy, int num_pings) {
+    self->send(buddy, atom("ping"), 0);
+    self->become (
+        on(atom("pong"), arg_match) >> [=](int value) -> message {
+            if (value + 1 == num_pings) {
+                self->send(buddy, atom("done"));
+                self->quit();
+                return {};
+            }
+            return make_message(atom("ping"), value + 1);
+        }
+    );
+}
+
+// returns the runtime of num_pairs ping-pong pairs in milliseconds
+long long run(bool embed, int num_pairs, int num_pings) {
+    embed_mailbox_elements(embed);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < num_pairs; ++i) {
+        spawn(ping, spawn(pong), num_pings);
+    }
+    await_all_actors_done();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    using std::chrono::milliseconds;
+    return std::chrono::duration_cast<milliseconds>(t1 - t0).count();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    int num_pairs = argc > 1 ? atoi(argv[1]) : 100;
+    int num_pings = argc > 2 ? atoi(argv[2]) : 10000;
+    cout << num_pairs << " ping-pong pairs, "
+         << num_pings << " round trips each" << endl;
+    // warm up memory caches of all workers
+    run(true, num_pairs, num_pings / 10);
+    for (int i = 0; i < 3; ++i) {
+        cout << "embedded mailbox elements: "
+             << run(true, num_pairs, num_pings) << "ms" << endl;
+        cout << "separate mailbox elements: "
+             << run(false, num_pairs, num_pings) << "ms" << endl;
+    }
+    shutdown();
+}
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "boost/actor/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace boost::actor;
+
+namespace {
+
+// one case per leading atom
+#define ATOM_CASE(n)                                                           \
+    on(atom("a" #n), arg_match) >> [&sum](int x) { sum += x + n; }
+
+// one case per element type
+#define TYPE_CASE(type)                                                        \
+    on<type>() >> [&sum](type) { ++sum; }
+
+// behavior with 36 atom-keyed cases and 12 message shapes
+behavior many_cases(long& sum) {
+    return {
+        ATOM_CASE(0),  ATOM_CASE(1),  ATOM_CASE(2),  ATOM_CASE(3),
+        ATOM_CASE(4),  ATOM_CASE(5),  ATOM_CASE(6),  ATOM_CASE(7),
+        ATOM_CASE(8),  ATOM_CASE(9),  ATOM_CASE(10), ATOM_CASE(11),
+        ATOM_CASE(12), ATOM_CASE(13), ATOM_CASE(14), ATOM_CASE(15),
+        ATOM_CASE(16), ATOM_CASE(17), ATOM_CASE(18), ATOM_CASE(19),
+        ATOM_CASE(20), ATOM_CASE(21), ATOM_CASE(22), ATOM_CASE(23),
+        ATOM_CASE(24), ATOM_CASE(25), ATOM_CASE(26), ATOM_CASE(27),
+        ATOM_CASE(28), ATOM_CASE(29), ATOM_CASE(30), ATOM_CASE(31),
+        ATOM_CASE(32), ATOM_CASE(33), ATOM_CASE(34), ATOM_CASE(35),
+        TYPE_CASE(std::int8_t),   TYPE_CASE(std::int16_t),
+        TYPE_CASE(std::int32_t),  TYPE_CASE(std::int64_t),
+        TYPE_CASE(std::uint8_t),  TYPE_CASE(std::uint16_t),
+        TYPE_CASE(std::uint32_t), TYPE_CASE(std::uint64_t),
+        TYPE_CASE(float),         TYPE_CASE(double),
+        TYPE_CASE(std::string),
+        on<int, int>() >> [&sum](int, int) { ++sum; }
+    };
+}
+
+#undef ATOM_CASE
+#undef TYPE_CASE
+
+// creates a statically typed message or a dynamically typed one
+// via message_builder, as done for messages received from the network
+template<typename... Ts>
+message make(bool dynamic, Ts... xs) {
+    if (!dynamic) return make_message(xs...);
+    message_builder mb;
+    auto unused = { (mb.append(xs), 0)... };
+    static_cast<void>(unused);
+    return mb.to_message();
+}
+
+#define ATOM_MSG(n) make(dynamic, atom("a" #n), 1)
+
+// returns one message per case of many_cases
+std::vector<message> messages(bool dynamic) {
+    return {
+        ATOM_MSG(0),  ATOM_MSG(1),  ATOM_MSG(2),  ATOM_MSG(3),
+        ATOM_MSG(4),  ATOM_MSG(5),  ATOM_MSG(6),  ATOM_MSG(7),
+        ATOM_MSG(8),  ATOM_MSG(9),  ATOM_MSG(10), ATOM_MSG(11),
+        ATOM_MSG(12), ATOM_MSG(13), ATOM_MSG(14), ATOM_MSG(15),
+        ATOM_MSG(16), ATOM_MSG(17), ATOM_MSG(18), ATOM_MSG(19),
+        ATOM_MSG(20), ATOM_MSG(21), ATOM_MSG(22), ATOM_MSG(23),
+        ATOM_MSG(24), ATOM_MSG(25), ATOM_MSG(26), ATOM_MSG(27),
+        ATOM_MSG(28), ATOM_MSG(29), ATOM_MSG(30), ATOM_MSG(31),
+        ATOM_MSG(32), ATOM_MSG(33), ATOM_MSG(34), ATOM_MSG(35),
+        make(dynamic, std::int8_t{1}),   make(dynamic, std::int16_t{1}),
+        make(dynamic, std::int32_t{1}),  make(dynamic, std::int64_t{1}),
+        make(dynamic, std::uint8_t{1}),  make(dynamic, std::uint16_t{1}),
+        make(dynamic, std::uint32_t{1}), make(dynamic, std::uint64_t{1}),
+        make(dynamic, 1.f),              make(dynamic, 1.),
+        make(dynamic, std::string{"1"}), make(dynamic, 1, 2)
+    };
+}
+
+#undef ATOM_MSG
+
+// returns the average dispatch time per message in nanoseconds
+double run(bool dynamic, int num_rounds) {
+    long sum = 0;
+    auto bhvr = many_cases(sum);
+    auto msgs = messages(dynamic);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < num_rounds; ++i) {
+        for (auto& msg : msgs) bhvr(msg);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    if (sum == 0) cout << "no case matched" << endl;
+    using std::chrono::nanoseconds;
+    auto ns = std::chrono::duration_cast<nanoseconds>(t1 - t0).count();
+    return static_cast<double>(ns) / (num_rounds * msgs.size());
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    int num_rounds = argc > 1 ? atoi(argv[1]) : 100000;
+    cout << num_rounds << " rounds over 48 cases and message shapes" << endl;
+    for (int i = 0; i < 3; ++i) {
+        cout << "statically typed messages:  "
+             << run(false, num_rounds) << "ns/message" << endl;
+        cout << "dynamically typed messages: "
+             << run(true, num_rounds) << "ns/message" << endl;
+    }
+    shutdown();
+}
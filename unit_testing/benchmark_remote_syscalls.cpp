@@ -0,0 +1,191 @@
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <sstream>
+#include <iostream>
+
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include "boost/actor/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace boost::actor;
+
+// counts the system calls of this process by interposing the libc
+// functions used by the middleman (works with ELF shared libraries only)
+
+namespace {
+
+enum syscall_id { sc_send, sc_recv, sc_read, sc_write, sc_epoll_ctl,
+                  sc_epoll_wait, num_syscall_ids };
+
+const char* syscall_names[] = { "send", "recv", "read", "write",
+                                "epoll_ctl", "epoll_wait" };
+
+std::atomic<size_t> s_counts[num_syscall_ids];
+
+template<class F>
+F next_impl(const char* name) {
+    return reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+}
+
+void reset_counts() {
+    for (auto& count : s_counts) count = 0;
+}
+
+void print_counts(const char* what, size_t num_messages) {
+    std::ostringstream oss;
+    size_t total = 0;
+    for (auto& count : s_counts) total += count;
+    oss.precision(3);
+    oss << std::fixed << what << ": "
+        << static_cast<double>(total) / num_messages << " syscalls/message (";
+    for (int i = 0; i < num_syscall_ids; ++i) {
+        if (i > 0) oss << ", ";
+        oss << syscall_names[i] << " "
+            << static_cast<double>(s_counts[i]) / num_messages;
+    }
+    oss << ")";
+    cout << oss.str() << endl;
+}
+
+} // namespace <anonymous>
+
+extern "C" {
+
+ssize_t send(int fd, const void* buf, size_t len, int flags) {
+    static auto fun = next_impl<decltype(&send)>("send");
+    ++s_counts[sc_send];
+    return fun(fd, buf, len, flags);
+}
+
+ssize_t sendmsg(int fd, const msghdr* msg, int flags) {
+    static auto fun = next_impl<decltype(&sendmsg)>("sendmsg");
+    ++s_counts[sc_send];
+    return fun(fd, msg, flags);
+}
+
+ssize_t recv(int fd, void* buf, size_t len, int flags) {
+    static auto fun = next_impl<decltype(&recv)>("recv");
+    ++s_counts[sc_recv];
+    return fun(fd, buf, len, flags);
+}
+
+ssize_t read(int fd, void* buf, size_t len) {
+    static auto fun = next_impl<decltype(&read)>("read");
+    ++s_counts[sc_read];
+    return fun(fd, buf, len);
+}
+
+ssize_t write(int fd, const void* buf, size_t len) {
+    static auto fun = next_impl<decltype(&write)>("write");
+    ++s_counts[sc_write];
+    return fun(fd, buf, len);
+}
+
+int epoll_ctl(int epfd, int op, int fd, epoll_event* ev) throw() {
+    static auto fun = next_impl<decltype(&epoll_ctl)>("epoll_ctl");
+    ++s_counts[sc_epoll_ctl];
+    return fun(epfd, op, fd, ev);
+}
+
+int epoll_wait(int epfd, epoll_event* evs, int max_evs, int timeout) {
+    static auto fun = next_impl<decltype(&epoll_wait)>("epoll_wait");
+    ++s_counts[sc_epoll_wait];
+    return fun(epfd, evs, max_evs, timeout);
+}
+
+} // extern "C"
+
+namespace {
+
+behavior server(event_based_actor* self, int num_msgs) {
+    return (
+        on(atom("ping"), arg_match) >> [=](int value) {
+            if (value == 0) reset_counts();
+            else if (value == num_msgs - 1) {
+                // num_msgs requests and responses
+                print_counts("server, ping-pong", 2 * num_msgs);
+            }
+            return make_message(atom("pong"), value);
+        },
+        on(atom("begin")) >> [] {
+            reset_counts();
+            return atom("ok");
+        },
+        on(atom("push"), arg_match) >> [](int) {
+            // nop
+        },
+        on(atom("flush")) >> [=] {
+            print_counts("server, burst    ", num_msgs);
+            return atom("flushed");
+        },
+        on(atom("done")) >> [=] {
+            self->quit();
+        }
+    );
+}
+
+void run_client(std::uint16_t port, int num_msgs) {
+    auto serv = remote_actor("127.0.0.1", port);
+    scoped_actor self;
+    // request/response traffic, i.e., one message at a time
+    reset_counts();
+    for (int i = 0; i < num_msgs; ++i) {
+        self->sync_send(serv, atom("ping"), i).await(
+            on(atom("pong"), arg_match) >> [](int) { }
+        );
+    }
+    print_counts("client, ping-pong", 2 * num_msgs);
+    // asynchronous traffic, i.e., many messages at once
+    self->sync_send(serv, atom("begin")).await(
+        on(atom("ok")) >> [] { }
+    );
+    reset_counts();
+    for (int i = 0; i < num_msgs; ++i) self->send(serv, atom("push"), i);
+    self->sync_send(serv, atom("flush")).await(
+        on(atom("flushed")) >> [] { }
+    );
+    print_counts("client, burst    ", num_msgs);
+    self->send(serv, atom("done"));
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        // client mode: <app> <port> <num_msgs>
+        run_client(static_cast<std::uint16_t>(atoi(argv[1])), atoi(argv[2]));
+        shutdown();
+        return 0;
+    }
+    int num_msgs = argc > 1 ? atoi(argv[1]) : 10000;
+    cout << num_msgs << " messages per run" << endl;
+    auto serv = spawn(server, num_msgs);
+    std::uint16_t port = 4242;
+    for (;;) {
+        try {
+            publish(serv, port, "127.0.0.1");
+            break;
+        }
+        catch (bind_failure&) {
+            ++port;
+        }
+    }
+    std::ostringstream cmd;
+    cmd << argv[0] << " " << port << " " << num_msgs;
+    std::thread child{[&] {
+        if (system(cmd.str().c_str()) != 0) {
+            std::cerr << "client failed" << endl;
+            abort();
+        }
+    }};
+    await_all_actors_done();
+    child.join();
+    shutdown();
+}
@@ -0,0 +1,93 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+#include "boost/thread/locks.hpp"
+
+#include "boost/actor/detail/shared_spinlock.hpp"
+#include "boost/actor/detail/scalable_rw_lock.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace boost::actor;
+
+namespace {
+
+// protected data that readers and writers access
+struct guarded_counters {
+    long values[8];
+    guarded_counters() {
+        for (auto& v : values) v = 0;
+    }
+};
+
+// each thread performs num_ops operations, one out of
+// write_interval operations acquires the lock exclusively
+template<class Lock>
+double run(size_t num_threads, int num_ops, int write_interval) {
+    Lock mtx;
+    guarded_counters data;
+    std::atomic<bool> go{false};
+    std::atomic<long> checksum{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&] {
+            while (!go) std::this_thread::yield();
+            long sum = 0;
+            for (int j = 0; j < num_ops; ++j) {
+                if (write_interval > 0 && j % write_interval == 0) {
+                    boost::lock_guard<Lock> guard(mtx);
+                    for (auto& v : data.values) ++v;
+                }
+                else {
+                    boost::shared_lock<Lock> guard(mtx);
+                    // writers update all values at once
+                    for (auto& v : data.values) {
+                        if (v != data.values[0]) {
+                            std::cerr << "inconsistent read" << endl;
+                            abort();
+                        }
+                        sum += v;
+                    }
+                }
+            }
+            checksum += sum;
+        });
+    }
+    auto t0 = std::chrono::high_resolution_clock::now();
+    go = true;
+    for (auto& t : threads) t.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    // average wall-clock time per operation and thread
+    return static_cast<double>(ns.count()) / num_ops;
+}
+
+void run_all(size_t num_threads, int num_ops, int write_interval) {
+    cout << num_threads << " threads, ";
+    if (write_interval > 0) cout << "1/" << write_interval << " writes: ";
+    else cout << "reads only: ";
+    cout << run<detail::shared_spinlock>(num_threads, num_ops, write_interval)
+         << "ns/op (shared_spinlock), "
+         << run<detail::scalable_rw_lock>(num_threads, num_ops, write_interval)
+         << "ns/op (scalable_rw_lock)" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    int num_ops = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    if (argc > 2) max_threads = static_cast<size_t>(atoi(argv[2]));
+    cout << num_ops << " lock operations per thread" << endl;
+    for (size_t n = 1; n <= max_threads; n *= 2) {
+        for (int interval : {0, 1000, 100, 10}) {
+            run_all(n, num_ops, interval);
+        }
+    }
+}
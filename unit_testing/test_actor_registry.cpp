@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "test.hpp"
+
+#include "boost/actor/all.hpp"
+#include "boost/actor/singletons.hpp"
+#include "boost/actor/detail/raw_access.hpp"
+#include "boost/actor/detail/actor_registry.hpp"
+
+using namespace boost::actor;
+
+using detail::actor_registry;
+
+namespace {
+
+abstract_actor_ptr ptr_of(const actor& whom) {
+    return detail::raw_access::get(whom);
+}
+
+actor spawn_waiting(std::uint32_t reason) {
+    return spawn([=](event_based_actor* self) {
+        self->become(
+            on(atom("done")) >> [=] {
+                self->quit(reason);
+            }
+        );
+    });
+}
+
+void test_lifecycle() {
+    auto reg = get_actor_registry();
+    scoped_actor self;
+    auto a = spawn_waiting(exit_reason::user_defined);
+    reg->put(a->id(), ptr_of(a));
+    // putting an actor twice is a no-op
+    reg->put(a->id(), ptr_of(a));
+    auto entry = reg->get_entry(a->id());
+    BOOST_ACTOR_CHECK(entry.first == ptr_of(a));
+    BOOST_ACTOR_CHECK_EQUAL(entry.second, exit_reason::not_exited);
+    // the registry has attached itself first, i.e., it
+    // has seen the exit once our DOWN message arrives
+    self->monitor(a);
+    self->send(a, atom("done"));
+    self->receive(on_arg_match >> [](const down_msg&) { });
+    entry = reg->get_entry(a->id());
+    BOOST_ACTOR_CHECK(entry.first == nullptr);
+    BOOST_ACTOR_CHECK_EQUAL(entry.second, exit_reason::user_defined);
+    // unknown IDs
+    entry = reg->get_entry(reg->next_id());
+    BOOST_ACTOR_CHECK(entry.first == nullptr);
+    BOOST_ACTOR_CHECK_EQUAL(entry.second, exit_reason::not_exited);
+}
+
+void test_tombstone_reclamation() {
+    auto reg = get_actor_registry();
+    scoped_actor self;
+    // enough actors to fill both tombstone generations of each shard
+    auto num = 2 * actor_registry::num_shards * actor_registry::max_tombstones
+             + actor_registry::num_shards;
+    std::vector<actor> actors;
+    actors.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        actors.push_back(spawn_waiting(exit_reason::normal));
+        reg->put(actors.back()->id(), ptr_of(actors.back()));
+        self->monitor(actors.back());
+    }
+    std::vector<actor_id> ids;
+    ids.reserve(num);
+    for (auto& a : actors) {
+        ids.push_back(a->id());
+        self->send(a, atom("done"));
+    }
+    actors.clear();
+    for (size_t i = 0; i < num; ++i) {
+        self->receive(on_arg_match >> [](const down_msg&) { });
+    }
+    // the oldest tombstones are gone, the latest ones are still known
+    size_t forgotten = 0;
+    size_t alive = 0;
+    for (auto id : ids) {
+        auto entry = reg->get_entry(id);
+        if (entry.first) ++alive;
+        if (entry.second == exit_reason::not_exited) ++forgotten;
+    }
+    BOOST_ACTOR_CHECK_EQUAL(alive, 0);
+    BOOST_ACTOR_CHECK(forgotten > 0);
+    BOOST_ACTOR_CHECK(forgotten <= num - actor_registry::num_shards
+                                        * actor_registry::max_tombstones);
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_actor_registry);
+    test_lifecycle();
+    test_tombstone_reclamation();
+    await_all_actors_done();
+    shutdown();
+    return BOOST_ACTOR_TEST_RESULT();
+}
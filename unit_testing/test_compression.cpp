@@ -0,0 +1,111 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "boost/actor/io/compression.hpp"
+
+using namespace boost::actor;
+
+using io::compression;
+
+namespace {
+
+void test_algorithm(compression algorithm) {
+    BOOST_ACTOR_PRINT("test algorithm " << static_cast<int>(algorithm));
+    std::string input;
+    for (int i = 0; i < 1000; ++i) input += "highly redundant payload ";
+    std::vector<io::compression_event> events;
+    io::set_compression_hook([&](const io::compression_event& ev) {
+        events.push_back(ev);
+    });
+    std::vector<char> compressed;
+    BOOST_ACTOR_CHECK(io::compress(algorithm, input.data(), input.size(),
+                                   compressed));
+    BOOST_ACTOR_CHECK(compressed.size() < input.size() / 10);
+    std::string output(input.size(), '\0');
+    BOOST_ACTOR_CHECK(io::decompress(algorithm, compressed.data(),
+                                     compressed.size(), &output[0],
+                                     output.size()));
+    BOOST_ACTOR_CHECK(input == output);
+    // corrupted input is detected rather than producing garbage
+    std::string short_output(input.size() / 2, '\0');
+    BOOST_ACTOR_CHECK(!io::decompress(algorithm, compressed.data(),
+                                      compressed.size(), &short_output[0],
+                                      short_output.size()));
+    // incompressible data is rejected
+    std::vector<char> tmp;
+    BOOST_ACTOR_CHECK(!io::compress(algorithm, "abc", 3, tmp));
+    io::set_compression_hook(nullptr);
+    BOOST_ACTOR_CHECK(events.size() >= 2);
+    if (events.size() >= 2) {
+        BOOST_ACTOR_CHECK(!events[0].decompressed);
+        BOOST_ACTOR_CHECK(events[1].decompressed);
+        BOOST_ACTOR_CHECK_EQUAL(events[0].original_size, input.size());
+        BOOST_ACTOR_CHECK_EQUAL(events[0].compressed_size, compressed.size());
+        BOOST_ACTOR_CHECK(events[0].ratio() > 10.);
+    }
+}
+
+// replaces the hook while other threads report events
+void test_concurrent_hook(compression algorithm) {
+    std::string input;
+    for (int i = 0; i < 100; ++i) input += "highly redundant payload ";
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            std::vector<char> buf;
+            while (!done) {
+                io::compress(algorithm, input.data(), input.size(), buf);
+            }
+        });
+    }
+    for (int i = 0; i < 1000; ++i) {
+        io::set_compression_hook([](const io::compression_event&) { });
+        io::set_compression_hook(nullptr);
+    }
+    io::set_compression_hook([&](const io::compression_event&) {
+        done = true;
+    });
+    for (auto& t : threads) t.join();
+    io::set_compression_hook(nullptr);
+    BOOST_ACTOR_CHECKPOINT();
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_compression);
+    auto available = io::available_compressions();
+    for (auto algorithm : {compression::lz4, compression::zlib}) {
+        if (available & static_cast<std::uint32_t>(algorithm)) {
+            test_algorithm(algorithm);
+            test_concurrent_hook(algorithm);
+        }
+    }
+    BOOST_ACTOR_CHECK(io::compression_algorithm() == compression::none);
+    std::vector<char> tmp;
+    BOOST_ACTOR_CHECK(!io::compress(compression::none, "abc", 3, tmp));
+    return BOOST_ACTOR_TEST_RESULT();
+}
@@ -0,0 +1,235 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+#include <ios>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "test.hpp"
+
+#include "boost/actor/all.hpp"
+
+#include "boost/actor/io/fd_util.hpp"
+#include "boost/actor/io/continuable.hpp"
+#include "boost/actor/io/tcp_acceptor.hpp"
+#include "boost/actor/io/tcp_io_stream.hpp"
+#include "boost/actor/io/middleman_event_handler.hpp"
+
+using namespace boost::actor;
+using namespace boost::actor::io;
+
+namespace {
+
+class dummy : public continuable {
+
+ public:
+
+    dummy(native_socket_type fd, std::vector<dummy*>& disposed)
+    : continuable(fd, fd), write_result(continue_writing_result::done)
+    , m_disposed(disposed) { }
+
+    continue_writing_result continue_writing() override {
+        return write_result;
+    }
+
+    void dispose() override {
+        m_disposed.push_back(this);
+    }
+
+    void io_failed(event_bitmask) override {
+        // nop
+    }
+
+    continue_writing_result write_result;
+
+ private:
+
+    std::vector<dummy*>& m_disposed;
+
+};
+
+void test_meta_table() {
+    auto handler = middleman_event_handler::create();
+    handler->init();
+    std::vector<std::pair<native_socket_type, native_socket_type>> pipes;
+    for (int i = 0; i < 3; ++i) pipes.push_back(fd_util::create_pipe());
+    std::vector<dummy*> disposed;
+    dummy d0{pipes[0].first, disposed};
+    dummy d1{pipes[1].first, disposed};
+    dummy d2{pipes[2].first, disposed};
+    for (auto d : {&d0, &d1, &d2}) handler->add_later(d, event::read);
+    handler->update();
+    BOOST_ACTOR_CHECK_EQUAL(handler->num_sockets(), 3);
+    BOOST_ACTOR_CHECK(handler->has_reader(&d0) && !handler->has_writer(&d0));
+    // erasing the first entry moves the last one
+    handler->erase_later(&d0, event::read);
+    handler->update();
+    BOOST_ACTOR_CHECK((disposed == std::vector<dummy*>{&d0}));
+    BOOST_ACTOR_CHECK_EQUAL(handler->num_sockets(), 2);
+    BOOST_ACTOR_CHECK(!handler->has_reader(&d0));
+    BOOST_ACTOR_CHECK(handler->has_reader(&d1) && handler->has_reader(&d2));
+    // erasing a continuable that isn't registered is a nop
+    handler->erase_later(&d0, event::read);
+    handler->update();
+    BOOST_ACTOR_CHECK_EQUAL(handler->num_sockets(), 2);
+    // a continuable put back by a later alteration is not disposed
+    handler->erase_later(&d2, event::read);
+    handler->add_later(&d2, event::read);
+    handler->update();
+    BOOST_ACTOR_CHECK_EQUAL(disposed.size(), 1);
+    BOOST_ACTOR_CHECK(handler->has_reader(&d2));
+    // events are reported for the correct continuable
+    fd_util::nonblocking(pipes[2].first, true);
+    char c = 'x';
+    BOOST_ACTOR_CHECK_EQUAL(::write(pipes[2].second, &c, 1), 1);
+    std::vector<continuable*> readable;
+    handler->poll([&](event_bitmask mask, continuable* ptr) {
+        if (mask == event::read) readable.push_back(ptr);
+    });
+    BOOST_ACTOR_CHECK((readable == std::vector<continuable*>{&d2}));
+    // writers are registered only if they could not write everything
+    handler->flush_later(&d1);
+    handler->update();
+    BOOST_ACTOR_CHECK(!handler->has_writer(&d1));
+    d1.write_result = continue_writing_result::continue_later;
+    handler->flush_later(&d1);
+    handler->update();
+    BOOST_ACTOR_CHECK(handler->has_writer(&d1) && handler->has_reader(&d1));
+    for (auto& p : pipes) {
+        closesocket(p.first);
+        closesocket(p.second);
+    }
+}
+
+// writing to a connection closed by the remote side fails
+// with EPIPE instead of raising SIGPIPE, which would kill us
+void test_write_to_closed_connection() {
+    auto acceptor = tcp_acceptor::create(0, "127.0.0.1");
+    auto port = static_cast<tcp_acceptor*>(acceptor.get())->port();
+    auto io = tcp_io_stream::connect_to("127.0.0.1", port);
+    acceptor->accept_connection();
+    std::vector<char> buf(1024);
+    bool failed = false;
+    for (int i = 0; i < 100 && !failed; ++i) {
+        try { io->write(buf.data(), buf.size()); }
+        catch (std::ios_base::failure&) { failed = true; }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_ACTOR_CHECK(failed);
+}
+
+// connections closed before sending their process info leave
+// the middleman with a peer that does not know its node yet
+void test_closed_during_handshake(std::uint16_t port, actor_id expected) {
+    for (int i = 0; i < 8; ++i) {
+        tcp_io_stream::connect_to("127.0.0.1", port);
+    }
+    // the middleman survives disposing these peers
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto io = tcp_io_stream::connect_to("127.0.0.1", port);
+    actor_id aid;
+    io->read(&aid, sizeof(actor_id));
+    BOOST_ACTOR_CHECK_EQUAL(aid, expected);
+}
+
+// returns whether the remote side closes io within 500ms
+bool closed_by_remote(const stream_ptr& io) {
+    auto deadline = std::chrono::steady_clock::now()
+                    + std::chrono::milliseconds(500);
+    char buf[1024];
+    while (std::chrono::steady_clock::now() < deadline) {
+        try { io->read_some(buf, sizeof(buf)); }
+        catch (std::ios_base::failure&) { return true; }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+// a node closing its connection right after the handshake must be
+// unregistered, because it is rejected as duplicate otherwise once it
+// connects again; with edge-triggered I/O, the peer notices the closed
+// connection only if it reads again after processing the handshake
+void test_closed_after_handshake(std::uint16_t port) {
+    // use a node ID no other test uses
+    std::uint32_t pid = 42;
+    node_id::host_id_type host_id;
+    host_id.fill(0x42);
+    auto send_handshake = [&](const stream_ptr& io) {
+        io->write(&pid, sizeof(pid));
+        io->write(host_id.data(), host_id.size());
+    };
+    // shutting down only the sending side delivers the FIN along with the
+    // handshake, whereas closing with unread data would reset the connection
+    auto first = tcp_io_stream::connect_to("127.0.0.1", port);
+    send_handshake(first);
+    shutdown(first->write_handle(), SHUT_WR);
+    BOOST_ACTOR_CHECK(closed_by_remote(first));
+    auto second = tcp_io_stream::connect_to("127.0.0.1", port);
+    send_handshake(second);
+    BOOST_ACTOR_CHECK(!closed_by_remote(second));
+}
+
+void test_sharded_publish() {
+    auto testee = spawn([](event_based_actor* self) {
+        self->become(others() >> [] { });
+    });
+    std::uint16_t port = 4242;
+    for (;;) {
+        try {
+            publish(testee, port, "127.0.0.1");
+            break;
+        }
+        catch (bind_failure&) {
+            ++port;
+        }
+    }
+    BOOST_ACTOR_CHECKPOINT();
+    // the sharded acceptors do not allow others to bind to their port
+    bool bound = true;
+    try { tcp_acceptor::create(port, "127.0.0.1"); }
+    catch (bind_failure&) { bound = false; }
+    BOOST_ACTOR_CHECK(!bound);
+    // each connection gets the handshake from one of the acceptors
+    for (int i = 0; i < 8; ++i) {
+        auto io = tcp_io_stream::connect_to("127.0.0.1", port);
+        actor_id aid;
+        io->read(&aid, sizeof(actor_id));
+        BOOST_ACTOR_CHECK_EQUAL(aid, testee->id());
+    }
+    test_closed_during_handshake(port, testee->id());
+    test_closed_after_handshake(port);
+    anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_event_handler);
+    test_meta_table();
+    test_write_to_closed_connection();
+    BOOST_ACTOR_CHECKPOINT();
+    scheduler::configuration cfg;
+    cfg.num_middleman_loops = 2;
+    cfg.edge_triggered_io = true;
+    cfg.shard_acceptors = true;
+    scheduler::set_configuration(cfg);
+    test_sharded_publish();
+    await_all_actors_done();
+    shutdown();
+    return BOOST_ACTOR_TEST_RESULT();
+}
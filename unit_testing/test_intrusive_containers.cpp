@@ -70,5 +70,30 @@ int main() {
     x = q.try_pop();
     BOOST_ACTOR_CHECK(x == nullptr);
 
+    q.enqueue(new iint(4));
+    q.enqueue(new iint(5));
+    q.enqueue(new iint(6));
+    x = q.try_pop();
+    BOOST_ACTOR_CHECK_EQUAL(x->value, 4);
+    delete x;
+    q.enqueue(new iint(7));
+
+    boost::actor::detail::intrusive_list<iint> l;
+    BOOST_ACTOR_CHECK_EQUAL(q.take_all(l), 3);
+    BOOST_ACTOR_CHECK(q.try_pop() == nullptr);
+    for (int i = 5; i <= 7; ++i) {
+        x = l.pop_front();
+        BOOST_ACTOR_CHECK(x != nullptr && x->value == i);
+        delete x;
+    }
+    BOOST_ACTOR_CHECK(l.empty());
+
+    q.enqueue(new iint(8));
+    BOOST_ACTOR_CHECK_EQUAL(q.take_all(l), 1);
+    BOOST_ACTOR_CHECK_EQUAL(q.take_all(l), 0);
+    BOOST_ACTOR_CHECK_EQUAL(s_iint_instances, 1);
+    l.clear();
+    BOOST_ACTOR_CHECK_EQUAL(s_iint_instances, 0);
+
     return BOOST_ACTOR_TEST_RESULT();
 }
@@ -35,8 +35,60 @@ void testee(event_based_actor* self, int current_value, int final_result) {
     );
 }
 
+// each subscriber reports the first value it receives and quits
+void test_fan_out(size_t num_subscribers) {
+    scoped_actor self;
+    actor master = self;
+    auto grp = group::anonymous();
+    for (size_t i = 0; i < num_subscribers; ++i) {
+        spawn_in_group(grp, [=](event_based_actor* s) {
+            s->become(
+                on_arg_match >> [=](int value) {
+                    s->send(master, value);
+                    s->quit();
+                }
+            );
+        });
+    }
+    // a late subscriber that leaves before the message is sent
+    auto late = spawn([=](event_based_actor* s) {
+        s->join(grp);
+        s->become(
+            on(atom("leave")) >> [=] {
+                s->leave(grp);
+                return atom("left");
+            },
+            on_arg_match >> [=](int) {
+                BOOST_ACTOR_FAILURE("late subscriber received a message");
+            }
+        );
+    });
+    self->sync_send(late, atom("leave")).await(
+        on(atom("left")) >> [] { }
+    );
+    self->send(grp, 42);
+    size_t received = 0;
+    self->receive_for(received, num_subscribers) (
+        on_arg_match >> [&](int value) {
+            BOOST_ACTOR_CHECK_EQUAL(value, 42);
+        }
+    );
+    self->send_exit(late, exit_reason::user_shutdown);
+}
+
 int main() {
     BOOST_ACTOR_TEST(test_local_group);
+    scheduler::configuration cfg;
+    cfg.num_workers = 4;
+    scheduler::set_configuration(cfg);
+    test_fan_out(100);
+    BOOST_ACTOR_CHECKPOINT();
+    parallel_fan_out_threshold(16);
+    test_fan_out(100);
+    test_fan_out(10);
+    BOOST_ACTOR_CHECKPOINT();
+    await_all_actors_done();
+    shutdown();
     /*
     auto foo_group = group::get("local", "foo");
     auto master = spawn_in_group(foo_group, testee, 0, 10);
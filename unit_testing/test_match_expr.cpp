@@ -1,3 +1,7 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "test.hpp"
 
 #include "boost/variant.hpp"
@@ -202,5 +206,104 @@ int main() {
         BOOST_ACTOR_CHECK_OPT_MSG(m5(make_message(1.f)), float, 2.f);
     }
 
+    { // --- dispatching by leading atoms ---
+        auto m6 = (
+            on(atom("add"), arg_match) >> [](int a, int b) { return a + b; },
+            on(atom("sub"), arg_match) >> [](int a, int b) { return a - b; },
+            on(atom("get")) >> [] { return 42; },
+            on<atom_value, int, int>() >> [](atom_value, int, int) {
+                return -1;
+            },
+            on<int>() >> [](int i) { return i; }
+        );
+        // run twice to check cached and uncached dispatch
+        for (int i = 0; i < 2; ++i) {
+            BOOST_ACTOR_CHECK_VARIANT(m6(make_message(atom("add"), 1, 2)),
+                                      int, 3);
+            BOOST_ACTOR_CHECK_VARIANT(m6(make_message(atom("sub"), 1, 2)),
+                                      int, -1);
+            BOOST_ACTOR_CHECK_VARIANT(m6(make_message(atom("mul"), 1, 2)),
+                                      int, -1);
+            BOOST_ACTOR_CHECK_VARIANT(m6(make_message(atom("get"))), int, 42);
+            BOOST_ACTOR_CHECK_VARIANT(m6(make_message(7)), int, 7);
+            auto res = m6(make_message(atom("put")));
+            BOOST_ACTOR_CHECK(get<none_t>(&res) != nullptr);
+            // dynamically typed messages
+            auto dm0 = message_builder{}.append(atom("add"))
+                                        .append(2).append(3).to_message();
+            BOOST_ACTOR_CHECK(dm0.dynamically_typed());
+            BOOST_ACTOR_CHECK_VARIANT(m6(dm0), int, 5);
+            auto dm1 = message_builder{}.append(8).to_message();
+            BOOST_ACTOR_CHECK_VARIANT(m6(dm1), int, 8);
+        }
+    }
+
+    { // --- atom cases, typed cases and catch-all cases keep their order ---
+        auto m7 = (
+            on(atom("a"), arg_match) >> [](int) { return 1; },
+            on<atom_value, int>() >> [](atom_value, int) { return 2; },
+            on(atom("b"), arg_match) >> [](int) { return 3; },
+            others() >> [] { return 4; },
+            on(atom("c")) >> [] { return 5; }
+        );
+        for (int i = 0; i < 2; ++i) {
+            BOOST_ACTOR_CHECK_VARIANT(m7(make_message(atom("a"), 0)), int, 1);
+            BOOST_ACTOR_CHECK_VARIANT(m7(make_message(atom("b"), 0)), int, 2);
+            BOOST_ACTOR_CHECK_VARIANT(m7(make_message(atom("a"), 0.)), int, 4);
+            BOOST_ACTOR_CHECK_VARIANT(m7(make_message(atom("c"))), int, 4);
+            BOOST_ACTOR_CHECK_VARIANT(m7(make_message(1)), int, 4);
+        }
+    }
+
+    { // --- more than 32 cases ---
+#       define CASE(n) on(atom("c" #n)) >> [] { return n; }
+        behavior m8 {
+            CASE(0),  CASE(1),  CASE(2),  CASE(3),  CASE(4),  CASE(5),
+            CASE(6),  CASE(7),  CASE(8),  CASE(9),  CASE(10), CASE(11),
+            CASE(12), CASE(13), CASE(14), CASE(15), CASE(16), CASE(17),
+            CASE(18), CASE(19), CASE(20), CASE(21), CASE(22), CASE(23),
+            CASE(24), CASE(25), CASE(26), CASE(27), CASE(28), CASE(29),
+            CASE(30), CASE(31), CASE(32), CASE(33), CASE(34), CASE(35),
+            on<int>() >> [](int i) { return i; }
+        };
+#       undef CASE
+        BOOST_ACTOR_CHECK_OPT_MSG(m8(make_message(atom("c2"))), int, 2);
+        BOOST_ACTOR_CHECK_OPT_MSG(m8(make_message(atom("c33"))), int, 33);
+        BOOST_ACTOR_CHECK_OPT_MSG(m8(make_message(atom("c35"))), int, 35);
+        BOOST_ACTOR_CHECK_OPT_MSG(m8(make_message(36)), int, 36);
+        BOOST_ACTOR_CHECK_OPT_MSG_NONE(m8(make_message(atom("c36"))));
+    }
+
+    { // --- threads sharing a behavior while its dispatch table grows ---
+        behavior m9 {
+            on<int>() >> [](int i) { return i; },
+            others() >> [] { return -1; }
+        };
+        std::vector<message> msgs;
+        for (int i = 0; i < 64; ++i) {
+            message_builder mb;
+            for (int j = 0; j <= i; ++j) mb.append(j);
+            msgs.push_back(mb.to_message());
+        }
+        std::atomic<int> errors{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int round = 0; round < 100; ++round) {
+                    for (size_t i = 0; i < msgs.size(); ++i) {
+                        auto res = m9(msgs[i]);
+                        auto expected = i == 0 ? 0 : -1;
+                        if (   !res || res->type_at(0) != uniform_typeid<int>()
+                            || res->get_as<int>(0) != expected) {
+                            ++errors;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        BOOST_ACTOR_CHECK_EQUAL(errors.load(), 0);
+    }
+
     return BOOST_ACTOR_TEST_RESULT();
 }
@@ -0,0 +1,137 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+#include <unistd.h>
+
+#include "test.hpp"
+#include "boost/actor/all.hpp"
+
+using namespace std;
+using namespace boost::actor;
+
+namespace {
+
+constexpr size_t num_loops = 4;
+
+constexpr int num_messages = 100;
+
+// connects to the parent after it has queued messages for us and
+// checks whether all of them arrive in the order they were sent
+int run_child(uint16_t port) {
+    { // lifetime scope of self
+        scoped_actor self;
+        // actors are added to the registry once their address gets
+        // serialized, but the parent addresses us before we send anything
+        get_actor_registry()->put(self->id(), self.get());
+        cout << getpid() << " " << self->id() << endl;
+        // give the parent time to send before the handshake
+        this_thread::sleep_for(chrono::milliseconds(200));
+        auto parent = remote_actor("localhost", port);
+        self->send(parent, atom("hello"));
+        int expected = 0;
+        int out_of_order = 0;
+        bool timed_out = false;
+        self->receive_while([&] { return !timed_out
+                                         && expected < 2 * num_messages; }) (
+            on_arg_match >> [&](int value) {
+                if (value != expected) {
+                    BOOST_ACTOR_PRINTERR("expected " << expected
+                                         << ", received " << value);
+                    ++out_of_order;
+                }
+                expected = value + 1;
+            },
+            after(chrono::seconds(10)) >> [&] {
+                BOOST_ACTOR_FAILURE("timeout, received " << expected
+                                    << " of " << (2 * num_messages)
+                                    << " messages");
+                timed_out = true;
+            }
+        );
+        BOOST_ACTOR_CHECK_EQUAL(out_of_order, 0);
+    }
+    await_all_actors_done();
+    shutdown();
+    return BOOST_ACTOR_TEST_RESULT();
+}
+
+void run_parent(scoped_actor& self, const string& app_path, uint16_t port) {
+    ostringstream oss;
+    oss << app_path << " run=child port=" << port;
+    auto cmd = oss.str();
+    auto child = popen(cmd.c_str(), "r");
+    if (child == nullptr) {
+        BOOST_ACTOR_PRINTERR("FATAL: command \"" << cmd << "\" failed!");
+        abort();
+    }
+    unsigned long pid = 0;
+    actor_id aid = 0;
+    if (fscanf(child, "%lu %u", &pid, &aid) != 2) {
+        BOOST_ACTOR_PRINTERR("FATAL: cannot read node info from child");
+        abort();
+    }
+    // the child runs on the same host
+    node_id_ptr nid{new node_id(static_cast<uint32_t>(pid),
+                                self->node().host_id())};
+    actor dest = get_middleman()->get_namespace().get_or_put(nid, aid);
+    for (int i = 0; i < num_messages; ++i) self->send(dest, i);
+    self->receive(
+        on(atom("hello")) >> BOOST_ACTOR_CHECKPOINT_CB(),
+        after(chrono::seconds(10)) >> [] {
+            BOOST_ACTOR_FAILURE("child did not connect");
+        }
+    );
+    for (int i = num_messages; i < 2 * num_messages; ++i) {
+        self->send(dest, i);
+    }
+    // forward remaining output and wait for the child
+    char buf[256];
+    while (fgets(buf, sizeof(buf), child) != nullptr) cout << buf;
+    BOOST_ACTOR_CHECK_EQUAL(pclose(child), 0);
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        auto kvp = get_kv_pairs(argc, argv);
+        if (kvp["run"] == "child") {
+            return run_child(static_cast<uint16_t>(stoi(kvp["port"])));
+        }
+        throw std::invalid_argument("unknown command line arguments");
+    }
+    BOOST_ACTOR_TEST(test_middleman_loops);
+    scheduler::configuration cfg;
+    cfg.num_middleman_loops = num_loops;
+    scheduler::set_configuration(cfg);
+    { // lifetime scope of self
+        scoped_actor self;
+        // publishing at num_loops ports distributes the acceptors
+        // to all event loops, one acceptor per loop
+        vector<uint16_t> ports;
+        uint16_t port = 4242;
+        while (ports.size() < num_loops) {
+            try {
+                publish(self, port, "127.0.0.1");
+                ports.push_back(port);
+            }
+            catch (bind_failure&) {
+                // try next port
+            }
+            ++port;
+        }
+        // each child connects via another acceptor, i.e., some children
+        // connect to a loop other than the one selected by the hash value
+        // of their node ID and the messages queued there need a handoff
+        for (auto p : ports) run_parent(self, argv[0], p);
+    }
+    await_all_actors_done();
+    shutdown();
+    return BOOST_ACTOR_TEST_RESULT();
+}
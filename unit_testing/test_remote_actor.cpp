@@ -22,6 +22,10 @@ typedef std::pair<std::string, std::string> string_pair;
 
 typedef vector<actor> actor_vector;
 
+// exceeds the send and receive buffers of a loopback connection, i.e.,
+// the peer cannot write all fragments before it picks up the next message
+constexpr size_t bulk_size = 4 * 1024 * 1024;
+
 void reflector(event_based_actor* self) {
     self->become (
         others() >> [=] {
@@ -182,6 +186,18 @@ class client : public event_based_actor {
         BOOST_ACTOR_PRINT("sync send {'SyncMsg', 4.2fSyncMsg}");
         sync_send(m_server, atom("SyncMsg"), 4.2f).then(
             on(atom("SyncReply")) >> [=] {
+                send_bulk_msg();
+            }
+        );
+    }
+
+    void send_bulk_msg() {
+        BOOST_ACTOR_PRINT("send {'Bulk', ...} and high priority {'Urgent'}");
+        // exceeds io::fragment_size() and thus is sent in fragments,
+        // which the high priority message overtakes
+        send(m_server, atom("Bulk"), string(bulk_size, 'x'));
+        sync_send(message_priority::high, m_server, atom("Urgent")).then(
+            on(atom("Urgent")) >> [=] {
                 send_foobars();
             }
         );
@@ -273,12 +289,32 @@ class server : public event_based_actor {
             on(atom("SyncMsg"), arg_match) >> [=](float f) -> atom_value {
                 BOOST_ACTOR_PRINT("received {'SyncMsg', " << f << "}");
                 BOOST_ACTOR_CHECK_EQUAL(f, 4.2f);
-                await_foobars();
+                await_bulk_msg();
                 return atom("SyncReply");
             }
         );
     }
 
+    void await_bulk_msg() {
+        BOOST_ACTOR_PRINT("await {'Urgent'} and {'Bulk', ...}");
+        // the high priority message is sent after Bulk,
+        // but must not wait for all of its fragments
+        auto received = make_shared<int>(0);
+        become (
+            on(atom("Bulk"), arg_match) >> [=](const string& str) {
+                BOOST_ACTOR_CHECK(str == string(bulk_size, 'x'));
+                if (*received == 0) {
+                    BOOST_ACTOR_FAILURE("Bulk arrived before Urgent");
+                }
+                if (++*received == 2) await_foobars();
+            },
+            on(atom("Urgent")) >> [=]() -> atom_value {
+                if (++*received == 2) await_foobars();
+                return atom("Urgent");
+            }
+        );
+    }
+
     void await_foobars() {
         BOOST_ACTOR_PRINT("await foobars");
         auto foobars = make_shared<int>(0);
@@ -357,6 +393,24 @@ int main(int argc, char** argv) {
                     auto server3 = remote_actor(localhost, port);
                     BOOST_ACTOR_CHECK(serv == server3);
                 }
+                // the non-blocking version must yield the same proxy
+                remote_actor(self, "localhost", port);
+                self->receive (
+                    on(atom("CONNECTED"), "localhost", port, arg_match)
+                    >> [&](const actor& server4) {
+                        BOOST_ACTOR_CHECK(serv == server4);
+                    },
+                    others() >> BOOST_ACTOR_UNEXPECTED_MSG_CB_REF(self)
+                );
+                // nothing is listening on port 1 (or at least not us)
+                remote_actor(self, "127.0.0.1", 1, std::chrono::seconds(5));
+                self->receive (
+                    on(atom("CONN_ERROR"), "127.0.0.1", uint16_t{1},
+                       arg_match) >> [&](const string& what) {
+                        BOOST_ACTOR_PRINT("CONN_ERROR: " << what);
+                    },
+                    others() >> BOOST_ACTOR_UNEXPECTED_MSG_CB_REF(self)
+                );
                 auto c = self->spawn<client, monitored>(serv);
                 self->receive (
                     on_arg_match >> [&](const down_msg& dm) {
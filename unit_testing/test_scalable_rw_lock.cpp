@@ -0,0 +1,141 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "boost/actor/detail/scalable_rw_lock.hpp"
+
+using namespace boost::actor;
+
+using detail::scalable_rw_lock;
+
+namespace {
+
+constexpr int num_threads = 4;
+
+constexpr int num_iterations = 10000;
+
+void test_num_slots() {
+    auto n = scalable_rw_lock::num_slots();
+    BOOST_ACTOR_CHECK(n > 0 && (n & (n - 1)) == 0);
+    BOOST_ACTOR_CHECK(n >= std::thread::hardware_concurrency());
+}
+
+void test_try_lock() {
+    scalable_rw_lock mtx;
+    mtx.lock_shared();
+    BOOST_ACTOR_CHECK(!mtx.try_lock());
+    BOOST_ACTOR_CHECK(mtx.try_lock_shared());
+    mtx.unlock_shared();
+    mtx.unlock_shared();
+    BOOST_ACTOR_CHECK(mtx.try_lock());
+    BOOST_ACTOR_CHECK(!mtx.try_lock_shared());
+    mtx.unlock();
+    // an upgrader coexists with readers
+    mtx.lock_upgrade();
+    BOOST_ACTOR_CHECK(mtx.try_lock_shared());
+    BOOST_ACTOR_CHECK(!mtx.try_lock());
+    mtx.unlock_shared();
+    mtx.unlock_upgrade_and_lock();
+    BOOST_ACTOR_CHECK(!mtx.try_lock_shared());
+    mtx.unlock();
+}
+
+// readers must never observe a writer in its critical section
+// and writers must never observe anyone else in theirs
+void test_writer_exclusion() {
+    scalable_rw_lock mtx;
+    std::atomic<int> readers{0};
+    std::atomic<int> writers{0};
+    std::atomic<int> errors{0};
+    // written by writers only, a != b indicates a torn update
+    long a = 0;
+    long b = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < num_iterations; ++i) {
+                // each thread writes every 8th iteration
+                if ((i + t) % 8 == 0) {
+                    mtx.lock();
+                    if (writers.fetch_add(1) != 0 || readers.load() != 0) {
+                        ++errors;
+                    }
+                    ++a;
+                    ++b;
+                    writers.fetch_sub(1);
+                    mtx.unlock();
+                }
+                else {
+                    mtx.lock_shared();
+                    readers.fetch_add(1);
+                    if (writers.load() != 0 || a != b) ++errors;
+                    readers.fetch_sub(1);
+                    mtx.unlock_shared();
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    BOOST_ACTOR_CHECK_EQUAL(errors.load(), 0);
+    BOOST_ACTOR_CHECK_EQUAL(a, num_threads * num_iterations / 8);
+    BOOST_ACTOR_CHECK_EQUAL(a, b);
+}
+
+// readers hold the lock at the same time, i.e., each reader waits
+// inside its critical section until all others have entered theirs
+void test_reader_concurrency() {
+    scalable_rw_lock mtx;
+    std::atomic<int> inside{0};
+    std::atomic<int> timeouts{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            mtx.lock_shared();
+            ++inside;
+            auto deadline = std::chrono::steady_clock::now()
+                            + std::chrono::seconds(5);
+            while (inside.load() < num_threads) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    ++timeouts;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            mtx.unlock_shared();
+        });
+    }
+    for (auto& th : threads) th.join();
+    BOOST_ACTOR_CHECK_EQUAL(timeouts.load(), 0);
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_scalable_rw_lock);
+    test_num_slots();
+    test_try_lock();
+    test_writer_exclusion();
+    test_reader_concurrency();
+    return BOOST_ACTOR_TEST_RESULT();
+}
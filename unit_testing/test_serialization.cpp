@@ -29,6 +29,7 @@
 #include "boost/actor/message.hpp"
 #include "boost/actor/to_string.hpp"
 #include "boost/actor/serializer.hpp"
+#include "boost/actor/wire_format.hpp"
 #include "boost/actor/from_string.hpp"
 #include "boost/actor/ref_counted.hpp"
 #include "boost/actor/deserializer.hpp"
@@ -111,12 +112,86 @@ void test_ieee_754() {
 
 enum class test_enum { a, b, c };
 
+void test_wire_format_v2(actor_namespace& addressing) {
+    auto msg = make_message(int32_t{-1}, uint64_t{1} << 40, int16_t{-300},
+                            atom("KILL_PROXY"), atom("a"), string{"foo"},
+                            3.5, vector<uint32_t>{1, 2, 300});
+    auto node = get_middleman()->node();
+    io::buffer v1_buf;
+    binary_serializer bs1(&v1_buf, &addressing);
+    bs1 << msg;
+    io::buffer wr_buf;
+    node_id_table out_nodes;
+    binary_serializer bs(&wr_buf, &addressing, nullptr,
+                         wire_format::v2, &out_nodes);
+    bs << msg;
+    BOOST_ACTOR_CHECK(wr_buf.size() < v1_buf.size());
+    // the first node ID is written in full, repetitions as index
+    auto before = wr_buf.size();
+    bs << node;
+    auto first_size = wr_buf.size() - before;
+    before = wr_buf.size();
+    bs << node;
+    BOOST_ACTOR_CHECK_EQUAL(wr_buf.size() - before, 1);
+    BOOST_ACTOR_CHECK(first_size > 20);
+    BOOST_ACTOR_CHECK_EQUAL(out_nodes.size(), 1);
+    node_id_table in_nodes;
+    binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing,
+                           nullptr, wire_format::v2, &in_nodes);
+    message msg2;
+    uniform_typeid<message>()->deserialize(&msg2, &bd);
+    BOOST_ACTOR_CHECK(msg == msg2);
+    node_id_ptr node1;
+    node_id_ptr node2;
+    uniform_typeid<node_id_ptr>()->deserialize(&node1, &bd);
+    uniform_typeid<node_id_ptr>()->deserialize(&node2, &bd);
+    BOOST_ACTOR_CHECK(node1 && *node1 == *node);
+    BOOST_ACTOR_CHECK(node1 == node2);
+    BOOST_ACTOR_CHECK_EQUAL(in_nodes.size(), 1);
+}
+
+// node ID tables stop growing at max_size on both sides
+void test_node_id_table_limit(actor_namespace& addressing) {
+    auto num_nodes = node_id_table::max_size + 10;
+    auto host = get_middleman()->node()->host_id();
+    vector<node_id_ptr> nodes;
+    for (size_t i = 0; i < num_nodes; ++i) {
+        nodes.emplace_back(new node_id(static_cast<uint32_t>(i + 1), host));
+    }
+    io::buffer wr_buf;
+    node_id_table out_nodes;
+    binary_serializer bs(&wr_buf, &addressing, nullptr,
+                         wire_format::v2, &out_nodes);
+    // write each node twice, nodes beyond the limit are always written
+    // in full, i.e., need more space than nodes stored in the table
+    for (int round = 0; round < 2; ++round) {
+        for (auto& node : nodes) bs << node;
+    }
+    BOOST_ACTOR_CHECK_EQUAL(out_nodes.size(), node_id_table::max_size);
+    BOOST_ACTOR_CHECK_EQUAL(out_nodes.id_of(*nodes.front()), 1);
+    BOOST_ACTOR_CHECK_EQUAL(out_nodes.id_of(*nodes.back()), 0);
+    node_id_table in_nodes;
+    binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing,
+                           nullptr, wire_format::v2, &in_nodes);
+    size_t mismatches = 0;
+    for (int round = 0; round < 2; ++round) {
+        for (auto& node : nodes) {
+            node_id_ptr tmp;
+            uniform_typeid<node_id_ptr>()->deserialize(&tmp, &bd);
+            if (!tmp || *tmp != *node) ++mismatches;
+        }
+    }
+    BOOST_ACTOR_CHECK_EQUAL(mismatches, 0);
+    BOOST_ACTOR_CHECK_EQUAL(in_nodes.size(), node_id_table::max_size);
+}
+
 } // namespace <anonymous>
 
 int main() {
     BOOST_ACTOR_TEST(test_serialization);
 
     announce<test_enum>();
+    announce<vector<uint32_t>>();
 
     test_ieee_754();
 
@@ -134,6 +209,9 @@ int main() {
 
     cout << "process id: " << to_string(get_middleman()->node()) << endl;
 
+    test_wire_format_v2(addressing);
+    test_node_id_table_limit(addressing);
+
   /*
     auto oarr = new detail::object_array;
     oarr->push_back(object::from(static_cast<uint32_t>(42)));
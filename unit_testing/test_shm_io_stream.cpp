@@ -0,0 +1,149 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "test.hpp"
+
+#include "boost/actor/exception.hpp"
+
+#include "boost/actor/io/tcp_acceptor.hpp"
+#include "boost/actor/io/shm_io_stream.hpp"
+#include "boost/actor/io/tcp_io_stream.hpp"
+
+using namespace boost::actor;
+
+namespace {
+
+// checks whether the doorbell of io has been rung
+bool rung(const io::shm_io_stream_ptr& io, int timeout_ms = 1000) {
+    pollfd pfd;
+    pfd.fd = io->read_handle();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+// checks whether opening name fails and leaves the object in place
+bool rejected(io::stream_ptr doorbell, const std::string& name,
+              std::uint32_t creator) {
+    try {
+        io::shm_io_stream::open(doorbell, name, creator);
+        return false;
+    }
+    catch (network_error&) { }
+    auto fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) return false;
+    close(fd);
+    return true;
+}
+
+std::vector<char> make_data(size_t size, char first) {
+    std::vector<char> result(size);
+    for (size_t i = 0; i < size; ++i) result[i] = static_cast<char>(first + i);
+    return result;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_shm_io_stream);
+    BOOST_ACTOR_CHECK_EQUAL(io::shm_ring_size(), 1024 * 1024);
+    // a loopback connection serves as doorbell for both sides
+    auto acceptor = io::tcp_acceptor::create(0, "127.0.0.1");
+    auto port = static_cast<io::tcp_acceptor*>(acceptor.get())->port();
+    io::stream_ptr client_io = io::tcp_io_stream::connect_to("127.0.0.1", port);
+    auto accepted = acceptor->accept_connection();
+    io::stream_ptr server_io = dynamic_cast<io::stream*>(accepted.first.get());
+    BOOST_ACTOR_CHECK(server_io != nullptr);
+    // rings have a size of at least 4KB
+    auto a = io::shm_io_stream::create(client_io, 100);
+    auto pid = static_cast<std::uint32_t>(getpid());
+    auto b = io::shm_io_stream::open(server_io, a->name(), pid);
+    BOOST_ACTOR_CHECK(a->read_handle() == client_io->read_handle());
+    // the second process removes the name of the segment
+    try {
+        io::shm_io_stream::open(server_io, a->name(), pid);
+        BOOST_ACTOR_FAILURE("segment opened twice");
+    }
+    catch (network_error&) { }
+    // names received from a remote node must not denote arbitrary objects
+    std::string foreign_name = "/boost_actor_test_" + std::to_string(pid);
+    std::string empty_name = "/boost_actor_" + std::to_string(pid) + "_0";
+    for (auto& name : {foreign_name, empty_name}) {
+        auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        BOOST_ACTOR_CHECK(fd >= 0);
+        if (fd >= 0) close(fd);
+    }
+    BOOST_ACTOR_CHECK(!io::shm_io_stream::is_valid_name(foreign_name, pid));
+    BOOST_ACTOR_CHECK(io::shm_io_stream::is_valid_name(empty_name, pid));
+    BOOST_ACTOR_CHECK(!io::shm_io_stream::is_valid_name(empty_name, pid + 1));
+    BOOST_ACTOR_CHECK(rejected(server_io, foreign_name, pid));
+    BOOST_ACTOR_CHECK(rejected(server_io, empty_name, pid + 1));
+    // the name is removed only after validating the segment
+    BOOST_ACTOR_CHECK(rejected(server_io, empty_name, pid));
+    shm_unlink(foreign_name.c_str());
+    shm_unlink(empty_name.c_str());
+    std::vector<char> buf(8192);
+    // data written by one side is read by the other side only
+    auto x = make_data(3000, 'x');
+    BOOST_ACTOR_CHECK_EQUAL(a->write_some(x.data(), x.size()), x.size());
+    BOOST_ACTOR_CHECK_EQUAL(a->read_some(buf.data(), buf.size()), 0);
+    BOOST_ACTOR_CHECK_EQUAL(b->read_some(buf.data(), buf.size()), x.size());
+    BOOST_ACTOR_CHECK(std::equal(x.begin(), x.end(), buf.begin()));
+    // b is waiting for data now, i.e., a rings the doorbell
+    auto y = make_data(6000, 'y');
+    BOOST_ACTOR_CHECK_EQUAL(a->write_some(y.data(), y.size()), 4096);
+    BOOST_ACTOR_CHECK(rung(b));
+    // reading wraps around at the end of the ring
+    BOOST_ACTOR_CHECK_EQUAL(b->read_some(buf.data(), buf.size()), 4096);
+    BOOST_ACTOR_CHECK(std::equal(y.begin(), y.begin() + 4096, buf.begin()));
+    // a is waiting for free space, but b must not ring the doorbell
+    // until its owner allowed it to do so
+    BOOST_ACTOR_CHECK(!rung(a, 100));
+    b->arm();
+    BOOST_ACTOR_CHECK(rung(a));
+    // gather writes
+    auto z = make_data(100, 'z');
+    io::const_buffer bufs[] = {{y.data() + 4096, 1904}, {z.data(), z.size()}};
+    BOOST_ACTOR_CHECK_EQUAL(a->write_some(bufs, 2), 2004);
+    b->read(buf.data(), 2004);
+    BOOST_ACTOR_CHECK(std::equal(y.begin() + 4096, y.end(), buf.begin()));
+    BOOST_ACTOR_CHECK(std::equal(z.begin(), z.end(), buf.begin() + 1904));
+    // and the other direction
+    b->write(x.data(), x.size());
+    a->read(buf.data(), x.size());
+    BOOST_ACTOR_CHECK(std::equal(x.begin(), x.end(), buf.begin()));
+    // data written before closing the connection is not lost
+    a->write(z.data(), z.size());
+    a.reset();
+    client_io.reset();
+    BOOST_ACTOR_CHECK_EQUAL(b->read_some(buf.data(), buf.size()), z.size());
+    try {
+        b->read_some(buf.data(), buf.size());
+        BOOST_ACTOR_FAILURE("read from closed stream");
+    }
+    catch (std::ios_base::failure&) { }
+    return BOOST_ACTOR_TEST_RESULT();
+}
@@ -1,5 +1,6 @@
 #include <stack>
 #include <chrono>
+#include <future>
 #include <iostream>
 #include <functional>
 
@@ -486,6 +487,117 @@ void test_simple_reply_response() {
     self->await_all_other_actors_done();
 }
 
+// spawns an actor with a mailbox for three messages that reads its mailbox
+// only after ready has been set; the actor forwards all received integers
+actor spawn_bounded_receiver(scoped_actor& self, mailbox_overflow policy,
+                             std::promise<void>& ready) {
+    auto ready_future = ready.get_future().share();
+    actor client = self;
+    return self->spawn<detached + blocking_api>(
+        bounded_mailbox(3, policy),
+        [=](blocking_actor* s) {
+            ready_future.wait();
+            bool done = false;
+            s->do_receive (
+                on_arg_match >> [&](int value) {
+                    s->send(client, value);
+                },
+                after(chrono::seconds(0)) >> [&] {
+                    done = true;
+                }
+            )
+            .until([&] { return done; });
+            s->send(client, atom("done"));
+        }
+    );
+}
+
+// sends the integers 1 to 5 to a receiver with a mailbox for three
+// messages and returns the integers it has received; stores whether
+// try_send did not signal backpressure in accepted
+vector<int> fill_bounded_mailbox(scoped_actor& self, mailbox_overflow policy,
+                                 vector<bool>& accepted) {
+    std::promise<void> ready;
+    auto receiver = spawn_bounded_receiver(self, policy, ready);
+    for (int i = 1; i <= 5; ++i) accepted.push_back(self->try_send(receiver, i));
+    ready.set_value();
+    vector<int> result;
+    bool done = false;
+    self->do_receive (
+        on_arg_match >> [&](int value) {
+            result.push_back(value);
+        },
+        on(atom("done")) >> [&] {
+            done = true;
+        },
+        after(chrono::seconds(5)) >> [&] {
+            BOOST_ACTOR_FAILURE("timeout while waiting for receiver");
+            done = true;
+        }
+    )
+    .until([&] { return done; });
+    self->await_all_other_actors_done();
+    return result;
+}
+
+// sends a request to a full bounded mailbox and checks whether
+// the request is answered with a sync_exited_msg
+void test_dropped_request(scoped_actor& self, mailbox_overflow policy) {
+    std::promise<void> ready;
+    auto receiver = spawn_bounded_receiver(self, policy, ready);
+    for (int i = 1; i <= 3; ++i) self->send(receiver, i);
+    bool rejected = false;
+    self->on_sync_failure([&] {
+        auto& msg = self->last_dequeued();
+        rejected =    msg.has_types<sync_exited_msg>()
+                   && msg.get_as<sync_exited_msg>(0).reason
+                      == exit_reason::mailbox_overflow;
+    });
+    self->sync_send(receiver, 4).await(
+        on_arg_match >> [](int) {
+            BOOST_ACTOR_FAILURE("rejected request was delivered");
+        }
+    );
+    BOOST_ACTOR_CHECK(rejected);
+    self->on_sync_failure(BOOST_ACTOR_UNEXPECTED_MSG_CB_REF(self));
+    ready.set_value();
+    // consume forwarded messages
+    for (int i = 1; i <= 3; ++i) {
+        self->receive(on(i) >> [] { });
+    }
+    self->receive(on(atom("done")) >> [] { });
+    self->await_all_other_actors_done();
+    BOOST_ACTOR_CHECKPOINT();
+}
+
+void test_bounded_mailboxes(scoped_actor& self) {
+    // only mailbox_overflow::backpressure signalizes senders
+    vector<bool> no_signals(5, true);
+    vector<bool> signals{true, true, true, false, false};
+    vector<bool> accepted;
+    BOOST_ACTOR_PRINT("test mailbox_overflow::drop_newest");
+    auto received = fill_bounded_mailbox(self, mailbox_overflow::drop_newest,
+                                         accepted);
+    BOOST_ACTOR_CHECK((received == vector<int>{1, 2, 3}));
+    BOOST_ACTOR_CHECK(accepted == no_signals);
+    BOOST_ACTOR_PRINT("test mailbox_overflow::drop_oldest");
+    accepted.clear();
+    received = fill_bounded_mailbox(self, mailbox_overflow::drop_oldest,
+                                    accepted);
+    BOOST_ACTOR_CHECK((received == vector<int>{3, 4, 5}));
+    BOOST_ACTOR_CHECK(accepted == no_signals);
+    BOOST_ACTOR_PRINT("test mailbox_overflow::backpressure");
+    accepted.clear();
+    received = fill_bounded_mailbox(self, mailbox_overflow::backpressure,
+                                    accepted);
+    BOOST_ACTOR_CHECK((received == vector<int>{1, 2, 3, 4, 5}));
+    BOOST_ACTOR_CHECK(accepted == signals);
+    BOOST_ACTOR_PRINT("test mailbox_overflow::reject");
+    test_dropped_request(self, mailbox_overflow::reject);
+    BOOST_ACTOR_PRINT("test requests with mailbox_overflow::drop_newest");
+    test_dropped_request(self, mailbox_overflow::drop_newest);
+}
+
 void test_spawn() {
     test_simple_reply_response();
     BOOST_ACTOR_CHECKPOINT();
@@ -921,6 +1033,7 @@ void test_spawn() {
         }
     );
     BOOST_ACTOR_CHECKPOINT();
+    test_bounded_mailboxes(self);
 }
 
 } // namespace <anonymous>
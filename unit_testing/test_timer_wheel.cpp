@@ -0,0 +1,105 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <vector>
+#include <chrono>
+
+#include "test.hpp"
+
+#include "boost/actor/detail/timer_wheel.hpp"
+
+using namespace boost::actor;
+
+using detail::timer_entry;
+using detail::timer_wheel;
+using detail::timer_handle;
+
+using std::chrono::milliseconds;
+
+namespace {
+
+timer_entry::time_point s_origin = timer_entry::clock_type::now();
+
+// creates an entry due at origin + ms, adds the reference of the wheel
+timer_handle make_entry(int ms, timer_wheel& wheel) {
+    timer_handle result{new timer_entry(s_origin + milliseconds(ms),
+                                        message_header{},
+                                        make_message(ms))};
+    result->ref();
+    wheel.insert(result.get());
+    return result;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_timer_wheel);
+    std::vector<int> fired;
+    auto f = [&](timer_entry& e) {
+        fired.push_back(e.msg.get_as<int>(0));
+    };
+    auto at = [](int ms) { return s_origin + milliseconds(ms); };
+    timer_handle pending;
+    { // lifetime scope of wheel
+        timer_wheel wheel{s_origin};
+        BOOST_ACTOR_CHECK(wheel.empty());
+        std::vector<timer_handle> handles;
+        for (int ms : {300, 5, 70000, 5, 1, 256, 20000000}) {
+            handles.push_back(make_entry(ms, wheel));
+        }
+        BOOST_ACTOR_CHECK_EQUAL(wheel.size(), 7);
+        BOOST_ACTOR_CHECK(wheel.next_timeout() == at(1));
+        // nothing is delivered too early
+        wheel.advance(at(0), f);
+        BOOST_ACTOR_CHECK(fired.empty());
+        wheel.advance(at(5), f);
+        BOOST_ACTOR_CHECK((fired == std::vector<int>{1, 5, 5}));
+        // delivered entries are disarmed and released by the wheel
+        BOOST_ACTOR_CHECK(!handles[1]->armed());
+        BOOST_ACTOR_CHECK(handles[1]->msg.empty());
+        BOOST_ACTOR_CHECK_EQUAL(handles[1]->get_reference_count(), 1);
+        // the next timeout is either due or at the end of the first level
+        BOOST_ACTOR_CHECK(wheel.next_timeout() == at(256));
+        // cancel the entry due at 300ms
+        BOOST_ACTOR_CHECK(handles[0]->disarm());
+        BOOST_ACTOR_CHECK(wheel.erase(handles[0].get()));
+        BOOST_ACTOR_CHECK(!wheel.erase(handles[0].get()));
+        BOOST_ACTOR_CHECK_EQUAL(handles[0]->get_reference_count(), 1);
+        // disarmed entries are dropped silently
+        handles[2]->disarm();
+        fired.clear();
+        wheel.advance(at(100000), f);
+        BOOST_ACTOR_CHECK((fired == std::vector<int>{256}));
+        BOOST_ACTOR_CHECK_EQUAL(wheel.size(), 1);
+        fired.clear();
+        wheel.advance(at(20000000), f);
+        BOOST_ACTOR_CHECK((fired == std::vector<int>{20000000}));
+        BOOST_ACTOR_CHECK(wheel.empty());
+        // an empty wheel skips ahead and still delivers in order
+        make_entry(20000010, wheel);
+        make_entry(20000002, wheel);
+        fired.clear();
+        wheel.advance(at(20000009), f);
+        BOOST_ACTOR_CHECK((fired == std::vector<int>{20000002}));
+        pending = make_entry(30000000, wheel);
+    }
+    // remaining entries are disarmed and released on destruction
+    BOOST_ACTOR_CHECK(!pending->armed());
+    BOOST_ACTOR_CHECK_EQUAL(pending->get_reference_count(), 1);
+    return BOOST_ACTOR_TEST_RESULT();
+}
@@ -0,0 +1,156 @@
+/******************************************************************************\
+ *                                                                            *
+ *           ____                  _        _        _                        *
+ *          | __ )  ___   ___  ___| |_     / \   ___| |_ ___  _ __            *
+ *          |  _ \ / _ \ / _ \/ __| __|   / _ \ / __| __/ _ \| '__|           *
+ *          | |_) | (_) | (_) \__ \ |_ _ / ___ \ (__| || (_) | |              *
+ *          |____/ \___/ \___/|___/\__(_)_/   \_\___|\__\___/|_|              *
+ *                                                                            *
+ *                                                                            *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstring>
+
+#include "test.hpp"
+#include "boost/actor/all.hpp"
+#include "boost/actor/binary_serializer.hpp"
+#include "boost/actor/binary_deserializer.hpp"
+
+using namespace std;
+using namespace boost::actor;
+
+namespace {
+
+constexpr int num_datagrams = 200;
+
+// echoes each datagram back to its sender
+void echo_server(io::broker* self) {
+    BOOST_ACTOR_CHECKPOINT();
+    self->become (
+        [=](const new_datagram_msg& msg) {
+            self->write_datagram(msg.handle, msg.remote, msg.buf);
+        },
+        on(atom("done")) >> [=] {
+            self->quit();
+        },
+        others() >> BOOST_ACTOR_UNEXPECTED_MSG_CB(self)
+    );
+}
+
+void client(io::broker* self, uint16_t port, const actor& server) {
+    BOOST_ACTOR_CHECKPOINT();
+    auto hdl = self->add_udp_endpoint(0, "127.0.0.1");
+    io::ip_endpoint remote{"127.0.0.1", port};
+    // exceeds the maximum datagram size of the server, i.e., is dropped
+    char large[128];
+    memset(large, 0, sizeof(large));
+    self->write_datagram(hdl, remote, sizeof(large), large);
+    // all datagrams of this loop are sent as batch once the
+    // middleman finished running this broker
+    for (int i = 0; i < num_datagrams; ++i) {
+        self->write_datagram(hdl, remote, sizeof(int), &i);
+    }
+    auto received = make_shared<int>(0);
+    self->become (
+        [=](const new_datagram_msg& msg) {
+            BOOST_ACTOR_CHECK(msg.handle == hdl);
+            BOOST_ACTOR_CHECK(msg.remote == remote);
+            BOOST_ACTOR_CHECK_EQUAL(msg.buf.size(), sizeof(int));
+            int value;
+            memcpy(&value, msg.buf.data(), sizeof(int));
+            // loopback preserves the order of datagrams
+            BOOST_ACTOR_CHECK_EQUAL(value, *received);
+            if (++*received == num_datagrams) {
+                self->send(server, atom("done"));
+                self->quit();
+            }
+        },
+        others() >> BOOST_ACTOR_UNEXPECTED_MSG_CB(self)
+    );
+}
+
+void test_ip_endpoint() {
+    io::ip_endpoint v4{"127.0.0.1", 4242};
+    BOOST_ACTOR_CHECK(v4.is_v4());
+    BOOST_ACTOR_CHECK_EQUAL(v4.host(), "127.0.0.1");
+    BOOST_ACTOR_CHECK_EQUAL(v4.port(), 4242);
+    io::ip_endpoint v6{"::1", 4242};
+    BOOST_ACTOR_CHECK(!v6.is_v4());
+    BOOST_ACTOR_CHECK_EQUAL(v6.host(), "::1");
+    BOOST_ACTOR_CHECK(v4 != v6);
+    BOOST_ACTOR_CHECK(v4 == io::ip_endpoint("127.0.0.1", 4242));
+    BOOST_ACTOR_CHECK(v4 != io::ip_endpoint("127.0.0.1", 4243));
+    bool thrown = false;
+    try { io::ip_endpoint invalid{"localhost", 4242}; }
+    catch (network_error&) { thrown = true; }
+    BOOST_ACTOR_CHECK(thrown);
+    // the sender of a datagram survives serialization
+    new_datagram_msg ndm;
+    ndm.remote = v6;
+    ndm.buf.write(3, "abc");
+    BOOST_ACTOR_CHECK(to_string(make_message(ndm)).find("::1") != string::npos);
+    io::buffer wr_buf;
+    binary_serializer bs(&wr_buf);
+    bs << ndm;
+    binary_deserializer bd(wr_buf.data(), wr_buf.size());
+    new_datagram_msg ndm2;
+    uniform_typeid<new_datagram_msg>()->deserialize(&ndm2, &bd);
+    BOOST_ACTOR_CHECK(ndm == ndm2);
+}
+
+// a single receive() call picks up a full batch of datagrams
+// regardless of the (default) maximum datagram size
+void test_receive_batch() {
+    auto receiver = io::udp_socket::create(0, "127.0.0.1");
+    auto sender = io::udp_socket::create(0, "127.0.0.1");
+    io::ip_endpoint remote{"127.0.0.1", receiver->port()};
+    constexpr size_t num = 10;
+    vector<io::udp_socket::datagram> dgrams(num);
+    for (size_t i = 0; i < num; ++i) {
+        dgrams[i].remote = remote;
+        dgrams[i].buf.write(sizeof(size_t), &i);
+    }
+    BOOST_ACTOR_CHECK_EQUAL(sender->send(dgrams.data(), num), num);
+    // loopback delivers the datagrams immediately
+    size_t received = 0;
+    for (int i = 0; i < 100 && received == 0; ++i) {
+        received = receiver->receive();
+        if (received == 0) this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    BOOST_ACTOR_CHECK_EQUAL(received, num);
+    for (size_t i = 0; i < received; ++i) {
+        size_t value;
+        memcpy(&value, receiver->data(i), sizeof(size_t));
+        BOOST_ACTOR_CHECK_EQUAL(value, i);
+    }
+}
+
+} // namespace <anonymous>
+
+int main() {
+    BOOST_ACTOR_TEST(test_udp_broker);
+    test_ip_endpoint();
+    test_receive_batch();
+    auto sock = io::udp_socket::create(0, "127.0.0.1");
+    auto port = sock->port();
+    BOOST_ACTOR_CHECK(port != 0);
+    auto ptr = io::broker::from(echo_server);
+    auto hdl = ptr->add_udp_endpoint(std::move(sock));
+    ptr->max_datagram_size(hdl, 64);
+    actor server{io::init_and_launch(std::move(ptr))};
+    spawn_io(client, port, server);
+    await_all_actors_done();
+    shutdown();
+    return BOOST_ACTOR_TEST_RESULT();
+}
@@ -85,6 +85,7 @@ int main() {
         // default announced cppa types
         "@ac_hdl",                   // io::accept_handle
         "@cn_hdl",                   // io::connection_handle
+        "@dg_hdl",                   // io::datagram_handle
         "@atom",                     // atom_value
         "@addr",                     // actor address
         "@message",                  // message
@@ -105,6 +106,8 @@ int main() {
         "@conn_closed",              // connection_closed_msg
         "@new_conn",                 // new_connection_msg
         "@new_data",                 // new_data_msg
+        "@new_dgram",                // new_datagram_msg
+        "@dgram_closed",             // datagram_closed_msg
     };
     // holds the type names we see at runtime
     std::set<std::string> found;